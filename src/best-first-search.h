@@ -0,0 +1,362 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "constraints.h"
+#include "graph.h"
+#include "search-context.h"
+
+/// @brief Best-first search loop shared by all planners in `path-finding.cpp`. It is a template on its policies, so
+/// that the successor generation and the heuristic are inlined into the expansion loop:
+///
+/// - `Space` defines the searched states (`Space::State`, e.g. a vertex or a vertex at a time), which of them are
+///   goals, and generates the successors of a state, keeping their distances and predecessors.
+/// - `Heuristic` estimates the remaining distance of a batch of vertices (see `distance_heuristic`).
+/// - `OpenList` holds the generated states by priority, and may use their distances to break ties (see
+///   `BinaryHeapOpenList` and `open-lists.h`).
+/// - `Visitor` is notified about every examined and generated state (see `NullSearchVisitor`).
+///
+/// The priority of a generated state is its distance plus the heuristic estimate of its vertex plus the penalty the
+/// space gave it. Returns the first goal state taken from the open list, or nothing if the open list ran empty.
+template <typename Space, typename Heuristic, typename OpenList, typename Visitor>
+std::optional<typename Space::State> best_first_search(
+    Space& space, const typename Space::State& start, const Heuristic& heuristic, OpenList& openList, Visitor& visitor)
+{
+  typedef typename Space::State State;
+  struct Successor {
+    State state;
+    Distance distance;
+    Distance penalty;
+  };
+
+  // Successors of the expanded state, scored by the heuristic in one batch
+  std::vector<Successor> successors;
+  std::vector<Vertex> vertices;
+  std::vector<Distance> estimates;
+
+  openList.push(0.0f, 0.0f, start);
+  while (!openList.empty())
+  {
+    const State state = openList.pop();
+    visitor.examineState(state);
+    if (space.isGoal(state)) return state;
+    if (!space.beginExpansion(state)) continue;
+
+    successors.clear();
+    vertices.clear();
+    space.forEachSuccessor(
+        state,
+        [&](const State& next, Distance distance, Distance penalty)
+        {
+          successors.push_back({next, distance, penalty});
+          vertices.push_back(Space::getVertex(next));
+        });
+
+    estimates.resize(successors.size());
+    heuristic(vertices.data(), vertices.size(), estimates.data());
+    for (size_t index = 0; index < successors.size(); ++index)
+    {
+      visitor.generateState(successors[index].state);
+      const Successor& successor = successors[index];
+      openList.push(successor.distance + estimates[index] + successor.penalty, successor.distance, successor.state);
+    }
+  }
+  return std::nullopt;
+}
+
+/// @brief Open list on a binary heap. States of equal priority are taken in ascending order.
+template <typename State>
+class BinaryHeapOpenList
+{
+ public:
+  bool empty() const
+  {
+    return queue.empty();
+  }
+
+  void push(Distance priority, Distance /*distance*/, const State& state)
+  {
+    queue.push(std::make_pair(priority, state));
+  }
+
+  State pop()
+  {
+    const State state = queue.top().second;
+    queue.pop();
+    return state;
+  }
+
+ private:
+  typedef std::pair<Distance, State> Pair;
+  std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> queue;
+};
+
+struct NullSearchVisitor {
+  template <typename State>
+  void examineState(const State&)
+  {
+  }
+
+  template <typename State>
+  void generateState(const State&)
+  {
+  }
+};
+
+/// @brief Heuristic of uninformed (Dijkstra) searches.
+struct ZeroHeuristic {
+  void operator()(const Vertex*, size_t count, Distance* distances) const
+  {
+    std::fill(distances, distances + count, 0.0f);
+  }
+};
+
+/// @brief Search space whose states are the vertices of a graph, keeping distances and predecessors in a
+/// `SearchContext`. A vertex is expanded again only after a shorter path to it was found.
+template <typename Graph>
+class VertexSearchSpace
+{
+ public:
+  typedef Vertex State;
+
+  /// @param goal Vertex ending the search, or nothing to search all vertices reachable from `start`.
+  /// @param context Arrays of the search, reset lazily. Must not be used by another search while this one runs.
+  VertexSearchSpace(
+      const Graph& graph,
+      Vertex start,
+      std::optional<Vertex> goal = std::nullopt,
+      SearchContext& context = SearchContext::getThreadContext())
+      : graph(graph), goal(goal), context(context)
+  {
+    context.startSearch(num_vertices(graph));
+    context.reach(start, 0.0f, start);
+  }
+
+  static Vertex getVertex(Vertex state)
+  {
+    return state;
+  }
+
+  bool isGoal(Vertex state) const
+  {
+    return goal && state == *goal;
+  }
+
+  bool beginExpansion(Vertex state)
+  {
+    if (context.isExpanded(state)) return false;
+    context.setExpanded(state);
+    return true;
+  }
+
+  template <typename Generate>
+  void forEachSuccessor(Vertex state, Generate&& generate)
+  {
+    const Distance distance = context.getDistance(state);
+    for_each_out_edge(
+        graph,
+        state,
+        [&](Vertex next, Distance weight)
+        {
+          if (distance + weight < context.getDistance(next))
+          {
+            context.reach(next, distance + weight, state);
+            generate(next, distance + weight, 0.0f);
+          }
+        });
+  }
+
+  const SearchContext& getContext() const
+  {
+    return context;
+  }
+
+ private:
+  const Graph& graph;
+  std::optional<Vertex> goal;
+  SearchContext& context;
+};
+
+/// @brief Search space of the vertices of a graph that ends once every one of a set of targets was taken from the open
+/// list, so that a single search settles the distances of all of them.
+template <typename Graph>
+class TargetSetSearchSpace : public VertexSearchSpace<Graph>
+{
+ public:
+  /// @param targets Vertices ending the search, in any order and possibly repeated.
+  TargetSetSearchSpace(
+      const Graph& graph,
+      Vertex start,
+      std::vector<Vertex> targets,
+      SearchContext& context = SearchContext::getThreadContext())
+      : VertexSearchSpace<Graph>(graph, start, std::nullopt, context), targets(std::move(targets))
+  {
+    std::sort(this->targets.begin(), this->targets.end());
+    this->targets.erase(std::unique(this->targets.begin(), this->targets.end()), this->targets.end());
+    numberOfRemainingTargets = this->targets.size();
+  }
+
+  /// @brief Settles `state`, which ends the search if it is the last target left.
+  bool isGoal(Vertex state)
+  {
+    if (numberOfRemainingTargets == 0) return true;
+    // A vertex taken again from the open list was settled the first time
+    if (this->getContext().isExpanded(state) || !std::binary_search(targets.begin(), targets.end(), state))
+    {
+      return false;
+    }
+    return --numberOfRemainingTargets == 0;
+  }
+
+  size_t getNumberOfRemainingTargets() const
+  {
+    return numberOfRemainingTargets;
+  }
+
+ private:
+  /// Sorted and without duplicates
+  std::vector<Vertex> targets;
+  size_t numberOfRemainingTargets;
+};
+
+struct PositionAtTime {
+  Vertex vertex;
+  unsigned time;
+
+  PositionAtTime(Vertex vertex, unsigned time) : vertex(vertex), time(time)
+  {
+  }
+
+  // Compare two states
+  bool operator<(const PositionAtTime& other) const
+  {
+    if (vertex != other.vertex) return vertex < other.vertex;
+    return time < other.time;
+  }
+};
+
+/// @brief Search space of Space-Time A* (see [./doc/coop-path-AIWisdom.pdf](Cooperative Pathinding)): a state is a
+/// vertex at a time step. Every step moves along an edge or waits, entering only vertices and edges free for the
+/// runner at that time. Waiting a time step costs as much as moving along an edge of unit weight, so that distances
+/// stay consistent with the heuristics, which estimate the moves left, and equally long routes arrive earliest first.
+/// A state is expanded once, and generated again only along a shorter route.
+template <typename Graph>
+class SpaceTimeSearchSpace
+{
+ public:
+  typedef PositionAtTime State;
+  static constexpr Distance WaitCost = 1.0f;
+
+  SpaceTimeSearchSpace(
+      const Graph& graph, Vertex start, Vertex goal, const Constraints& constraints, RunnerId runnerId)
+      : graph(graph), start(start), goal(goal), constraints(constraints), runnerId(runnerId)
+  {
+    const PositionAtTime startState(start, 0u);
+    predecessors[startState] = start;
+    distances[startState] = 0;
+    arrivalTimes[startState] = 0;
+  }
+
+  static Vertex getVertex(const PositionAtTime& state)
+  {
+    return state.vertex;
+  }
+
+  bool isGoal(const PositionAtTime& state) const
+  {
+    return state.vertex == goal;
+  }
+
+  bool beginExpansion(const PositionAtTime& state)
+  {
+    if (!expanded.insert(state).second) return false;
+    // Waiting longer than this doesn't open up any path, so the search gives up and the path is empty
+    return state.time <= 10 * num_vertices(graph);
+  }
+
+  template <typename Generate>
+  void forEachSuccessor(const PositionAtTime& state, Generate&& generate)
+  {
+    const Vertex vertex = state.vertex;
+    const unsigned arrivalTime = state.time + 1;
+    for_each_out_edge(
+        graph,
+        vertex,
+        [&](Vertex next, Distance weight)
+        {
+          if (constraints.isVertexFreeForRunner(next, runnerId, arrivalTime, arrivalTime + 1)
+              && constraints.isEdgeFreeForRunner(vertex, next, runnerId, state.time, arrivalTime))
+          {
+            const PositionAtTime nextState(next, arrivalTime);
+            if (!isShorter(nextState, distances[state] + weight)) return;
+            distances[nextState] = distances[state] + weight;
+            predecessors[nextState] = vertex;
+            arrivalTimes[nextState] = arrivalTime;
+            generate(nextState, distances[nextState], 0.0f);
+          }
+        });
+
+    // Allow to pause at the current vertex
+    if (constraints.isVertexFreeForRunner(vertex, runnerId, arrivalTime, arrivalTime + 1))
+    {
+      const PositionAtTime pausedState(vertex, arrivalTime);
+      if (!isShorter(pausedState, distances[state] + WaitCost)) return;
+      distances[pausedState] = distances[state] + WaitCost;
+      predecessors[pausedState] = vertex;
+      arrivalTimes[pausedState] = arrivalTime;
+      generate(pausedState, distances[pausedState], 0.0f);
+    }
+  }
+
+  /// @brief Path to the goal state of the earliest arrival generated, or an empty path if the goal wasn't reached.
+  Path getPath() const
+  {
+    Path path;
+    std::optional<PositionAtTime> goalState;
+    for (const auto& [state, arrivalTime] : arrivalTimes)
+    {
+      if (state.vertex == goal && (!goalState || arrivalTime < goalState->time))
+      {
+        goalState = state;
+      }
+    }
+    // No path to the goal was found given the current constraints (e.g. every remaining route is blocked by another
+    // runner's reservation)
+    if (!goalState) return path;
+
+    for (PositionAtTime state = *goalState; state.vertex != start || state.time > 0;
+         state = PositionAtTime(predecessors.at(state), state.time - 1))
+    {
+      path.push_back(state.vertex);
+    }
+    path.push_back(start);
+    std::reverse(path.begin(), path.end());
+    return path;
+  }
+
+ private:
+  const Graph& graph;
+  Vertex start;
+  Vertex goal;
+  const Constraints& constraints;
+  RunnerId runnerId;
+  std::map<PositionAtTime, Vertex> predecessors;
+  std::map<PositionAtTime, Distance> distances;
+  std::map<PositionAtTime, unsigned> arrivalTimes;
+  std::set<PositionAtTime> expanded;
+
+  // Whether `distance` improves on the distance `state` was generated with so far, if it was generated before
+  bool isShorter(const PositionAtTime& state, Distance distance) const
+  {
+    const auto it = distances.find(state);
+    return it == distances.end() || distance < it->second;
+  }
+};
@@ -0,0 +1,111 @@
+#include "best-first-search.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "csr-graph.h"
+#include "heuristics.h"
+
+struct CountingSearchVisitor {
+  size_t examinedStates = 0;
+  size_t generatedStates = 0;
+
+  template <typename State>
+  void examineState(const State&)
+  {
+    ++examinedStates;
+  }
+
+  template <typename State>
+  void generateState(const State&)
+  {
+    ++generatedStates;
+  }
+};
+
+TEST(best_first_search, finds_shortest_distances_without_goal)
+{
+  const auto graph = DefaultGraphLoader().getGraph();
+  VertexSearchSpace<WeightedDiGraph> space(*graph, 0);
+  BinaryHeapOpenList<Vertex> openList;
+  CountingSearchVisitor visitor;
+
+  EXPECT_FALSE(best_first_search(space, Vertex(0), ZeroHeuristic(), openList, visitor));
+  const std::vector<Distance> distances{0.0f, 2.0f, 2.0f, 1.0f};
+  const std::vector<Vertex> predecessors{0, 0, 3, 0};
+  for (Vertex vertex = 0; vertex < 4; ++vertex)
+  {
+    EXPECT_EQ(space.getContext().getDistance(vertex), distances[vertex]);
+    EXPECT_EQ(space.getContext().getPredecessor(vertex), predecessors[vertex]);
+  }
+  // Vertex 2 is generated twice, as its distance improves from 3 to 2
+  EXPECT_EQ(visitor.generatedStates, 4u);
+  EXPECT_EQ(visitor.examinedStates, 5u);
+}
+
+TEST(best_first_search, target_set_search_ends_when_the_last_target_is_settled)
+{
+  const auto graph = DefaultGraphLoader().getGraph();
+  TargetSetSearchSpace<WeightedDiGraph> space(*graph, 0, {3, 1, 3});
+  BinaryHeapOpenList<Vertex> openList;
+  CountingSearchVisitor visitor;
+
+  // 3 is settled at distance 1 and 1 at distance 2, before 2, which is examined last without a goal
+  EXPECT_EQ(best_first_search(space, Vertex(0), ZeroHeuristic(), openList, visitor), Vertex(1));
+  EXPECT_EQ(space.getNumberOfRemainingTargets(), 0u);
+  EXPECT_EQ(space.getContext().getDistance(3), 1.0f);
+  EXPECT_EQ(space.getContext().getDistance(1), 2.0f);
+  EXPECT_LT(visitor.examinedStates, 5u);
+}
+
+TEST(best_first_search, heuristic_reduces_examined_states)
+{
+  MapGraphLoader loader(
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/maze-128-128-1/maze-128-128-1.map")
+          .make_preferred()
+          .string());
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const Vertex start = 0;
+  const Vertex goal = 400;
+
+  VertexSearchSpace<CompressedSparseRowGraph> dijkstraSpace(graph, start, goal);
+  BinaryHeapOpenList<Vertex> dijkstraOpenList;
+  CountingSearchVisitor dijkstraVisitor;
+  ASSERT_EQ(best_first_search(dijkstraSpace, start, ZeroHeuristic(), dijkstraOpenList, dijkstraVisitor), goal);
+
+  const Distance dijkstraDistance = dijkstraSpace.getContext().getDistance(goal);
+
+  SearchContext context;
+  VertexSearchSpace<CompressedSparseRowGraph> aStarSpace(graph, start, goal, context);
+  BinaryHeapOpenList<Vertex> aStarOpenList;
+  CountingSearchVisitor aStarVisitor;
+  const euclidean_distance_heuristic<CompressedSparseRowGraph> heuristic(graph, goal);
+  ASSERT_EQ(best_first_search(aStarSpace, start, heuristic, aStarOpenList, aStarVisitor), goal);
+
+  EXPECT_EQ(context.getDistance(goal), dijkstraDistance);
+  EXPECT_LE(aStarVisitor.examinedStates, dijkstraVisitor.examinedStates);
+}
+
+TEST(best_first_search, space_time_search_waits_for_a_locked_vertex)
+{
+  // 0 -> 1 -> 2, with vertex 1 locked by another runner at time 1
+  WeightedDiGraph graph(3);
+  for (Vertex vertex = 0; vertex < 3; ++vertex)
+  {
+    graph[vertex].position = {float(vertex), 0.0f};
+  }
+  add_edge(0, 1, 1.0f, graph);
+  add_edge(1, 2, 1.0f, graph);
+  Constraints constraints(graph);
+  constraints.lockVertex(1, 1, 1, 2);
+
+  SpaceTimeSearchSpace<WeightedDiGraph> space(graph, 0, 2, constraints, 0);
+  BinaryHeapOpenList<PositionAtTime> openList;
+  NullSearchVisitor visitor;
+  const auto goalState = best_first_search(space, PositionAtTime(0, 0u), ZeroHeuristic(), openList, visitor);
+
+  ASSERT_TRUE(goalState);
+  EXPECT_EQ(goalState->time, 3u);
+  EXPECT_EQ(space.getPath(), (Path{0, 0, 1, 2}));
+}
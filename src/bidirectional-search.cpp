@@ -0,0 +1,147 @@
+#include "bidirectional-search.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "heuristics.h"
+
+namespace
+{
+constexpr Distance Infinity = std::numeric_limits<Distance>::max();
+}  // namespace
+
+BidirectionalSearch::BidirectionalSearch(const CompressedSparseRowGraph& graph, BidirectionalHeuristic heuristic)
+    : graph(graph), reverseGraph(reverse_graph(graph)), heuristic(heuristic), numberOfExpandedVertices(0)
+{
+}
+
+Path BidirectionalSearch::findShortestPath(Vertex start, Vertex target)
+{
+  typedef std::pair<Distance, Vertex> Entry;
+  typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> Queue;
+
+  const float* x = graph.getX();
+  const float* y = graph.getY();
+  const Point2D startPosition = graph.getPosition(start);
+  const Point2D targetPosition = graph.getPosition(target);
+  // Potential of the forward search, the backward one uses its negation
+  auto potential = [&](Vertex vertex)
+  {
+    if (heuristic == BidirectionalHeuristic::Zero) return 0.0f;
+    Distance toTarget;
+    Distance fromStart;
+    euclidean_distances(x + vertex, y + vertex, 1, targetPosition, &toTarget);
+    euclidean_distances(x + vertex, y + vertex, 1, startPosition, &fromStart);
+    return (toTarget - fromStart) / 2.0f;
+  };
+
+  Queue forwardQueue;
+  Queue backwardQueue;
+  forward.startSearch(graph.getNumberOfVertices());
+  backward.startSearch(graph.getNumberOfVertices());
+  forward.reach(start, 0.0f, start);
+  backward.reach(target, 0.0f, target);
+  forwardQueue.emplace(potential(start), start);
+  backwardQueue.emplace(-potential(target), target);
+  numberOfExpandedVertices = 0;
+
+  Distance bestDistance = start == target ? 0.0f : Infinity;
+  Vertex meeting = start;
+  // Expands the next vertex of one direction, and records the paths through the vertices it reaches that the other
+  // direction reached already
+  auto expand = [&](const CompressedSparseRowGraph& edges,
+                    SearchContext& context,
+                    const SearchContext& other,
+                    Queue& queue,
+                    float potentialSign)
+  {
+    const Vertex vertex = queue.top().second;
+    queue.pop();
+    if (context.isExpanded(vertex)) return;
+    context.setExpanded(vertex);
+    ++numberOfExpandedVertices;
+    const Distance distance = context.getDistance(vertex);
+    for_each_out_edge(
+        edges,
+        vertex,
+        [&](Vertex next, Distance weight)
+        {
+          const Distance nextDistance = distance + weight;
+          if (nextDistance >= context.getDistance(next)) return;
+          context.reach(next, nextDistance, vertex);
+          queue.emplace(nextDistance + potentialSign * potential(next), next);
+          if (other.isReached(next) && nextDistance + other.getDistance(next) < bestDistance)
+          {
+            bestDistance = nextDistance + other.getDistance(next);
+            meeting = next;
+          }
+        });
+  };
+
+  // With the potentials in the keys, no path through an open vertex is shorter than the best one once the smallest
+  // keys add up to its length
+  while (!forwardQueue.empty() && !backwardQueue.empty()
+         && forwardQueue.top().first + backwardQueue.top().first < bestDistance)
+  {
+    if (forwardQueue.top().first <= backwardQueue.top().first)
+    {
+      expand(graph, forward, backward, forwardQueue, 1.0f);
+    }
+    else
+    {
+      expand(reverseGraph, backward, forward, backwardQueue, -1.0f);
+    }
+  }
+
+  if (bestDistance == Infinity)
+  {
+    std::ostringstream message;
+    message << "Unable to find path from " << start << " to " << target << std::endl;
+    throw std::runtime_error(message.str());
+  }
+
+  // Forwards from the start to the meeting vertex, then along the predecessors of the backward search to the target
+  Path path;
+  for (Vertex vertex = meeting; vertex != start; vertex = forward.getPredecessor(vertex))
+  {
+    path.push_back(vertex);
+  }
+  path.push_back(start);
+  std::reverse(path.begin(), path.end());
+  for (Vertex vertex = meeting; vertex != target;)
+  {
+    vertex = backward.getPredecessor(vertex);
+    path.push_back(vertex);
+  }
+  return path;
+}
+
+size_t BidirectionalSearch::getNumberOfVertices() const
+{
+  return graph.getNumberOfVertices();
+}
+
+size_t BidirectionalSearch::getNumberOfExpandedVertices() const
+{
+  return numberOfExpandedVertices;
+}
+
+Path bidirectional_shortest_path(BidirectionalSearch& search, const Vertex& start, const Vertex& target)
+{
+  return search.findShortestPath(start, target);
+}
+
+ShortestPathCalculator bidirectional_calculator(BidirectionalSearch& search)
+{
+  return [&search](const WeightedDiGraph& graph, const Vertex& start, const Vertex& target)
+  {
+    check_calculator_graph(graph, search.getNumberOfVertices(), "Bidirectional search");
+    return search.findShortestPath(start, target);
+  };
+}
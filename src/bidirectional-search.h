@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+
+#include "csr-graph.h"
+#include "graph.h"
+#include "path-finding.h"
+#include "search-context.h"
+
+/// @brief Estimate guiding both directions of a `BidirectionalSearch`.
+enum class BidirectionalHeuristic { Zero, Euclidean };
+
+/// @brief Point-to-point search running forwards from the start and backwards from the target at the same time, over
+/// the reversed edges of the graph, until the two searches can't improve on the best path through a vertex reached
+/// by both. Each search covers about the distance to the middle of the path, which on open maps halves the explored
+/// area compared with `dijkstra_shortest_path`. In corridors, like those of mazes and warehouses, the explored area
+/// only grows with the distance, and both directions together explore about as much as one.
+///
+/// With `BidirectionalHeuristic::Euclidean`, the forward search uses half the Euclidean distance to the target minus
+/// half the one from the start as potential, and the backward search its negation. The potentials are consistent in
+/// both directions, so the search stops as soon as the smallest keys of the two open lists add up to the best path
+/// found, like bidirectional Dijkstra. The Euclidean distance must be consistent with the edge weights, as for
+/// `a_star_shortest_path`.
+class BidirectionalSearch
+{
+ public:
+  /// @param graph Graph searched forwards. Must outlive the search.
+  explicit BidirectionalSearch(
+      const CompressedSparseRowGraph& graph, BidirectionalHeuristic heuristic = BidirectionalHeuristic::Zero);
+
+  /// @brief Shortest path from `start` to `target`, as long as those of `dijkstra_shortest_path`. Queries reuse the
+  /// arrays of the search, so a search must not be queried by several threads at once.
+  /// @throws std::runtime_error if `target` can't be reached from `start`.
+  Path findShortestPath(Vertex start, Vertex target);
+
+  size_t getNumberOfVertices() const;
+
+  /// @brief Number of vertices expanded by both directions of the last query.
+  size_t getNumberOfExpandedVertices() const;
+
+ private:
+  const CompressedSparseRowGraph& graph;
+  CompressedSparseRowGraph reverseGraph;
+  BidirectionalHeuristic heuristic;
+  SearchContext forward;
+  SearchContext backward;
+  size_t numberOfExpandedVertices;
+};
+
+/// @brief Bidirectional point-to-point query, see `BidirectionalSearch::findShortestPath`.
+Path bidirectional_shortest_path(BidirectionalSearch& search, const Vertex& start, const Vertex& target);
+
+/// @brief Binds queries of `search` to a `ShortestPathCalculator`. The search runs on its own compressed graph and its
+/// reverse, so the `WeightedDiGraph` given to the calculator must be the same graph in adjacency list form (e.g. both
+/// from one `MapGraphLoader`); one with another number of vertices throws `std::invalid_argument`. The search must
+/// outlive the calculator.
+ShortestPathCalculator bidirectional_calculator(BidirectionalSearch& search);
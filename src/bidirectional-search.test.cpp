@@ -0,0 +1,114 @@
+#include "bidirectional-search.h"
+
+#include <gtest/gtest.h>
+
+#include "test-data.h"
+
+namespace
+{
+/// Open 4-connected grid of unit edges, numbered row by row.
+CompressedSparseRowGraph createOpenGrid(unsigned width, unsigned height)
+{
+  WeightedDiGraph graph(width * height);
+  for (unsigned row = 0; row < height; ++row)
+  {
+    for (unsigned column = 0; column < width; ++column)
+    {
+      const Vertex vertex = row * width + column;
+      graph[vertex].position = {float(column), float(row)};
+      if (column + 1 < width)
+      {
+        add_edge(vertex, vertex + 1, 1.0f, graph);
+        add_edge(vertex + 1, vertex, 1.0f, graph);
+      }
+      if (row + 1 < height)
+      {
+        add_edge(vertex, vertex + width, 1.0f, graph);
+        add_edge(vertex + width, vertex, 1.0f, graph);
+      }
+    }
+  }
+  return CompressedSparseRowGraph(graph);
+}
+
+size_t count_expanded_vertices(const SearchContext& context, size_t numberOfVertices)
+{
+  size_t count = 0;
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    if (context.isExpanded(vertex)) ++count;
+  }
+  return count;
+}
+}  // namespace
+
+TEST(BidirectionalSearch, finds_shortest_paths_on_directed_graph)
+{
+  DefaultGraphLoader loader;
+  const CompressedSparseRowGraph graph(*loader.getGraph());
+  BidirectionalSearch search(graph);
+
+  EXPECT_EQ(bidirectional_shortest_path(search, 2, 2), (Path{2}));
+  EXPECT_EQ(bidirectional_shortest_path(search, 3, 2), (Path{3, 2}));
+  // Through 3 rather than along the direct edge or through 1
+  EXPECT_EQ(bidirectional_shortest_path(search, 0, 2), (Path{0, 3, 2}));
+  EXPECT_THROW(bidirectional_shortest_path(search, 2, 0), std::runtime_error);
+
+  const ShortestPathCalculator calculator = bidirectional_calculator(search);
+  EXPECT_EQ(calculator(*loader.getGraph(), 0, 2), (Path{0, 3, 2}));
+  const auto otherGraph = MapGraphLoader(getMapFilename("maze-32-32-2")).getGraph();
+  EXPECT_THROW(calculator(*otherGraph, 0, 2), std::invalid_argument);
+}
+
+TEST(BidirectionalSearch, finds_paths_as_long_as_dijkstra)
+{
+  for (const std::string name : {"maze-32-32-2", "warehouse-10-20-10-2-1"})
+  {
+    MapGraphLoader loader(getMapFilename(name));
+    const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+    BidirectionalSearch dijkstra(graph);
+    BidirectionalSearch aStar(graph, BidirectionalHeuristic::Euclidean);
+    const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+    for (Vertex start = 0; start < numberOfVertices; start += numberOfVertices / 5 + 1)
+    {
+      for (Vertex target = 1; target < numberOfVertices; target += numberOfVertices / 7 + 1)
+      {
+        const size_t length = dijkstra_shortest_path(graph, start, target).size();
+        const Path path = dijkstra.findShortestPath(start, target);
+        EXPECT_EQ(path.size(), length) << name << ": " << start << " -> " << target;
+        EXPECT_EQ(path.front(), start);
+        EXPECT_EQ(path.back(), target);
+        EXPECT_EQ(aStar.findShortestPath(start, target).size(), length) << name << ": " << start << " -> " << target;
+      }
+    }
+  }
+}
+
+TEST(BidirectionalSearch, explores_about_half_the_area_of_dijkstra_on_open_map)
+{
+  const unsigned width = 160;
+  const CompressedSparseRowGraph graph = createOpenGrid(width, width);
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  BidirectionalSearch dijkstra(graph);
+  BidirectionalSearch aStar(graph, BidirectionalHeuristic::Euclidean);
+  SearchContext context;
+  size_t unidirectionalExpansions = 0;
+  size_t bidirectionalExpansions = 0;
+  size_t bidirectionalAStarExpansions = 0;
+  // Routes across the middle of the map, so that the area explored around their ends isn't cut off by the borders
+  for (unsigned offset = 0; offset < 20; offset += 4)
+  {
+    const Vertex start = (60 + offset) * width + 60;
+    const Vertex target = (100 - offset) * width + 90;
+    dijkstra_shortest_path(graph, start, target, context);
+    unidirectionalExpansions += count_expanded_vertices(context, numberOfVertices);
+    EXPECT_EQ(dijkstra.findShortestPath(start, target).size(), dijkstra_shortest_path(graph, start, target).size());
+    bidirectionalExpansions += dijkstra.getNumberOfExpandedVertices();
+    EXPECT_EQ(aStar.findShortestPath(start, target).size(), dijkstra_shortest_path(graph, start, target).size());
+    bidirectionalAStarExpansions += aStar.getNumberOfExpandedVertices();
+  }
+  EXPECT_LT(bidirectionalExpansions * 3, unidirectionalExpansions * 2)
+      << bidirectionalExpansions << " vs. " << unidirectionalExpansions;
+  EXPECT_LT(bidirectionalAStarExpansions, bidirectionalExpansions)
+      << bidirectionalAStarExpansions << " vs. " << bidirectionalExpansions;
+}
@@ -0,0 +1,206 @@
+#include "compressed-path-database.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "search-context.h"
+
+namespace
+{
+// Position of every vertex in a depth-first preorder over the out-edges, starting again at the first unvisited
+// vertex for every part of the graph the previous ones don't reach
+std::vector<uint32_t> depth_first_order(const CompressedSparseRowGraph& graph)
+{
+  const auto* offsets = graph.getOffsets();
+  const auto* targets = graph.getTargets();
+  const uint32_t unvisited = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> order(graph.getNumberOfVertices(), unvisited);
+  uint32_t position = 0;
+  std::vector<Vertex> stack;
+  for (Vertex root = 0; root < graph.getNumberOfVertices(); ++root)
+  {
+    if (order[root] != unvisited) continue;
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+      const Vertex vertex = stack.back();
+      stack.pop_back();
+      if (order[vertex] != unvisited) continue;
+      order[vertex] = position++;
+      // Pushed in reverse, so that the first out-edge is followed first
+      for (auto edge = offsets[vertex + 1]; edge > offsets[vertex]; --edge)
+      {
+        if (order[targets[edge - 1]] == unvisited) stack.push_back(targets[edge - 1]);
+      }
+    }
+  }
+  return order;
+}
+
+// Dijkstra from `source`, filling `firstMoves` with the out-edge of `source` each vertex is reached through. With
+// `isUniform`, all edges weigh the same, and the open vertices are taken first in first out instead of from a heap.
+void search_first_moves(
+    const CompressedSparseRowGraph& graph,
+    Vertex source,
+    bool isUniform,
+    SearchContext& context,
+    std::vector<std::pair<Distance, Vertex>>& queue,
+    std::vector<uint8_t>& firstMoves)
+{
+  const auto* offsets = graph.getOffsets();
+  const auto* targets = graph.getTargets();
+  const auto* weights = graph.getWeights();
+  std::fill(firstMoves.begin(), firstMoves.end(), CompressedPathDatabase::NoMove);
+  context.startSearch(graph.getNumberOfVertices());
+  context.reach(source, 0.0f, source);
+  queue.assign(1, {0.0f, source});
+  for (size_t front = 0; front < queue.size();)
+  {
+    std::pair<Distance, Vertex> entry;
+    if (isUniform)
+    {
+      entry = queue[front++];
+    }
+    else
+    {
+      std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+      entry = queue.back();
+      queue.pop_back();
+    }
+    const auto [distance, vertex] = entry;
+    if (context.isExpanded(vertex)) continue;
+    context.setExpanded(vertex);
+    for (auto edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge)
+    {
+      const Vertex next = targets[edge];
+      const Distance nextDistance = distance + weights[edge];
+      if (nextDistance < context.getDistance(next))
+      {
+        context.reach(next, nextDistance, vertex);
+        firstMoves[next] = vertex == source ? static_cast<uint8_t>(edge - offsets[vertex]) : firstMoves[vertex];
+        queue.emplace_back(nextDistance, next);
+        if (!isUniform) std::push_heap(queue.begin(), queue.end(), std::greater<>());
+      }
+    }
+  }
+}
+}  // namespace
+
+CompressedPathDatabase::CompressedPathDatabase(const CompressedSparseRowGraph& graph)
+    : graph(graph), targetOrder(depth_first_order(graph))
+{
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  const auto* offsets = graph.getOffsets();
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    if (offsets[vertex + 1] - offsets[vertex] >= NoMove)
+    {
+      std::ostringstream message;
+      message << "Failed to build compressed path database: vertex " << vertex << " has "
+              << offsets[vertex + 1] - offsets[vertex] << " out-edges";
+      throw std::runtime_error(message.str());
+    }
+  }
+
+  const Distance* weights = graph.getWeights();
+  const bool isUniform = std::all_of(
+      weights, weights + graph.getNumberOfEdges(), [weights](Distance weight) { return weight == *weights; });
+  SearchContext context;
+  std::vector<std::pair<Distance, Vertex>> queue;
+  std::vector<uint8_t> firstMoves(numberOfVertices);
+  std::vector<uint8_t> row(numberOfVertices);
+  runOffsets.reserve(numberOfVertices + 1);
+  runOffsets.push_back(0);
+  for (Vertex source = 0; source < numberOfVertices; ++source)
+  {
+    search_first_moves(graph, source, isUniform, context, queue, firstMoves);
+    for (Vertex target = 0; target < numberOfVertices; ++target)
+    {
+      row[targetOrder[target]] = firstMoves[target];
+    }
+
+    // The source is taken as the move of the run before it, or after it if it comes first
+    const uint32_t sourcePosition = targetOrder[source];
+    if (sourcePosition > 0)
+    {
+      row[sourcePosition] = row[sourcePosition - 1];
+    }
+    else if (numberOfVertices > 1)
+    {
+      row[sourcePosition] = row[1];
+    }
+    for (uint32_t position = 0; position < numberOfVertices; ++position)
+    {
+      if (position == 0 || row[position] != row[position - 1])
+      {
+        runStarts.push_back(position);
+        runMoves.push_back(row[position]);
+      }
+    }
+    runOffsets.push_back(static_cast<uint32_t>(runStarts.size()));
+  }
+}
+
+size_t CompressedPathDatabase::getNumberOfVertices() const
+{
+  return targetOrder.size();
+}
+
+size_t CompressedPathDatabase::getNumberOfRuns() const
+{
+  return runStarts.size();
+}
+
+uint8_t CompressedPathDatabase::getFirstMove(Vertex from, Vertex target) const
+{
+  const auto begin = runStarts.begin() + runOffsets[from];
+  const auto end = runStarts.begin() + runOffsets[from + 1];
+  // Last run starting at or before the target, as the first run of every row starts at 0
+  const auto run = std::upper_bound(begin, end, targetOrder[target]) - 1;
+  return runMoves[static_cast<size_t>(run - runStarts.begin())];
+}
+
+std::optional<Vertex> CompressedPathDatabase::getNextVertex(Vertex from, Vertex target) const
+{
+  if (from == target) return std::nullopt;
+  const uint8_t move = getFirstMove(from, target);
+  if (move == NoMove) return std::nullopt;
+  return graph.getTargets()[graph.getOffsets()[from] + move];
+}
+
+Path CompressedPathDatabase::findShortestPath(Vertex start, Vertex target) const
+{
+  Path path{start};
+  for (Vertex vertex = start; vertex != target;)
+  {
+    const std::optional<Vertex> next = getNextVertex(vertex, target);
+    if (!next)
+    {
+      std::ostringstream message;
+      message << "Unable to find path from " << start << " to " << target << std::endl;
+      throw std::runtime_error(message.str());
+    }
+    vertex = *next;
+    path.push_back(vertex);
+  }
+  return path;
+}
+
+Path compressed_path_database_shortest_path(
+    const CompressedPathDatabase& database, const Vertex& start, const Vertex& target)
+{
+  return database.findShortestPath(start, target);
+}
+
+ShortestPathCalculator compressed_path_database_calculator(const CompressedPathDatabase& database)
+{
+  return [&database](const WeightedDiGraph& graph, const Vertex& start, const Vertex& target)
+  {
+    check_calculator_graph(graph, database.getNumberOfVertices(), "Compressed path database");
+    return database.findShortestPath(start, target);
+  };
+}
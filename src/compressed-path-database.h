@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "csr-graph.h"
+#include "graph.h"
+#include "path-finding.h"
+
+/// @brief Compressed path database: the first move of a shortest path from every vertex to every other, so that the
+/// next hop towards a target is a lookup instead of a search.
+///
+/// A move is the index of an out-edge of the source. The moves of a source towards all targets form a row, which is
+/// run-length encoded over the targets in depth-first order of the graph: targets visited one after the other lie
+/// close together, and are mostly reached by the same first move. The move towards the source itself is free, and
+/// extends the run before it. A lookup is a binary search over the runs of the source.
+///
+/// Building the database takes a Dijkstra search from every vertex, so it is done once per map, before planning. Its
+/// moves ignore `Obstacles`, which would need a rebuild.
+class CompressedPathDatabase
+{
+ public:
+  /// @brief Move towards unreachable targets.
+  static constexpr uint8_t NoMove = 255;
+
+  /// @throws std::runtime_error if a vertex has `NoMove` or more out-edges.
+  explicit CompressedPathDatabase(const CompressedSparseRowGraph& graph);
+
+  size_t getNumberOfVertices() const;
+  /// @brief Number of runs of all rows, which is what the database stores besides the graph.
+  size_t getNumberOfRuns() const;
+
+  /// @brief Index of the out-edge of `from` starting a shortest path to `target`, `NoMove` if `target` can't be
+  /// reached. Unspecified if `from` is `target`.
+  uint8_t getFirstMove(Vertex from, Vertex target) const;
+  /// @brief Next vertex on a shortest path from `from` to `target`, or nothing if `target` can't be reached or is
+  /// `from`.
+  std::optional<Vertex> getNextVertex(Vertex from, Vertex target) const;
+
+  /// @brief Shortest path following the first moves from `start` to `target`.
+  /// @throws std::runtime_error if `target` can't be reached from `start`.
+  Path findShortestPath(Vertex start, Vertex target) const;
+
+ private:
+  CompressedSparseRowGraph graph;
+  /// Position of every vertex in depth-first order, over which the rows are encoded
+  std::vector<uint32_t> targetOrder;
+  /// Runs of every source in `[runOffsets[source], runOffsets[source + 1])`, each starting at a position in
+  /// `targetOrder` and covering the targets up to the start of the next run
+  std::vector<uint32_t> runOffsets;
+  std::vector<uint32_t> runStarts;
+  std::vector<uint8_t> runMoves;
+};
+
+/// @brief Shortest path from a compressed path database. Paths are as long as those of `dijkstra_shortest_path`.
+Path compressed_path_database_shortest_path(
+    const CompressedPathDatabase& database, const Vertex& start, const Vertex& target);
+
+/// @brief Binds path extraction from `database` to a `ShortestPathCalculator`, e.g. to drive the runners of a
+/// `Simulation` through `multi_agent_shortest_path_calculator_wrapper` without any search at plan time. Paths follow
+/// the first moves stored in the database, so the `WeightedDiGraph` given to the calculator must be the graph the
+/// database was built from (e.g. loaded by the same `MapGraphLoader` as its compressed graph); one with another number
+/// of vertices throws `std::invalid_argument`. The database must outlive the calculator.
+ShortestPathCalculator compressed_path_database_calculator(const CompressedPathDatabase& database);
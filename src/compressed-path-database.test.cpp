@@ -0,0 +1,121 @@
+#include "compressed-path-database.h"
+
+#include <gtest/gtest.h>
+
+#include "simulation.h"
+#include "test-data.h"
+
+TEST(CompressedPathDatabase, stores_first_moves_on_directed_graph)
+{
+  DefaultGraphLoader loader;
+  const CompressedSparseRowGraph graph(*loader.getGraph());
+  const CompressedPathDatabase database(graph);
+
+  ASSERT_EQ(database.getNumberOfVertices(), 4u);
+  // Vertex 2 is reached from 0 through 1 or 3 at the same distance, but not through the direct edge
+  EXPECT_NE(database.getNextVertex(0, 2), std::optional<Vertex>(2));
+  EXPECT_EQ(database.getNextVertex(0, 3), std::optional<Vertex>(3));
+  EXPECT_EQ(database.getNextVertex(1, 2), std::optional<Vertex>(2));
+  EXPECT_EQ(database.getNextVertex(2, 0), std::nullopt);
+  EXPECT_EQ(database.getFirstMove(2, 0), CompressedPathDatabase::NoMove);
+  EXPECT_EQ(database.getNextVertex(1, 1), std::nullopt);
+
+  EXPECT_EQ(compressed_path_database_shortest_path(database, 0, 0), (Path{0}));
+  EXPECT_EQ(compressed_path_database_shortest_path(database, 3, 2), (Path{3, 2}));
+  EXPECT_EQ(compressed_path_database_shortest_path(database, 0, 2).size(), 3u);
+  EXPECT_THROW(compressed_path_database_shortest_path(database, 1, 0), std::runtime_error);
+
+  const ShortestPathCalculator calculator = compressed_path_database_calculator(database);
+  EXPECT_EQ(calculator(*loader.getGraph(), 3, 2), (Path{3, 2}));
+  const auto otherGraph = MapGraphLoader(getMapFilename("maze-32-32-2")).getGraph();
+  EXPECT_THROW(calculator(*otherGraph, 3, 2), std::invalid_argument);
+}
+
+TEST(CompressedPathDatabase, first_moves_lead_along_shortest_paths)
+{
+  for (const std::string name : {"maze-32-32-2", "warehouse-10-20-10-2-1"})
+  {
+    MapGraphLoader loader(getMapFilename(name));
+    const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+    const CompressedPathDatabase database(graph);
+    const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+    // Runs of neighboring targets share their first moves, so rows are far shorter than the number of vertices
+    EXPECT_LT(database.getNumberOfRuns() * 10, size_t(numberOfVertices) * numberOfVertices) << name;
+
+    SearchContext context;
+    for (Vertex target = 2; target < numberOfVertices; target += numberOfVertices / 7 + 1)
+    {
+      // Distances to the target are distances from it, as the edges of the map graph go both ways
+      dijkstra_shortest_paths(graph, target, context);
+      for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+      {
+        const std::optional<Vertex> next = database.getNextVertex(vertex, target);
+        if (vertex == target || !context.isReached(vertex))
+        {
+          EXPECT_EQ(next, std::nullopt);
+          continue;
+        }
+        ASSERT_TRUE(next) << name << ": " << vertex << " -> " << target;
+        EXPECT_EQ(context.getDistance(*next) + 1.0f, context.getDistance(vertex)) << name << ": " << vertex;
+      }
+
+      const Path path = compressed_path_database_shortest_path(database, 0, target);
+      EXPECT_EQ(path.size(), dijkstra_shortest_path(graph, 0, target).size());
+    }
+  }
+}
+
+class CompressedPathDatabaseSimulationTest : public RunnerIdsRestoringTest
+{
+};
+
+TEST_F(CompressedPathDatabaseSimulationTest, drives_simulation_without_search)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedPathDatabase database(loader.getCompressedGraph());
+  const auto last = static_cast<Vertex>(database.getNumberOfVertices() - 1);
+  std::vector<JobRequest> jobRequests{JobRequest(0, last), JobRequest(last / 2, 3)};
+  Simulation simulation(
+      jobRequests,
+      loader.getGraph(),
+      1,
+      multi_agent_shortest_path_calculator_wrapper(compressed_path_database_calculator(database)));
+
+  const unsigned timeout = 1000;
+  while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
+  {
+    simulation.advance();
+  }
+  EXPECT_TRUE(simulation.isFinished());
+  EXPECT_EQ(simulation.getFinishedJobRequests().size(), 2u);
+}
+
+TEST_F(CompressedPathDatabaseSimulationTest, drives_simulation_around_obstacles)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedPathDatabase database(loader.getCompressedGraph());
+  const auto last = static_cast<Vertex>(database.getNumberOfVertices() - 1);
+  std::vector<JobRequest> jobRequests{JobRequest(0, last)};
+  Simulation simulation(
+      jobRequests,
+      loader.getGraph(),
+      1,
+      multi_agent_shortest_path_calculator_wrapper(compressed_path_database_calculator(database)));
+  simulation.advance();
+
+  // The database still leads through the blocked vertex, the wrapper routes around it
+  const Path remainingPath = simulation.getRunners()[0].getRemainingPath();
+  ASSERT_GE(remainingPath.size(), 3u);
+  const Vertex blockedVertex = remainingPath[2];
+  EXPECT_EQ(database.getNextVertex(remainingPath[1], last), std::optional<Vertex>(blockedVertex));
+  simulation.getObstacles().blockVertex(blockedVertex);
+  const Path replannedPath = simulation.getRunners()[0].getRemainingPath();
+  EXPECT_EQ(std::find(replannedPath.begin(), replannedPath.end(), blockedVertex), replannedPath.end());
+
+  const unsigned timeout = 1000;
+  while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
+  {
+    simulation.advance();
+  }
+  EXPECT_TRUE(simulation.isFinished());
+}
@@ -2,12 +2,23 @@
 
 #include <iostream>
 
-Constraints::Constraints(const WeightedDiGraph& graph) : locks(graph.m_vertices.size(), VertexLocksType())
+Constraints::Constraints(const WeightedDiGraph& graph) : Constraints(graph.m_vertices.size())
+{
+}
+
+Constraints::Constraints(size_t numberOfVertices)
+    : locks(numberOfVertices, VertexLocksType()), blockedVertices(numberOfVertices, false)
 {
 }
 
 bool Constraints::isVertexFreeForRunner(
     const Vertex& vertex, RunnerId runnerId, unsigned startTime, unsigned endTime) const
+{
+  return !blockedVertices[vertex] && isVertexUnlockedForRunner(vertex, runnerId, startTime, endTime);
+}
+
+bool Constraints::isVertexUnlockedForRunner(
+    const Vertex& vertex, RunnerId runnerId, unsigned startTime, unsigned endTime) const
 {
   const auto& interval_map = locks[vertex];
   const auto range = interval_map.equal_range(boost::icl::interval<unsigned>::right_open(startTime, endTime));
@@ -67,6 +78,10 @@ bool Constraints::isEdgeFreeForRunner(
   // needs checking here: two runners travelling the same direction on the same edge can never
   // overlap in time in the first place, since they would first have to occupy the same `from`
   // vertex at the same time, which vertex locking already prevents.
+  if (blockedEdges.count(DirectedEdge(from, to)) > 0)
+  {
+    return false;
+  }
   const auto reverseEdgeIterator = edgeLocks.find(DirectedEdge(to, from));
   if (reverseEdgeIterator == edgeLocks.end())
   {
@@ -112,3 +127,33 @@ void Constraints::unlockEdge(
         boost::icl::interval<unsigned>::right_open(startTime, endTime), VertexLockIntervalType({runnerId}));
   }
 }
+
+bool Constraints::isVertexBlocked(const Vertex& vertex) const
+{
+  return blockedVertices[vertex];
+}
+
+bool Constraints::isEdgeBlocked(const Vertex& from, const Vertex& to) const
+{
+  return blockedEdges.count(DirectedEdge(from, to)) > 0;
+}
+
+void Constraints::onVertexBlocked(Vertex vertex)
+{
+  blockedVertices[vertex] = true;
+}
+
+void Constraints::onVertexUnblocked(Vertex vertex)
+{
+  blockedVertices[vertex] = false;
+}
+
+void Constraints::onEdgeBlocked(Vertex from, Vertex to)
+{
+  blockedEdges.emplace(from, to);
+}
+
+void Constraints::onEdgeUnblocked(Vertex from, Vertex to)
+{
+  blockedEdges.erase(DirectedEdge(from, to));
+}
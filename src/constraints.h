@@ -3,17 +3,22 @@
 #include <boost/icl/interval_map.hpp>
 #include <map>
 #include <optional>
+#include <set>
 #include <utility>
 #include <vector>
 
 #include "graph.h"
+#include "obstacles.h"
 #include "runner.h"
 
-class Constraints
+/// @brief Time intervals in which vertices and edges are reserved for runners. Vertices and edges blocked by obstacles
+/// (see `Obstacles`, which notifies the constraints registered with it) are not free for any runner at any time.
+class Constraints : public ObstacleListener
 {
  public:
   Constraints() = delete;
   Constraints(const WeightedDiGraph &graph);
+  explicit Constraints(size_t numberOfVertices);
 
   bool isVertexFreeForRunner(
       const Vertex &vertex,
@@ -21,6 +26,14 @@ class Constraints
       unsigned startTime = std::numeric_limits<unsigned>::min(),
       unsigned endTime = std::numeric_limits<unsigned>::max()) const;
 
+  /// @brief Like `isVertexFreeForRunner`, but ignoring obstacles: only the locks of other runners count, e.g. for the
+  /// vertex a runner stands on when it gets blocked, which it is still allowed to leave.
+  bool isVertexUnlockedForRunner(
+      const Vertex &vertex,
+      RunnerId runnerId,
+      unsigned startTime = std::numeric_limits<unsigned>::min(),
+      unsigned endTime = std::numeric_limits<unsigned>::max()) const;
+
   // bool isVertexLockedForRunner(
   //     const Vertex &vertex,
   //     RunnerId runnerId,
@@ -68,6 +81,14 @@ class Constraints
       unsigned startTime = std::numeric_limits<unsigned>::min(),
       unsigned endTime = std::numeric_limits<unsigned>::max());
 
+  bool isVertexBlocked(const Vertex &vertex) const;
+  bool isEdgeBlocked(const Vertex &from, const Vertex &to) const;
+
+  void onVertexBlocked(Vertex vertex) override;
+  void onVertexUnblocked(Vertex vertex) override;
+  void onEdgeBlocked(Vertex from, Vertex to) override;
+  void onEdgeUnblocked(Vertex from, Vertex to) override;
+
  protected:
   typedef std::set<RunnerId> VertexLockIntervalType;
   typedef boost::icl::interval_map<unsigned, VertexLockIntervalType> VertexLocksType;
@@ -75,4 +96,7 @@ class Constraints
 
   typedef std::pair<Vertex, Vertex> DirectedEdge;
   std::map<DirectedEdge, VertexLocksType> edgeLocks;
+
+  std::vector<bool> blockedVertices;
+  std::set<DirectedEdge> blockedEdges;
 };
@@ -36,9 +36,9 @@ const RunnerId otherRunner = 3;
 TEST(Constraints, initially_no_vertex_is_locked)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
-  for (size_t vertex = 0; vertex < graph.m_vertices.size(); ++vertex)
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
+  for (size_t vertex = 0; vertex < graph->m_vertices.size(); ++vertex)
   {
     EXPECT_TRUE(constraints.getVertexLocks(vertex).empty());
   }
@@ -47,10 +47,10 @@ TEST(Constraints, initially_no_vertex_is_locked)
 TEST(Constraints, initially_vertices_are_free_for_any_runner_during_infinite_time)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   const size_t numberOfRunners = 10;
-  for (auto vertex = 0; vertex < graph.m_vertices.size(); ++vertex)
+  for (auto vertex = 0; vertex < graph->m_vertices.size(); ++vertex)
   {
     for (auto runner = 0; runner < numberOfRunners; ++runner)
     {
@@ -62,8 +62,8 @@ TEST(Constraints, initially_vertices_are_free_for_any_runner_during_infinite_tim
 TEST(Constraints, lock_vertex_locks_vertex_to_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner));
   EXPECT_EQ(constraints.getVertexLock(defaultVertex, 0), defaultRunner);
 }
@@ -71,8 +71,8 @@ TEST(Constraints, lock_vertex_locks_vertex_to_runner)
 TEST(Constraints, lock_vertex_locks_vertex_to_runner_for_infinite_time_if_time_interval_not_specified)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner));
   const auto& vertexLocks = constraints.getVertexLocks(1);
   auto numberOfIntervals = vertexLocks.iterative_size();
@@ -93,8 +93,8 @@ TEST(Constraints, lock_vertex_locks_vertex_to_runner_since_start_time_if_only_st
 {
   const unsigned lockedSince = 3;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince));
   const auto& vertexLocks = constraints.getVertexLocks(1);
   auto numberOfIntervals = vertexLocks.iterative_size();
@@ -116,8 +116,8 @@ TEST(Constraints, lock_vertex_locks_vertex_to_runner_for_specified_time_interval
   const unsigned lockedSince = 3;
   const unsigned lockedTill = 11;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince, lockedTill));
   const auto& vertexLocks = constraints.getVertexLocks(1);
   auto numberOfIntervals = vertexLocks.iterative_size();
@@ -140,8 +140,8 @@ TEST(Constraints, lock_vertex_with_same_interval_and_runner)
   const unsigned lockedSince = 3;
   const unsigned lockedTill = 11;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince, lockedTill));
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince, lockedTill));
   const auto& vertexLocks = constraints.getVertexLocks(1);
@@ -167,8 +167,8 @@ TEST(Constraints, lock_vertex_with_overlaping_interval_and_same_runner)
   const unsigned lockedSince2 = 7;
   const unsigned lockedTill2 = 23;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince1, lockedTill1));
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince2, lockedTill2));
   const auto& vertexLocks = constraints.getVertexLocks(1);
@@ -194,8 +194,8 @@ TEST(Constraints, lock_vertex_with_overlaping_interval_and_different_runner)
   const unsigned lockedSince2 = 7;
   const unsigned lockedTill2 = 23;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince1, lockedTill1));
   EXPECT_FALSE(constraints.lockVertex(defaultVertex, otherRunner, lockedSince2, lockedTill2));
   const auto& vertexLocks = constraints.getVertexLocks(1);
@@ -222,8 +222,8 @@ TEST(Constraints, lock_vertex_with_same_interval_and_different_runner_returns_fa
   const unsigned lockedSince = 3;
   const unsigned lockedTill = 11;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince, lockedTill));
   EXPECT_FALSE(constraints.lockVertex(defaultVertex, otherRunner, lockedSince, lockedTill));
   const auto& vertexLocks = constraints.getVertexLocks(1);
@@ -249,8 +249,8 @@ TEST(Constraints, lock_vertex_with_non_overlaping_intervals_and_same_runner)
   const unsigned lockedSince2 = 23;
   const unsigned lockedTill2 = 27;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince1, lockedTill1));
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince2, lockedTill2));
   const auto& vertexLocks = constraints.getVertexLocks(defaultVertex);
@@ -276,8 +276,8 @@ TEST(Constraints, lock_vertex_with_non_overlaping_intervals_and_different_runner
   const unsigned lockedSince2 = 23;
   const unsigned lockedTill2 = 27;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, lockedSince1, lockedTill1));
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, otherRunner, lockedSince2, lockedTill2));
   const auto& vertexLocks = constraints.getVertexLocks(defaultVertex);
@@ -298,8 +298,8 @@ TEST(Constraints, lock_vertex_with_non_overlaping_intervals_and_different_runner
 TEST(Constraints, lock_vertex_does_not_lock_any_other_vertex)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner));
   EXPECT_EQ(constraints.getVertexLock(otherVertex, 0), std::nullopt);
 }
@@ -307,8 +307,8 @@ TEST(Constraints, lock_vertex_does_not_lock_any_other_vertex)
 TEST(Constraints, locked_vertex_is_free_for_runner_its_locked_to)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner));
   EXPECT_TRUE(constraints.isVertexFreeForRunner(defaultVertex, defaultRunner));
 }
@@ -316,8 +316,8 @@ TEST(Constraints, locked_vertex_is_free_for_runner_its_locked_to)
 TEST(Constraints, locked_vertex_is_not_free_to_other_runner_then_it_was_locked_to)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner));
   EXPECT_FALSE(constraints.isVertexFreeForRunner(defaultVertex, otherRunner));
 }
@@ -325,8 +325,8 @@ TEST(Constraints, locked_vertex_is_not_free_to_other_runner_then_it_was_locked_t
 TEST(Constraints, unlock_vertex_releases_the_lock_of_given_runner_on_vertex)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner));
   constraints.unlockVertex(defaultVertex, defaultRunner);
   EXPECT_EQ(constraints.getVertexLock(defaultVertex, 0), std::nullopt);
@@ -337,8 +337,8 @@ TEST(Constraints, unlock_vertex_releases_the_lock_of_given_runner_on_vertex)
 TEST(Constraints, unlock_vertex_does_not_release_the_lock_if_called_for_other_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner));
   constraints.unlockVertex(defaultVertex, otherRunner);
   EXPECT_EQ(constraints.getVertexLock(defaultVertex, 0), defaultRunner);
@@ -349,8 +349,8 @@ TEST(Constraints, unlock_vertex_does_not_release_the_lock_if_called_for_other_ru
 TEST(Constraints, unlock_vertex_called_on_vertex_that_is_not_locked_preserves_its_state)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   constraints.unlockVertex(defaultVertex, defaultRunner);
   EXPECT_EQ(constraints.getVertexLock(defaultVertex, 0), std::nullopt);
   EXPECT_TRUE(constraints.isVertexFreeForRunner(defaultVertex, defaultRunner));
@@ -360,8 +360,8 @@ TEST(Constraints, unlock_vertex_called_on_vertex_that_is_not_locked_preserves_it
 TEST(Constraints, unlock_vertex_releases_all_locks_of_given_runner_on_vertex_if_called_without_specified_interval)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 2, 3));
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 5, 7));
   constraints.unlockVertex(defaultVertex, defaultRunner);
@@ -373,8 +373,8 @@ TEST(Constraints, unlock_vertex_releases_all_locks_of_given_runner_on_vertex_if_
 TEST(Constraints, unlock_vertex_preserves_locks_of_other_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 2, 3));
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, otherRunner, 11, 13));
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 5, 7));
@@ -388,8 +388,8 @@ TEST(Constraints, unlock_vertex_preserves_locks_of_other_runner)
 TEST(Constraints, unlock_vertex_releases_whole_interval_if_called_with_same_interval)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 5, 7));
   constraints.unlockVertex(defaultVertex, defaultRunner, 5, 7);
   const auto& vertexLocks = constraints.getVertexLocks(defaultVertex);
@@ -403,8 +403,8 @@ TEST(Constraints, unlock_vertex_releases_whole_interval_if_called_with_same_inte
 TEST(Constraints, unlock_vertex_releases_whole_interval_if_called_with_larger_interval)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 5, 7));
   constraints.unlockVertex(defaultVertex, defaultRunner, 3, 9);
   const auto& vertexLocks = constraints.getVertexLocks(defaultVertex);
@@ -418,8 +418,8 @@ TEST(Constraints, unlock_vertex_releases_whole_interval_if_called_with_larger_in
 TEST(Constraints, unlock_vertex_releases_part_of_the_interval_if_called_with_overlaping_interval_after)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 3, 9));
   constraints.unlockVertex(defaultVertex, defaultRunner, 7, 9);
   const auto& vertexLocks = constraints.getVertexLocks(defaultVertex);
@@ -442,8 +442,8 @@ TEST(Constraints, unlock_vertex_releases_part_of_the_interval_if_called_with_ove
 TEST(Constraints, unlock_vertex_releases_part_of_the_interval_if_called_with_overlaping_interval_before)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 3, 9));
   constraints.unlockVertex(defaultVertex, defaultRunner, 2, 5);
   const auto& vertexLocks = constraints.getVertexLocks(defaultVertex);
@@ -466,8 +466,8 @@ TEST(Constraints, unlock_vertex_releases_part_of_the_interval_if_called_with_ove
 TEST(Constraints, unlock_vertex_releases_part_of_the_interval_if_called_with_overlaping_interval_inside)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 3, 9));
   constraints.unlockVertex(defaultVertex, defaultRunner, 5, 7);
   const auto& vertexLocks = constraints.getVertexLocks(defaultVertex);
@@ -489,8 +489,8 @@ TEST(Constraints, unlock_vertex_releases_part_of_the_interval_if_called_with_ove
 TEST(Constraints, unlock_vertex_preserves_lock_if_called_with_disjoint_interval)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockVertex(defaultVertex, defaultRunner, 3, 5));
   constraints.unlockVertex(defaultVertex, defaultRunner, 7, 9);
   const auto& vertexLocks = constraints.getVertexLocks(defaultVertex);
@@ -512,8 +512,8 @@ TEST(Constraints, unlock_vertex_preserves_lock_if_called_with_disjoint_interval)
 TEST(Constraints, unlock_vertex_unlocks_the_vertex_interval)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   constraints.lockVertex(1, 7);
   auto vertexLocks = constraints.getVertexLocks(1);
   constraints.unlockVertex(1, 7);
@@ -526,9 +526,9 @@ TEST(Constraints, unlock_vertex_unlocks_the_vertex_interval)
 TEST(Constraints, unlock_vertex_does_not_unlock_any_other_vertex)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
-  for (size_t vertex = 0; vertex < graph.m_vertices.size(); ++vertex)
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
+  for (size_t vertex = 0; vertex < graph->m_vertices.size(); ++vertex)
   {
     constraints.lockVertex(vertex, 7);
   }
@@ -541,8 +541,8 @@ TEST(Constraints, unlock_vertex_does_not_unlock_any_other_vertex)
 TEST(Constraints, unlocked_vertex_is_free_for_any_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   constraints.lockVertex(1, 7);
   constraints.unlockVertex(1, 7);
   const size_t numberOfRunners = 10;
@@ -555,8 +555,8 @@ TEST(Constraints, unlocked_vertex_is_free_for_any_runner)
 TEST(Constraints, is_vertex_free_for_runner_returns_false_if_other_runner_locked_part_of_requested_interval)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   constraints.lockVertex(defaultVertex, defaultRunner, 5, 7);
   constraints.lockVertex(defaultVertex, otherRunner, 7, 9);
   EXPECT_FALSE(constraints.isVertexFreeForRunner(defaultVertex, defaultRunner));
@@ -577,8 +577,8 @@ TEST(Constraints, is_vertex_free_for_runner_returns_false_if_other_runner_locked
 TEST(Constraints, initially_no_edge_is_locked)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.getEdgeLocks(defaultVertex, otherVertex).empty());
   EXPECT_TRUE(constraints.getEdgeLocks(otherVertex, defaultVertex).empty());
 }
@@ -586,8 +586,8 @@ TEST(Constraints, initially_no_edge_is_locked)
 TEST(Constraints, initially_edges_are_free_for_any_runner_during_infinite_time)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   const size_t numberOfRunners = 10;
   for (auto runner = 0; runner < numberOfRunners; ++runner)
   {
@@ -599,8 +599,8 @@ TEST(Constraints, initially_edges_are_free_for_any_runner_during_infinite_time)
 TEST(Constraints, lock_edge_locks_the_directed_edge_to_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(defaultVertex, otherVertex, defaultRunner, 5, 7));
   const auto& edgeLocks = constraints.getEdgeLocks(defaultVertex, otherVertex);
   auto numberOfIntervals = edgeLocks.iterative_size();
@@ -618,8 +618,8 @@ TEST(Constraints, lock_edge_locks_the_directed_edge_to_runner)
 TEST(Constraints, lock_edge_does_not_lock_the_reverse_edge)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(defaultVertex, otherVertex, defaultRunner, 5, 7));
   EXPECT_TRUE(constraints.getEdgeLocks(otherVertex, defaultVertex).empty());
 }
@@ -630,8 +630,8 @@ TEST(Constraints, is_edge_free_for_runner_ignores_a_different_runner_using_the_s
   // they would first have to occupy the same "from" vertex at the same time, which vertex locking
   // already forbids. isEdgeFreeForRunner only guards against swapping with the *reverse* direction.
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(defaultVertex, otherVertex, otherRunner, 5, 7));
   EXPECT_TRUE(constraints.isEdgeFreeForRunner(defaultVertex, otherVertex, defaultRunner, 5, 7));
 }
@@ -639,8 +639,8 @@ TEST(Constraints, is_edge_free_for_runner_ignores_a_different_runner_using_the_s
 TEST(Constraints, is_edge_free_for_runner_returns_false_if_reverse_edge_locked_to_different_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(otherVertex, defaultVertex, otherRunner, 5, 7));
   EXPECT_FALSE(constraints.isEdgeFreeForRunner(defaultVertex, otherVertex, defaultRunner, 5, 7));
   EXPECT_FALSE(constraints.isEdgeFreeForRunner(defaultVertex, otherVertex, defaultRunner, 6, 8));
@@ -651,8 +651,8 @@ TEST(Constraints, is_edge_free_for_runner_returns_false_if_reverse_edge_locked_t
 TEST(Constraints, is_edge_free_for_runner_returns_true_if_reverse_edge_locked_to_the_same_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(otherVertex, defaultVertex, defaultRunner, 5, 7));
   EXPECT_TRUE(constraints.isEdgeFreeForRunner(defaultVertex, otherVertex, defaultRunner, 5, 7));
 }
@@ -660,8 +660,8 @@ TEST(Constraints, is_edge_free_for_runner_returns_true_if_reverse_edge_locked_to
 TEST(Constraints, lock_edge_fails_and_reserves_nothing_if_reverse_edge_locked_to_different_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(otherVertex, defaultVertex, otherRunner, 5, 7));
   EXPECT_FALSE(constraints.lockEdge(defaultVertex, otherVertex, defaultRunner, 5, 7));
   EXPECT_TRUE(constraints.getEdgeLocks(defaultVertex, otherVertex).empty());
@@ -671,8 +671,8 @@ TEST(Constraints, lock_edge_does_not_lock_a_different_vertex_pair)
 {
   const Vertex thirdVertex = 3;
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(defaultVertex, otherVertex, defaultRunner, 5, 7));
   EXPECT_TRUE(constraints.getEdgeLocks(defaultVertex, thirdVertex).empty());
   EXPECT_TRUE(constraints.getEdgeLocks(thirdVertex, otherVertex).empty());
@@ -681,8 +681,8 @@ TEST(Constraints, lock_edge_does_not_lock_a_different_vertex_pair)
 TEST(Constraints, unlock_edge_releases_the_lock_of_given_runner_on_the_edge)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(otherVertex, defaultVertex, defaultRunner, 5, 7));
   constraints.unlockEdge(otherVertex, defaultVertex, defaultRunner, 5, 7);
   const auto& edgeLocks = constraints.getEdgeLocks(otherVertex, defaultVertex);
@@ -694,10 +694,35 @@ TEST(Constraints, unlock_edge_releases_the_lock_of_given_runner_on_the_edge)
 TEST(Constraints, unlock_edge_does_not_release_the_lock_if_called_for_other_runner)
 {
   DefaultGraphLoader loader;
-  WeightedDiGraph graph = loader.getGraph();
-  ConstraintsStub constraints(graph);
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
   EXPECT_TRUE(constraints.lockEdge(otherVertex, defaultVertex, defaultRunner, 5, 7));
   constraints.unlockEdge(otherVertex, defaultVertex, otherRunner, 5, 7);
   EXPECT_FALSE(constraints.isEdgeFreeForRunner(defaultVertex, otherVertex, otherRunner, 5, 7));
   EXPECT_TRUE(constraints.isEdgeFreeForRunner(defaultVertex, otherVertex, defaultRunner, 5, 7));
 }
+
+TEST(Constraints, blocked_vertices_and_edges_are_free_for_no_runner_until_unblocked)
+{
+  DefaultGraphLoader loader;
+  const auto graph = loader.getGraph();
+  ConstraintsStub constraints(*graph);
+  Obstacles obstacles(graph->m_vertices.size());
+  obstacles.addListener(constraints);
+
+  obstacles.blockVertex(defaultVertex);
+  obstacles.blockEdge(defaultVertex, otherVertex);
+  EXPECT_TRUE(constraints.isVertexBlocked(defaultVertex));
+  EXPECT_FALSE(constraints.isVertexFreeForRunner(defaultVertex, defaultRunner));
+  EXPECT_FALSE(constraints.lockVertex(defaultVertex, defaultRunner, 5, 7));
+  EXPECT_FALSE(constraints.isEdgeFreeForRunner(defaultVertex, otherVertex, defaultRunner, 5, 7));
+  EXPECT_TRUE(constraints.isEdgeFreeForRunner(otherVertex, defaultVertex, defaultRunner, 5, 7));
+  EXPECT_TRUE(constraints.isVertexFreeForRunner(otherVertex, defaultRunner));
+
+  obstacles.unblockVertex(defaultVertex);
+  obstacles.unblockEdge(defaultVertex, otherVertex);
+  EXPECT_FALSE(constraints.isVertexBlocked(defaultVertex));
+  EXPECT_TRUE(constraints.isVertexFreeForRunner(defaultVertex, defaultRunner));
+  EXPECT_TRUE(constraints.isEdgeFreeForRunner(defaultVertex, otherVertex, defaultRunner, 5, 7));
+  obstacles.removeListener(constraints);
+}
@@ -0,0 +1,387 @@
+#include "contraction-hierarchy.h"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "search-context.h"
+
+namespace
+{
+constexpr Distance Infinity = std::numeric_limits<Distance>::max();
+/// Vertices a witness search may settle before it gives up, which only costs an unneeded shortcut
+constexpr size_t WitnessSearchLimit = 500;
+
+struct DynamicEdge {
+  uint32_t vertex;
+  Distance weight;
+  uint32_t middle;
+};
+
+struct Shortcut {
+  uint32_t from;
+  uint32_t to;
+  Distance weight;
+};
+
+// Graph of the vertices not contracted yet, with the shortcuts added so far
+class Contractor
+{
+ public:
+  explicit Contractor(const CompressedSparseRowGraph& graph)
+      : outEdges(graph.getNumberOfVertices())
+      , inEdges(graph.getNumberOfVertices())
+      , contractedNeighbors(graph.getNumberOfVertices(), 0)
+  {
+    for (Vertex vertex = 0; vertex < graph.getNumberOfVertices(); ++vertex)
+    {
+      for_each_out_edge(
+          graph,
+          vertex,
+          [this, vertex](Vertex target, Distance weight)
+          {
+            if (target != vertex)
+            {
+              addEdge(static_cast<uint32_t>(vertex), static_cast<uint32_t>(target), weight, NoMiddle);
+            }
+          });
+    }
+  }
+
+  // Priority of contracting `vertex` next, lower first. Keeps the shortcuts it would need for `contract`.
+  int evaluate(Vertex vertex)
+  {
+    findShortcuts(vertex);
+    const size_t removedEdges = inEdges[vertex].size() + outEdges[vertex].size();
+    return static_cast<int>(shortcuts.size()) - static_cast<int>(removedEdges) + contractedNeighbors[vertex];
+  }
+
+  // Removes `vertex`, which must be the last one evaluated, returning its edges to and from the remaining vertices
+  std::pair<std::vector<DynamicEdge>, std::vector<DynamicEdge>> contract(Vertex vertex)
+  {
+    std::vector<DynamicEdge> upwardEdges = std::move(outEdges[vertex]);
+    std::vector<DynamicEdge> downwardEdges = std::move(inEdges[vertex]);
+    outEdges[vertex].clear();
+    inEdges[vertex].clear();
+    auto isContracted = [vertex](const DynamicEdge& edge) { return edge.vertex == vertex; };
+    for (const DynamicEdge& edge : downwardEdges)
+    {
+      std::erase_if(outEdges[edge.vertex], isContracted);
+      ++contractedNeighbors[edge.vertex];
+    }
+    for (const DynamicEdge& edge : upwardEdges)
+    {
+      std::erase_if(inEdges[edge.vertex], isContracted);
+      ++contractedNeighbors[edge.vertex];
+    }
+    for (const Shortcut& shortcut : shortcuts)
+    {
+      addEdge(shortcut.from, shortcut.to, shortcut.weight, static_cast<uint32_t>(vertex));
+    }
+    return {std::move(upwardEdges), std::move(downwardEdges)};
+  }
+
+ private:
+  static constexpr uint32_t NoMiddle = ContractionHierarchy::NoVertex;
+
+  // Adds an edge, or lowers the weight of the existing edge between the same vertices
+  void addEdge(uint32_t from, uint32_t to, Distance weight, uint32_t middle)
+  {
+    for (DynamicEdge& edge : outEdges[from])
+    {
+      if (edge.vertex != to) continue;
+      if (weight < edge.weight)
+      {
+        edge = {to, weight, middle};
+        for (DynamicEdge& inEdge : inEdges[to])
+        {
+          if (inEdge.vertex == from) inEdge = {from, weight, middle};
+        }
+      }
+      return;
+    }
+    outEdges[from].push_back({to, weight, middle});
+    inEdges[to].push_back({from, weight, middle});
+  }
+
+  // Fills `shortcuts` with the paths through `vertex` that no path around it is as short as
+  void findShortcuts(Vertex vertex)
+  {
+    shortcuts.clear();
+    for (const DynamicEdge& inEdge : inEdges[vertex])
+    {
+      std::optional<Distance> maximumDistance;
+      for (const DynamicEdge& outEdge : outEdges[vertex])
+      {
+        if (outEdge.vertex == inEdge.vertex) continue;
+        maximumDistance = std::max(maximumDistance.value_or(0.0f), inEdge.weight + outEdge.weight);
+      }
+      if (!maximumDistance) continue;
+
+      searchWitnesses(inEdge.vertex, vertex, *maximumDistance);
+      for (const DynamicEdge& outEdge : outEdges[vertex])
+      {
+        const Distance distance = inEdge.weight + outEdge.weight;
+        if (outEdge.vertex != inEdge.vertex && witnessContext.getDistance(outEdge.vertex) > distance)
+        {
+          shortcuts.push_back({inEdge.vertex, outEdge.vertex, distance});
+        }
+      }
+    }
+  }
+
+  // Dijkstra from `source` avoiding `vertex`, up to `maximumDistance` or `WitnessSearchLimit` settled vertices
+  void searchWitnesses(Vertex source, Vertex vertex, Distance maximumDistance)
+  {
+    witnessContext.startSearch(outEdges.size());
+    witnessContext.reach(source, 0.0f, source);
+    queue.assign(1, {0.0f, source});
+    for (size_t settled = 0; !queue.empty() && settled < WitnessSearchLimit; ++settled)
+    {
+      std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+      const auto [distance, current] = queue.back();
+      queue.pop_back();
+      if (distance > maximumDistance) break;
+      if (witnessContext.isExpanded(current)) continue;
+      witnessContext.setExpanded(current);
+      for (const DynamicEdge& edge : outEdges[current])
+      {
+        const Distance nextDistance = distance + edge.weight;
+        if (edge.vertex != vertex && nextDistance < witnessContext.getDistance(edge.vertex))
+        {
+          witnessContext.reach(edge.vertex, nextDistance, current);
+          queue.emplace_back(nextDistance, edge.vertex);
+          std::push_heap(queue.begin(), queue.end(), std::greater<>());
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<DynamicEdge>> outEdges;
+  std::vector<std::vector<DynamicEdge>> inEdges;
+  std::vector<int> contractedNeighbors;
+  std::vector<Shortcut> shortcuts;
+  SearchContext witnessContext;
+  std::vector<std::pair<Distance, Vertex>> queue;
+};
+}  // namespace
+
+ContractionHierarchy::ContractionHierarchy(const CompressedSparseRowGraph& graph)
+    : numberOfShortcuts(0), ranks(graph.getNumberOfVertices(), 0)
+{
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  Contractor contractor(graph);
+  typedef std::pair<int, Vertex> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    queue.emplace(contractor.evaluate(vertex), vertex);
+  }
+
+  std::vector<std::vector<DynamicEdge>> upward(numberOfVertices);
+  std::vector<std::vector<DynamicEdge>> downward(numberOfVertices);
+  uint32_t rank = 0;
+  while (!queue.empty())
+  {
+    const Vertex vertex = queue.top().second;
+    queue.pop();
+    // Priorities change as neighbors get contracted: re-evaluate, and postpone the vertex if it got worse
+    const int priority = contractor.evaluate(vertex);
+    if (!queue.empty() && priority > queue.top().first)
+    {
+      queue.emplace(priority, vertex);
+      continue;
+    }
+    ranks[vertex] = rank++;
+    std::tie(upward[vertex], downward[vertex]) = contractor.contract(vertex);
+  }
+
+  auto flatten = [this](const std::vector<std::vector<DynamicEdge>>& lists, std::vector<uint32_t>& offsets)
+  {
+    std::vector<Edge> edges;
+    offsets.assign(1, 0);
+    for (const std::vector<DynamicEdge>& list : lists)
+    {
+      for (const DynamicEdge& edge : list)
+      {
+        edges.push_back({edge.vertex, edge.weight, edge.middle});
+        if (edge.middle != NoVertex) ++numberOfShortcuts;
+      }
+      offsets.push_back(static_cast<uint32_t>(edges.size()));
+    }
+    return edges;
+  };
+  upwardEdges = flatten(upward, upwardOffsets);
+  downwardEdges = flatten(downward, downwardOffsets);
+}
+
+size_t ContractionHierarchy::getNumberOfVertices() const
+{
+  return ranks.size();
+}
+
+size_t ContractionHierarchy::getNumberOfShortcuts() const
+{
+  return numberOfShortcuts;
+}
+
+uint32_t ContractionHierarchy::getRank(Vertex vertex) const
+{
+  return ranks[vertex];
+}
+
+Path ContractionHierarchy::findShortestPath(Vertex start, Vertex target) const
+{
+  // Kept per thread like `SearchContext::getThreadContext`, one for each direction
+  thread_local SearchContext forward;
+  thread_local SearchContext backward;
+  typedef std::pair<Distance, Vertex> Entry;
+  typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> Queue;
+  Queue forwardQueue;
+  Queue backwardQueue;
+  forward.startSearch(ranks.size());
+  backward.startSearch(ranks.size());
+  forward.reach(start, 0.0f, start);
+  backward.reach(target, 0.0f, target);
+  forwardQueue.emplace(0.0f, start);
+  backwardQueue.emplace(0.0f, target);
+
+  Distance bestDistance = Infinity;
+  Vertex meeting = NoVertex;
+  // Settles the next vertex of one direction, relaxing `edges` unless one of `stallEdges`, which come from more
+  // important vertices, reaches it shorter: then no shortest path goes up through it
+  auto settle = [&](SearchContext& context,
+                    const SearchContext& other,
+                    Queue& queue,
+                    const std::vector<uint32_t>& offsets,
+                    const std::vector<Edge>& edges,
+                    const std::vector<uint32_t>& stallOffsets,
+                    const std::vector<Edge>& stallEdges)
+  {
+    const auto [distance, vertex] = queue.top();
+    queue.pop();
+    if (context.isExpanded(vertex)) return;
+    context.setExpanded(vertex);
+    if (other.isReached(vertex) && distance + other.getDistance(vertex) < bestDistance)
+    {
+      bestDistance = distance + other.getDistance(vertex);
+      meeting = vertex;
+    }
+    for (uint32_t edge = stallOffsets[vertex]; edge < stallOffsets[vertex + 1]; ++edge)
+    {
+      if (context.getDistance(stallEdges[edge].vertex) + stallEdges[edge].weight < distance) return;
+    }
+    for (uint32_t edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge)
+    {
+      const Distance nextDistance = distance + edges[edge].weight;
+      if (nextDistance < context.getDistance(edges[edge].vertex))
+      {
+        context.reach(edges[edge].vertex, nextDistance, vertex);
+        queue.emplace(nextDistance, edges[edge].vertex);
+      }
+    }
+  };
+
+  while (!forwardQueue.empty() || !backwardQueue.empty())
+  {
+    const Distance forwardMinimum = forwardQueue.empty() ? Infinity : forwardQueue.top().first;
+    const Distance backwardMinimum = backwardQueue.empty() ? Infinity : backwardQueue.top().first;
+    if (std::min(forwardMinimum, backwardMinimum) >= bestDistance) break;
+    if (forwardMinimum <= backwardMinimum)
+    {
+      settle(forward, backward, forwardQueue, upwardOffsets, upwardEdges, downwardOffsets, downwardEdges);
+    }
+    else
+    {
+      settle(backward, forward, backwardQueue, downwardOffsets, downwardEdges, upwardOffsets, upwardEdges);
+    }
+  }
+
+  if (meeting == NoVertex)
+  {
+    std::ostringstream message;
+    message << "Unable to find path from " << start << " to " << target << std::endl;
+    throw std::runtime_error(message.str());
+  }
+
+  // Up from the start to the meeting vertex, then down to the target
+  Path hierarchyPath;
+  for (Vertex vertex = meeting; vertex != start; vertex = forward.getPredecessor(vertex))
+  {
+    hierarchyPath.push_back(vertex);
+  }
+  hierarchyPath.push_back(start);
+  std::reverse(hierarchyPath.begin(), hierarchyPath.end());
+  for (Vertex vertex = meeting; vertex != target;)
+  {
+    vertex = backward.getPredecessor(vertex);
+    hierarchyPath.push_back(vertex);
+  }
+
+  Path path{start};
+  for (size_t index = 1; index < hierarchyPath.size(); ++index)
+  {
+    appendUnpackedEdge(hierarchyPath[index - 1], hierarchyPath[index], path);
+  }
+  return path;
+}
+
+uint32_t ContractionHierarchy::getMiddle(Vertex from, Vertex to) const
+{
+  if (ranks[from] < ranks[to])
+  {
+    for (uint32_t edge = upwardOffsets[from]; edge < upwardOffsets[from + 1]; ++edge)
+    {
+      if (upwardEdges[edge].vertex == to) return upwardEdges[edge].middle;
+    }
+  }
+  else
+  {
+    for (uint32_t edge = downwardOffsets[to]; edge < downwardOffsets[to + 1]; ++edge)
+    {
+      if (downwardEdges[edge].vertex == from) return downwardEdges[edge].middle;
+    }
+  }
+  return NoVertex;
+}
+
+void ContractionHierarchy::appendUnpackedEdge(Vertex from, Vertex to, Path& path) const
+{
+  // Shortcuts nest as deep as the hierarchy, so they are unpacked from a stack of edges instead of recursively
+  std::vector<std::pair<Vertex, Vertex>> edges{{from, to}};
+  while (!edges.empty())
+  {
+    const auto [edgeFrom, edgeTo] = edges.back();
+    edges.pop_back();
+    const uint32_t middle = getMiddle(edgeFrom, edgeTo);
+    if (middle == NoVertex)
+    {
+      path.push_back(edgeTo);
+    }
+    else
+    {
+      edges.emplace_back(middle, edgeTo);
+      edges.emplace_back(edgeFrom, middle);
+    }
+  }
+}
+
+Path contraction_hierarchy_shortest_path(
+    const ContractionHierarchy& hierarchy, const Vertex& start, const Vertex& target)
+{
+  return hierarchy.findShortestPath(start, target);
+}
+
+ShortestPathCalculator contraction_hierarchy_calculator(const ContractionHierarchy& hierarchy)
+{
+  return [&hierarchy](const WeightedDiGraph& graph, const Vertex& start, const Vertex& target)
+  {
+    check_calculator_graph(graph, hierarchy.getNumberOfVertices(), "Contraction hierarchy");
+    return hierarchy.findShortestPath(start, target);
+  };
+}
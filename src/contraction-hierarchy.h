@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "csr-graph.h"
+#include "graph.h"
+#include "path-finding.h"
+
+/// @brief Contraction Hierarchies: a preprocessing of a static graph after which shortest path queries only search
+/// upwards in a hierarchy of vertices, settling a few hundred of them instead of a good share of the graph.
+///
+/// Vertices are contracted one by one, least important first. Contracting a vertex removes it from the remaining
+/// graph, and adds a shortcut between two of its neighbors wherever the path through it is the only shortest one, as a
+/// witness search around it finds. Importance is the edge difference (shortcuts added minus edges removed) plus the
+/// number of contracted neighbors, which spreads the contraction over the graph, and is updated lazily.
+///
+/// A query runs Dijkstra upwards from both ends, forwards from the start and backwards from the target, over the
+/// edges to more important vertices, prunes vertices reached shorter from above (stall-on-demand), and unpacks the
+/// shortcuts of the best meeting into the original vertices. Paths ignore `Obstacles`, as the shortcuts over them
+/// would have to be contracted again.
+class ContractionHierarchy
+{
+ public:
+  static constexpr uint32_t NoVertex = std::numeric_limits<uint32_t>::max();
+
+  explicit ContractionHierarchy(const CompressedSparseRowGraph& graph);
+
+  size_t getNumberOfVertices() const;
+  size_t getNumberOfShortcuts() const;
+  /// @brief Position of `vertex` in the contraction order, higher for more important vertices.
+  uint32_t getRank(Vertex vertex) const;
+
+  /// @brief Shortest path over the original vertices.
+  /// @throws std::runtime_error if `target` can't be reached from `start`.
+  Path findShortestPath(Vertex start, Vertex target) const;
+
+ private:
+  /// Edge between a vertex and a more important one, which stands for the two edges through `middle` if it is a
+  /// shortcut
+  struct Edge {
+    uint32_t vertex;
+    Distance weight;
+    uint32_t middle;
+  };
+
+  /// Middle vertex of the edge from `from` to `to`, `NoVertex` if it is an original edge
+  uint32_t getMiddle(Vertex from, Vertex to) const;
+  /// Appends the original vertices the edge from `from` to `to` stands for, without `from`, to `path`
+  void appendUnpackedEdge(Vertex from, Vertex to, Path& path) const;
+
+  size_t numberOfShortcuts;
+  std::vector<uint32_t> ranks;
+  /// Edges from every vertex to more important ones, searched forwards from the start
+  std::vector<uint32_t> upwardOffsets;
+  std::vector<Edge> upwardEdges;
+  /// Edges into every vertex from more important ones, searched backwards from the target
+  std::vector<uint32_t> downwardOffsets;
+  std::vector<Edge> downwardEdges;
+};
+
+/// @brief Shortest path query on a contraction hierarchy. Paths are as long as those of `dijkstra_shortest_path`.
+Path contraction_hierarchy_shortest_path(
+    const ContractionHierarchy& hierarchy, const Vertex& start, const Vertex& target);
+
+/// @brief Binds queries on `hierarchy` to a `ShortestPathCalculator`. Queries only walk the shortcuts of the hierarchy,
+/// so the `WeightedDiGraph` given to the calculator must be the graph it was contracted from (e.g. loaded by the same
+/// `MapGraphLoader` as its compressed graph); one with another number of vertices throws `std::invalid_argument`. The
+/// hierarchy must outlive the calculator.
+ShortestPathCalculator contraction_hierarchy_calculator(const ContractionHierarchy& hierarchy);
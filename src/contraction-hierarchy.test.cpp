@@ -0,0 +1,118 @@
+#include "contraction-hierarchy.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "test-data.h"
+
+namespace
+{
+// Length of `path` over the lightest edges between its consecutive vertices, failing if one of them is missing
+Distance getPathLength(const CompressedSparseRowGraph& graph, const Path& path)
+{
+  Distance length = 0.0f;
+  for (size_t index = 1; index < path.size(); ++index)
+  {
+    Distance weight = std::numeric_limits<Distance>::max();
+    for_each_out_edge(
+        graph,
+        path[index - 1],
+        [&](Vertex next, Distance edgeWeight)
+        {
+          if (next == path[index]) weight = std::min(weight, edgeWeight);
+        });
+    EXPECT_NE(weight, std::numeric_limits<Distance>::max()) << path[index - 1] << " -> " << path[index];
+    length += weight;
+  }
+  return length;
+}
+}  // namespace
+
+TEST(ContractionHierarchy, ranks_every_vertex_once)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const ContractionHierarchy hierarchy(graph);
+
+  ASSERT_EQ(hierarchy.getNumberOfVertices(), graph.getNumberOfVertices());
+  std::set<uint32_t> ranks;
+  for (Vertex vertex = 0; vertex < graph.getNumberOfVertices(); ++vertex)
+  {
+    ranks.insert(hierarchy.getRank(vertex));
+  }
+  EXPECT_EQ(ranks.size(), graph.getNumberOfVertices());
+  EXPECT_EQ(*ranks.rbegin(), graph.getNumberOfVertices() - 1);
+  EXPECT_GT(hierarchy.getNumberOfShortcuts(), 0u);
+}
+
+TEST(ContractionHierarchy, finds_shortest_paths_on_directed_graph)
+{
+  DefaultGraphLoader loader;
+  const CompressedSparseRowGraph graph(*loader.getGraph());
+  const ContractionHierarchy hierarchy(graph);
+  SearchContext context;
+  for (Vertex start = 0; start < 4; ++start)
+  {
+    for (Vertex target = 0; target < 4; ++target)
+    {
+      Path expected;
+      try
+      {
+        expected = dijkstra_shortest_path(graph, start, target, context);
+      } catch (const std::runtime_error&)
+      {
+        EXPECT_THROW(contraction_hierarchy_shortest_path(hierarchy, start, target), std::runtime_error);
+        continue;
+      }
+      const Path path = contraction_hierarchy_shortest_path(hierarchy, start, target);
+      EXPECT_EQ(path.front(), start);
+      EXPECT_EQ(path.back(), target);
+      EXPECT_EQ(getPathLength(graph, path), context.getDistance(target)) << start << " -> " << target;
+    }
+  }
+}
+
+TEST(ContractionHierarchy, paths_are_as_long_as_dijkstra_paths)
+{
+  for (const std::string name : {"maze-32-32-2", "maze-128-128-1", "warehouse-10-20-10-2-1"})
+  {
+    MapGraphLoader loader(getMapFilename(name));
+    const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+    const ContractionHierarchy hierarchy(graph);
+    const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+    SearchContext context;
+    for (Vertex start = 1; start < numberOfVertices; start += numberOfVertices / 6 + 1)
+    {
+      for (Vertex target = 3; target < numberOfVertices; target += numberOfVertices / 13 + 1)
+      {
+        Path expected;
+        try
+        {
+          expected = dijkstra_shortest_path(graph, start, target, context);
+        } catch (const std::runtime_error&)
+        {
+          EXPECT_THROW(contraction_hierarchy_shortest_path(hierarchy, start, target), std::runtime_error);
+          continue;
+        }
+        const Path path = contraction_hierarchy_shortest_path(hierarchy, start, target);
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), start);
+        EXPECT_EQ(path.back(), target);
+        EXPECT_EQ(getPathLength(graph, path), context.getDistance(target)) << name << ": " << start << " -> " << target;
+      }
+    }
+  }
+}
+
+TEST(ContractionHierarchy, binds_to_shortest_path_calculator_of_map_graph)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const auto graph = loader.getGraph();
+  const ContractionHierarchy hierarchy(loader.getCompressedGraph());
+  const ShortestPathCalculator calculator = contraction_hierarchy_calculator(hierarchy);
+  const auto target = static_cast<Vertex>(num_vertices(*graph) - 1);
+  EXPECT_EQ(calculator(*graph, 0, target).size(), dijkstra_shortest_path(*graph, 0, target).size());
+  EXPECT_EQ(calculator(*graph, target, target), (Path{target}));
+  EXPECT_THROW(calculator(*DefaultGraphLoader().getGraph(), 0, 1), std::invalid_argument);
+}
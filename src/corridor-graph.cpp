@@ -0,0 +1,263 @@
+#include "corridor-graph.h"
+
+namespace
+{
+struct ReducedEdge {
+  Vertex source;
+  Vertex target;
+  Distance weight;
+  uint32_t corridor;
+  bool isForward;
+};
+}  // namespace
+
+Distance CorridorGraph::Corridor::getDistance(size_t from, size_t to) const
+{
+  if (from <= to)
+  {
+    return forwardDistances[to] - forwardDistances[from];
+  }
+  return backwardDistances[from] - backwardDistances[to];
+}
+
+void CorridorGraph::Corridor::appendWalk(size_t from, size_t to, Path& path) const
+{
+  if (from <= to)
+  {
+    path.insert(path.end(), vertices.begin() + from + 1, vertices.begin() + to + 1);
+  }
+  else
+  {
+    path.insert(path.end(), vertices.rbegin() + (vertices.size() - from), vertices.rbegin() + (vertices.size() - to));
+  }
+}
+
+CorridorGraph::CorridorGraph() = default;
+
+CorridorGraph::CorridorGraph(const CompressedSparseRowGraph& graph)
+{
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  const EdgeIndex* offsets = graph.getOffsets();
+  const CompressedSparseRowGraph::VertexIndex* targets = graph.getTargets();
+  const Distance* weights = graph.getWeights();
+
+  std::vector<uint32_t> inDegrees(numberOfVertices, 0);
+  for (size_t edge = 0; edge < graph.getNumberOfEdges(); ++edge)
+  {
+    ++inDegrees[targets[edge]];
+  }
+  auto findEdge = [&](Vertex from, Vertex to) -> std::optional<Distance>
+  {
+    for (EdgeIndex edge = offsets[from]; edge < offsets[from + 1]; ++edge)
+    {
+      if (targets[edge] == to) return weights[edge];
+    }
+    return std::nullopt;
+  };
+
+  std::vector<bool> isJunction(numberOfVertices, true);
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    if (offsets[vertex + 1] - offsets[vertex] != 2 || inDegrees[vertex] != 2) continue;
+    const Vertex first = targets[offsets[vertex]];
+    const Vertex second = targets[offsets[vertex] + 1];
+    if (first != second && first != vertex && second != vertex && findEdge(first, vertex) && findEdge(second, vertex))
+    {
+      isJunction[vertex] = false;
+    }
+  }
+
+  vertexCorridors.assign(numberOfVertices, NoCorridor);
+  vertexIndicesInCorridor.assign(numberOfVertices, NoCorridor);
+  std::vector<ReducedEdge> edges;
+  auto walkFrom = [&](Vertex junction)
+  {
+    for (EdgeIndex edge = offsets[junction]; edge < offsets[junction + 1]; ++edge)
+    {
+      const Vertex next = targets[edge];
+      if (isJunction[next])
+      {
+        edges.push_back({junction, next, weights[edge], NoCorridor, true});
+        continue;
+      }
+      if (vertexCorridors[next] != NoCorridor)
+      {
+        // Entered a corridor walked before from its other end, whose backward direction this edge starts
+        const Corridor& corridor = corridors[vertexCorridors[next]];
+        if (corridor.vertices.front() != junction)
+        {
+          edges.push_back({junction, corridor.vertices.front(), corridor.backwardDistances.back(),
+                           vertexCorridors[next], false});
+        }
+        continue;
+      }
+
+      const auto corridorIndex = static_cast<uint32_t>(corridors.size());
+      Corridor corridor;
+      corridor.vertices = {junction, next};
+      corridor.forwardDistances = {0.0f, weights[edge]};
+      while (!isJunction[corridor.vertices.back()])
+      {
+        const Vertex current = corridor.vertices.back();
+        const Vertex previous = corridor.vertices[corridor.vertices.size() - 2];
+        vertexCorridors[current] = corridorIndex;
+        vertexIndicesInCorridor[current] = static_cast<uint32_t>(corridor.vertices.size() - 1);
+        const EdgeIndex outEdge = targets[offsets[current]] != previous ? offsets[current] : offsets[current] + 1;
+        corridor.vertices.push_back(targets[outEdge]);
+        corridor.forwardDistances.push_back(corridor.forwardDistances.back() + weights[outEdge]);
+      }
+      corridor.backwardDistances.assign(corridor.vertices.size(), 0.0f);
+      for (size_t index = 1; index < corridor.vertices.size(); ++index)
+      {
+        corridor.backwardDistances[index] =
+            corridor.backwardDistances[index - 1] + *findEdge(corridor.vertices[index], corridor.vertices[index - 1]);
+      }
+      // Corridors leading back to their junction never shorten a path, but stay walkable from inside
+      if (corridor.vertices.back() != junction)
+      {
+        edges.push_back({junction, corridor.vertices.back(), corridor.forwardDistances.back(), corridorIndex, true});
+      }
+      corridors.push_back(std::move(corridor));
+    }
+  };
+
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    if (isJunction[vertex]) walkFrom(vertex);
+  }
+  // Whatever is left are cycles without any junction
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    if (!isJunction[vertex] && vertexCorridors[vertex] == NoCorridor)
+    {
+      isJunction[vertex] = true;
+      walkFrom(vertex);
+    }
+  }
+
+  vertexJunctions.assign(numberOfVertices, NoCorridor);
+  Point2DArray positions;
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    if (isJunction[vertex])
+    {
+      vertexJunctions[vertex] = static_cast<uint32_t>(junctionVertices.size());
+      junctionVertices.push_back(vertex);
+      positions.push_back(graph.getPosition(vertex));
+    }
+  }
+
+  // Counting sort of the edges by their source junction
+  std::vector<EdgeIndex> reducedOffsets(junctionVertices.size() + 1, 0);
+  for (const ReducedEdge& edge : edges)
+  {
+    ++reducedOffsets[vertexJunctions[edge.source] + 1];
+  }
+  for (size_t junction = 0; junction < junctionVertices.size(); ++junction)
+  {
+    reducedOffsets[junction + 1] += reducedOffsets[junction];
+  }
+  std::vector<CompressedSparseRowGraph::VertexIndex> reducedTargets(edges.size());
+  std::vector<Distance> reducedWeights(edges.size());
+  macroEdges.resize(edges.size());
+  std::vector<EdgeIndex> insertPositions(reducedOffsets.begin(), reducedOffsets.end() - 1);
+  for (const ReducedEdge& edge : edges)
+  {
+    const EdgeIndex position = insertPositions[vertexJunctions[edge.source]]++;
+    reducedTargets[position] = vertexJunctions[edge.target];
+    reducedWeights[position] = edge.weight;
+    macroEdges[position] = {edge.corridor, edge.isForward};
+  }
+  reducedGraph = CompressedSparseRowGraph(
+      std::move(reducedOffsets), std::move(reducedTargets), std::move(reducedWeights), std::move(positions));
+}
+
+const CompressedSparseRowGraph& CorridorGraph::getReducedGraph() const
+{
+  return reducedGraph;
+}
+
+size_t CorridorGraph::getNumberOfVertices() const
+{
+  return vertexJunctions.size();
+}
+
+size_t CorridorGraph::getNumberOfJunctions() const
+{
+  return junctionVertices.size();
+}
+
+std::optional<Vertex> CorridorGraph::getJunction(Vertex vertex) const
+{
+  if (vertexJunctions[vertex] == NoCorridor) return std::nullopt;
+  return vertexJunctions[vertex];
+}
+
+Vertex CorridorGraph::getVertex(Vertex junction) const
+{
+  return junctionVertices[junction];
+}
+
+std::vector<CorridorGraph::CorridorWalk> CorridorGraph::getExits(Vertex vertex) const
+{
+  if (vertexCorridors[vertex] == NoCorridor)
+  {
+    return {{vertexJunctions[vertex], 0.0f, {}}};
+  }
+  const Corridor& corridor = corridors[vertexCorridors[vertex]];
+  const size_t index = vertexIndicesInCorridor[vertex];
+  const size_t last = corridor.vertices.size() - 1;
+  std::vector<CorridorWalk> walks(2);
+  walks[0] = {vertexJunctions[corridor.vertices.front()], corridor.getDistance(index, 0), {}};
+  corridor.appendWalk(index, 0, walks[0].vertices);
+  walks[1] = {vertexJunctions[corridor.vertices.back()], corridor.getDistance(index, last), {}};
+  corridor.appendWalk(index, last, walks[1].vertices);
+  return walks;
+}
+
+std::vector<CorridorGraph::CorridorWalk> CorridorGraph::getEntries(Vertex vertex) const
+{
+  if (vertexCorridors[vertex] == NoCorridor)
+  {
+    return {{vertexJunctions[vertex], 0.0f, {}}};
+  }
+  const Corridor& corridor = corridors[vertexCorridors[vertex]];
+  const size_t index = vertexIndicesInCorridor[vertex];
+  const size_t last = corridor.vertices.size() - 1;
+  std::vector<CorridorWalk> walks(2);
+  walks[0] = {vertexJunctions[corridor.vertices.front()], corridor.getDistance(0, index), {}};
+  corridor.appendWalk(0, index, walks[0].vertices);
+  walks[1] = {vertexJunctions[corridor.vertices.back()], corridor.getDistance(last, index), {}};
+  corridor.appendWalk(last, index, walks[1].vertices);
+  return walks;
+}
+
+std::optional<std::pair<Distance, Path>> CorridorGraph::getWalkWithinCorridor(Vertex from, Vertex to) const
+{
+  if (vertexCorridors[from] == NoCorridor || vertexCorridors[from] != vertexCorridors[to]) return std::nullopt;
+  const Corridor& corridor = corridors[vertexCorridors[from]];
+  std::pair<Distance, Path> walk;
+  walk.first = corridor.getDistance(vertexIndicesInCorridor[from], vertexIndicesInCorridor[to]);
+  corridor.appendWalk(vertexIndicesInCorridor[from], vertexIndicesInCorridor[to], walk.second);
+  return walk;
+}
+
+void CorridorGraph::appendEdgeExpansion(EdgeIndex edge, Path& path) const
+{
+  const MacroEdge& macroEdge = macroEdges[edge];
+  if (macroEdge.corridor == NoCorridor)
+  {
+    path.push_back(junctionVertices[reducedGraph.getTargets()[edge]]);
+    return;
+  }
+  const Corridor& corridor = corridors[macroEdge.corridor];
+  const size_t last = corridor.vertices.size() - 1;
+  if (macroEdge.isForward)
+  {
+    corridor.appendWalk(0, last, path);
+  }
+  else
+  {
+    corridor.appendWalk(last, 0, path);
+  }
+}
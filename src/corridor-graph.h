@@ -0,0 +1,86 @@
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "csr-graph.h"
+#include "graph.h"
+
+/// @brief Graph with every chain of degree-2 vertices (a corridor) contracted into a single weighted macro-edge.
+///
+/// A corridor vertex has exactly two neighbors, connected by edges in both directions, and no other in- or out-edges.
+/// All other vertices are junctions, which form the reduced graph. Every macro-edge keeps its corridor, so that a path
+/// over the reduced graph can be unpacked into the path over the original vertices. Cycles made of corridor vertices
+/// only get one of their vertices promoted to a junction.
+class CorridorGraph
+{
+ public:
+  typedef CompressedSparseRowGraph::EdgeIndex EdgeIndex;
+  static constexpr uint32_t NoCorridor = std::numeric_limits<uint32_t>::max();
+
+  CorridorGraph();
+  explicit CorridorGraph(const CompressedSparseRowGraph& graph);
+
+  /// @brief Graph over the junctions, indexed by junction, positioned like the original vertices.
+  const CompressedSparseRowGraph& getReducedGraph() const;
+  size_t getNumberOfVertices() const;
+  size_t getNumberOfJunctions() const;
+  /// @brief Junction index of `vertex`, or nothing if it lies inside a corridor.
+  std::optional<Vertex> getJunction(Vertex vertex) const;
+  /// @brief Original vertex of a junction.
+  Vertex getVertex(Vertex junction) const;
+
+  /// @brief Way between a vertex and a junction through the corridor the vertex lies in.
+  struct CorridorWalk
+  {
+    Vertex junction;
+    Distance distance;
+    /// @brief Original vertices passed, in travel order, without the one the walk starts at.
+    Path vertices;
+  };
+
+  /// @brief Walks from `vertex` to the junctions it reaches without passing another junction: both ends of its
+  /// corridor, or an empty walk to itself for a junction.
+  std::vector<CorridorWalk> getExits(Vertex vertex) const;
+  /// @brief Walks to `vertex` from the junctions reaching it without passing another junction.
+  std::vector<CorridorWalk> getEntries(Vertex vertex) const;
+  /// @brief Distance and walk (without `from`) between two vertices of the same corridor, travelling along it.
+  std::optional<std::pair<Distance, Path>> getWalkWithinCorridor(Vertex from, Vertex to) const;
+
+  /// @brief Appends the original vertices a reduced graph edge stands for, after its source junction, to `path`.
+  void appendEdgeExpansion(EdgeIndex edge, Path& path) const;
+
+ private:
+  /// @brief Original vertices of a corridor, including both junctions it connects, in the order it was walked.
+  struct Corridor
+  {
+    std::vector<Vertex> vertices;
+    /// @brief Distance from the first vertex to every vertex, walking forward.
+    std::vector<Distance> forwardDistances;
+    /// @brief Distance from every vertex to the first vertex, walking backward.
+    std::vector<Distance> backwardDistances;
+
+    Distance getDistance(size_t from, size_t to) const;
+    /// @brief Vertices passed walking from index `from` to index `to`, without the one at `from`.
+    void appendWalk(size_t from, size_t to, Path& path) const;
+  };
+
+  /// @brief Corridor a reduced graph edge was contracted from, `NoCorridor` for edges between adjacent junctions.
+  struct MacroEdge
+  {
+    uint32_t corridor;
+    bool isForward;
+  };
+
+  CompressedSparseRowGraph reducedGraph;
+  std::vector<Vertex> junctionVertices;
+  /// @brief Junction index of every original vertex, `NoCorridor` inside corridors.
+  std::vector<uint32_t> vertexJunctions;
+  /// @brief Corridor of every original vertex and its index in `Corridor::vertices`, `NoCorridor` for junctions.
+  std::vector<uint32_t> vertexCorridors;
+  std::vector<uint32_t> vertexIndicesInCorridor;
+  std::vector<Corridor> corridors;
+  std::vector<MacroEdge> macroEdges;
+};
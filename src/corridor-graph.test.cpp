@@ -0,0 +1,121 @@
+#include "corridor-graph.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "path-finding.h"
+
+namespace
+{
+/// Vertices along the x axis, connected in both directions by unit edges.
+CompressedSparseRowGraph createUndirectedGraph(
+    size_t numberOfVertices, const std::vector<std::pair<Vertex, Vertex>>& edges)
+{
+  WeightedDiGraph graph(numberOfVertices);
+  for (size_t vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    graph[vertex].position = {float(vertex), 0.0f};
+  }
+  for (const auto& [from, to] : edges)
+  {
+    add_edge(from, to, 1.0f, graph);
+    add_edge(to, from, 1.0f, graph);
+  }
+  return CompressedSparseRowGraph(graph);
+}
+
+void expectValidPath(const WeightedDiGraph& graph, const Path& path, Vertex start, Vertex target)
+{
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path.front(), start);
+  EXPECT_EQ(path.back(), target);
+  for (size_t index = 0; index + 1 < path.size(); ++index)
+  {
+    EXPECT_TRUE(boost::edge(path[index], path[index + 1], graph).second);
+  }
+}
+}  // namespace
+
+TEST(CorridorGraph, is_empty_by_default)
+{
+  CorridorGraph graph;
+  EXPECT_EQ(graph.getNumberOfVertices(), 0u);
+  EXPECT_EQ(graph.getNumberOfJunctions(), 0u);
+}
+
+TEST(CorridorGraph, contracts_chain_into_macro_edges)
+{
+  // 0 - 1 - 2 - 3 with the leaves 4 and 5 hanging off 3
+  const CorridorGraph graph(createUndirectedGraph(6, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {3, 5}}));
+
+  ASSERT_EQ(graph.getNumberOfJunctions(), 4u);
+  EXPECT_FALSE(graph.getJunction(1));
+  EXPECT_FALSE(graph.getJunction(2));
+  ASSERT_TRUE(graph.getJunction(3));
+  EXPECT_EQ(graph.getVertex(*graph.getJunction(3)), 3u);
+
+  const auto& reducedGraph = graph.getReducedGraph();
+  EXPECT_EQ(reducedGraph.getNumberOfEdges(), 6u);
+  std::vector<std::pair<Vertex, Distance>> outEdges;
+  for_each_out_edge(
+      reducedGraph,
+      *graph.getJunction(0),
+      [&outEdges](Vertex target, Distance weight) { outEdges.emplace_back(target, weight); });
+  EXPECT_EQ(outEdges, (std::vector<std::pair<Vertex, Distance>>{{*graph.getJunction(3), 3.0f}}));
+
+  const auto exits = graph.getExits(1);
+  ASSERT_EQ(exits.size(), 2u);
+  EXPECT_EQ(exits[0].distance + exits[1].distance, 3.0f);
+
+  EXPECT_EQ(dijkstra_shortest_path(graph, 4, 0), (Path{4, 3, 2, 1, 0}));
+  EXPECT_EQ(a_star_shortest_path(graph, 1, 5), (Path{1, 2, 3, 5}));
+  EXPECT_EQ(dijkstra_shortest_path(graph, 2, 1), (Path{2, 1}));
+  EXPECT_EQ(a_star_shortest_path(graph, 2, 2), (Path{2}));
+}
+
+TEST(CorridorGraph, promotes_one_vertex_of_a_cycle_without_junctions)
+{
+  const CorridorGraph graph(createUndirectedGraph(5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}}));
+
+  ASSERT_EQ(graph.getNumberOfJunctions(), 1u);
+  EXPECT_EQ(graph.getReducedGraph().getNumberOfEdges(), 0u);
+  EXPECT_EQ(dijkstra_shortest_path(graph, 1, 4), (Path{1, 0, 4}));
+  EXPECT_EQ(a_star_shortest_path(graph, 4, 2), (Path{4, 3, 2}));
+}
+
+TEST(CorridorGraph, finds_shortest_paths_of_the_original_graph)
+{
+  MapGraphLoader loader(
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/maze-128-128-1/maze-128-128-1.map")
+          .make_preferred()
+          .string());
+  const auto& originalGraph = *loader.getGraph();
+  const CorridorGraph graph(loader.getCompressedGraph());
+  EXPECT_LT(graph.getNumberOfJunctions(), graph.getNumberOfVertices() / 2);
+
+  // Query vertices of the component of vertex 0 only, the plain planners never return for unreachable targets
+  const std::vector<Vertex> predecessors = dijkstra_shortest_paths(originalGraph, 0);
+  std::vector<Vertex> reachable{0};
+  for (Vertex vertex = 1; vertex < predecessors.size(); ++vertex)
+  {
+    if (predecessors[vertex] != vertex) reachable.push_back(vertex);
+  }
+  const size_t count = reachable.size();
+  const std::vector<std::pair<Vertex, Vertex>> queries{
+      {reachable[0], reachable[count - 1]},
+      {reachable[count / 3], reachable[count / 2]},
+      {reachable[count / 5], reachable[count / 5 + 1]},
+      {reachable[count - 2], reachable[count / 4]},
+      {reachable[5], reachable[5]}};
+  for (const auto& [start, target] : queries)
+  {
+    const Distance expectedLength = path_length(originalGraph, dijkstra_shortest_path(originalGraph, start, target));
+    const Path dijkstraPath = dijkstra_shortest_path(graph, start, target);
+    const Path aStarPath = a_star_shortest_path(graph, start, target);
+    expectValidPath(originalGraph, dijkstraPath, start, target);
+    expectValidPath(originalGraph, aStarPath, start, target);
+    EXPECT_NEAR(path_length(originalGraph, dijkstraPath), expectedLength, 1E-03);
+    EXPECT_NEAR(path_length(originalGraph, aStarPath), expectedLength, 1E-03);
+  }
+}
@@ -0,0 +1,197 @@
+#include "csr-graph.h"
+
+#include <sstream>
+#include <stdexcept>
+
+struct CompressedSparseRowGraph::Arrays
+{
+  std::vector<EdgeIndex> offsets;
+  std::vector<VertexIndex> targets;
+  std::vector<Distance> weights;
+  Point2DArray positions;
+};
+
+CompressedSparseRowGraph::CompressedSparseRowGraph(std::shared_ptr<const Arrays> arrays)
+    : storage(arrays)
+    , numberOfVertices(arrays->positions.size())
+    , numberOfEdges(arrays->targets.size())
+    , offsets(arrays->offsets.data())
+    , targets(arrays->targets.data())
+    , weights(arrays->weights.data())
+    , x(arrays->positions.x.data())
+    , y(arrays->positions.y.data())
+{
+}
+
+CompressedSparseRowGraph::CompressedSparseRowGraph()
+    : CompressedSparseRowGraph(std::make_shared<const Arrays>(Arrays{{0}, {}, {}, {}}))
+{
+}
+
+std::shared_ptr<const CompressedSparseRowGraph::Arrays> CompressedSparseRowGraph::convert(const WeightedDiGraph& graph)
+{
+  auto arrays = std::make_shared<Arrays>();
+  const size_t numberOfVertices = boost::num_vertices(graph);
+  arrays->offsets.reserve(numberOfVertices + 1);
+  arrays->targets.reserve(boost::num_edges(graph));
+  arrays->weights.reserve(boost::num_edges(graph));
+  arrays->positions.reserve(numberOfVertices);
+
+  arrays->offsets.push_back(0);
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    for_each_out_edge(
+        graph,
+        vertex,
+        [&arrays](Vertex target, Distance weight)
+        {
+          arrays->targets.push_back(static_cast<VertexIndex>(target));
+          arrays->weights.push_back(weight);
+        });
+    arrays->offsets.push_back(static_cast<EdgeIndex>(arrays->targets.size()));
+    arrays->positions.push_back(graph[vertex].position);
+  }
+  return arrays;
+}
+
+CompressedSparseRowGraph::CompressedSparseRowGraph(const WeightedDiGraph& graph)
+    : CompressedSparseRowGraph(convert(graph))
+{
+}
+
+CompressedSparseRowGraph::CompressedSparseRowGraph(
+    std::vector<EdgeIndex> offsets,
+    std::vector<VertexIndex> targets,
+    std::vector<Distance> weights,
+    Point2DArray positions)
+    : CompressedSparseRowGraph(std::make_shared<const Arrays>(
+          Arrays{std::move(offsets), std::move(targets), std::move(weights), std::move(positions)}))
+{
+  const auto& arrays = *std::static_pointer_cast<const Arrays>(storage);
+  if (arrays.offsets.empty() || arrays.offsets.size() != arrays.positions.size() + 1
+      || arrays.positions.x.size() != arrays.positions.y.size() || arrays.offsets.back() != arrays.targets.size()
+      || arrays.targets.size() != arrays.weights.size())
+  {
+    std::ostringstream message;
+    message << "Inconsistent compressed sparse row graph: " << arrays.offsets.size() << " offsets, "
+            << arrays.positions.size() << " positions, " << arrays.targets.size() << " targets and "
+            << arrays.weights.size() << " weights.";
+    throw std::invalid_argument(message.str());
+  }
+}
+
+CompressedSparseRowGraph::CompressedSparseRowGraph(
+    std::shared_ptr<const void> storage,
+    size_t numberOfVertices,
+    size_t numberOfEdges,
+    const EdgeIndex* offsets,
+    const VertexIndex* targets,
+    const Distance* weights,
+    const float* x,
+    const float* y)
+    : storage(std::move(storage))
+    , numberOfVertices(numberOfVertices)
+    , numberOfEdges(numberOfEdges)
+    , offsets(offsets)
+    , targets(targets)
+    , weights(weights)
+    , x(x)
+    , y(y)
+{
+  if (offsets[0] != 0 || offsets[numberOfVertices] != numberOfEdges)
+  {
+    std::ostringstream message;
+    message << "Inconsistent compressed sparse row graph: offsets span [" << offsets[0] << ", "
+            << offsets[numberOfVertices] << "), but there are " << numberOfEdges << " edges.";
+    throw std::invalid_argument(message.str());
+  }
+}
+
+size_t CompressedSparseRowGraph::getNumberOfVertices() const
+{
+  return numberOfVertices;
+}
+
+size_t CompressedSparseRowGraph::getNumberOfEdges() const
+{
+  return numberOfEdges;
+}
+
+Point2D CompressedSparseRowGraph::getPosition(Vertex vertex) const
+{
+  return {x[vertex], y[vertex]};
+}
+
+const CompressedSparseRowGraph::EdgeIndex* CompressedSparseRowGraph::getOffsets() const
+{
+  return offsets;
+}
+
+const CompressedSparseRowGraph::VertexIndex* CompressedSparseRowGraph::getTargets() const
+{
+  return targets;
+}
+
+const Distance* CompressedSparseRowGraph::getWeights() const
+{
+  return weights;
+}
+
+const float* CompressedSparseRowGraph::getX() const
+{
+  return x;
+}
+
+const float* CompressedSparseRowGraph::getY() const
+{
+  return y;
+}
+
+size_t num_vertices(const CompressedSparseRowGraph& graph)
+{
+  return graph.getNumberOfVertices();
+}
+
+Point2D vertex_position(const CompressedSparseRowGraph& graph, Vertex vertex)
+{
+  return graph.getPosition(vertex);
+}
+
+CompressedSparseRowGraph reverse_graph(const CompressedSparseRowGraph& graph)
+{
+  typedef CompressedSparseRowGraph::EdgeIndex EdgeIndex;
+  typedef CompressedSparseRowGraph::VertexIndex VertexIndex;
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  const EdgeIndex* offsets = graph.getOffsets();
+  const VertexIndex* targets = graph.getTargets();
+  const Distance* weights = graph.getWeights();
+
+  // Counting sort of the edges by target
+  std::vector<EdgeIndex> reverseOffsets(numberOfVertices + 1, 0);
+  for (size_t edge = 0; edge < graph.getNumberOfEdges(); ++edge)
+  {
+    ++reverseOffsets[targets[edge] + 1];
+  }
+  for (size_t vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    reverseOffsets[vertex + 1] += reverseOffsets[vertex];
+  }
+  std::vector<VertexIndex> reverseTargets(graph.getNumberOfEdges());
+  std::vector<Distance> reverseWeights(graph.getNumberOfEdges());
+  std::vector<EdgeIndex> nextEdges(reverseOffsets.begin(), reverseOffsets.end() - 1);
+  for (size_t vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    for (EdgeIndex edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge)
+    {
+      const EdgeIndex position = nextEdges[targets[edge]]++;
+      reverseTargets[position] = static_cast<VertexIndex>(vertex);
+      reverseWeights[position] = weights[edge];
+    }
+  }
+
+  Point2DArray positions;
+  positions.x.assign(graph.getX(), graph.getX() + numberOfVertices);
+  positions.y.assign(graph.getY(), graph.getY() + numberOfVertices);
+  return CompressedSparseRowGraph(
+      std::move(reverseOffsets), std::move(reverseTargets), std::move(reverseWeights), std::move(positions));
+}
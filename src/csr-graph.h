@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "geometry.h"
+#include "graph.h"
+
+/// @brief Immutable directed graph in compressed sparse row layout.
+///
+/// Out-edges of vertex `v` are the contiguous range `[offsets[v], offsets[v + 1])` of the `targets` and `weights`
+/// arrays, so expanding a vertex is a linear scan instead of chasing the list nodes of `WeightedDiGraph`.
+///
+/// The arrays are either owned by the graph (shared between its copies, as they never change) or a view into memory
+/// kept alive by the graph, such as a memory-mapped `GraphCache`.
+class CompressedSparseRowGraph
+{
+ public:
+  typedef uint32_t VertexIndex;
+  typedef uint32_t EdgeIndex;
+
+  CompressedSparseRowGraph();
+  explicit CompressedSparseRowGraph(const WeightedDiGraph& graph);
+  CompressedSparseRowGraph(
+      std::vector<EdgeIndex> offsets,
+      std::vector<VertexIndex> targets,
+      std::vector<Distance> weights,
+      Point2DArray positions);
+  /// @brief View over arrays of `numberOfVertices + 1` offsets, `numberOfEdges` targets and weights and
+  /// `numberOfVertices` x and y coordinates, which stay valid as long as `storage` is alive.
+  CompressedSparseRowGraph(
+      std::shared_ptr<const void> storage,
+      size_t numberOfVertices,
+      size_t numberOfEdges,
+      const EdgeIndex* offsets,
+      const VertexIndex* targets,
+      const Distance* weights,
+      const float* x,
+      const float* y);
+
+  size_t getNumberOfVertices() const;
+  size_t getNumberOfEdges() const;
+  Point2D getPosition(Vertex vertex) const;
+
+  const EdgeIndex* getOffsets() const;
+  const VertexIndex* getTargets() const;
+  const Distance* getWeights() const;
+  const float* getX() const;
+  const float* getY() const;
+
+  template <typename Visitor>
+  void forEachOutEdge(Vertex vertex, Visitor&& visitor) const
+  {
+    const EdgeIndex end = offsets[vertex + 1];
+    for (EdgeIndex edge = offsets[vertex]; edge < end; ++edge)
+    {
+      visitor(static_cast<Vertex>(targets[edge]), weights[edge]);
+    }
+  }
+
+ private:
+  struct Arrays;
+
+  explicit CompressedSparseRowGraph(std::shared_ptr<const Arrays> arrays);
+  static std::shared_ptr<const Arrays> convert(const WeightedDiGraph& graph);
+
+  std::shared_ptr<const void> storage;
+  size_t numberOfVertices;
+  size_t numberOfEdges;
+  const EdgeIndex* offsets;
+  const VertexIndex* targets;
+  const Distance* weights;
+  const float* x;
+  const float* y;
+};
+
+size_t num_vertices(const CompressedSparseRowGraph& graph);
+Point2D vertex_position(const CompressedSparseRowGraph& graph, Vertex vertex);
+/// @brief Graph with the same vertices and every edge turned around, whose out-edges are the in-edges of `graph`.
+CompressedSparseRowGraph reverse_graph(const CompressedSparseRowGraph& graph);
+
+template <typename Visitor>
+void for_each_out_edge(const CompressedSparseRowGraph& graph, Vertex vertex, Visitor&& visitor)
+{
+  graph.forEachOutEdge(vertex, std::forward<Visitor>(visitor));
+}
@@ -0,0 +1,85 @@
+#include "csr-graph.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+TEST(CompressedSparseRowGraph, is_empty_by_default)
+{
+  CompressedSparseRowGraph graph;
+  EXPECT_EQ(graph.getNumberOfVertices(), 0u);
+  EXPECT_EQ(graph.getNumberOfEdges(), 0u);
+}
+
+TEST(CompressedSparseRowGraph, converts_adjacency_list_graph)
+{
+  DefaultGraphLoader loader;
+  const auto adjacencyListGraph = *loader.getGraph();
+  const CompressedSparseRowGraph graph(adjacencyListGraph);
+
+  ASSERT_EQ(graph.getNumberOfVertices(), 4u);
+  ASSERT_EQ(graph.getNumberOfEdges(), 5u);
+  for (Vertex vertex = 0; vertex < 4; ++vertex)
+  {
+    EXPECT_EQ(graph.getPosition(vertex), adjacencyListGraph[vertex].position);
+  }
+
+  std::vector<std::pair<Vertex, Distance>> outEdges;
+  for_each_out_edge(graph, 0, [&outEdges](Vertex target, Distance weight) { outEdges.emplace_back(target, weight); });
+  EXPECT_EQ(outEdges, (std::vector<std::pair<Vertex, Distance>>{{1, 2.0f}, {2, 3.0f}, {3, 1.0f}}));
+
+  outEdges.clear();
+  for_each_out_edge(graph, 2, [&outEdges](Vertex target, Distance weight) { outEdges.emplace_back(target, weight); });
+  EXPECT_TRUE(outEdges.empty());
+}
+
+TEST(CompressedSparseRowGraph, reverses_edges)
+{
+  DefaultGraphLoader loader;
+  const CompressedSparseRowGraph graph(*loader.getGraph());
+  const CompressedSparseRowGraph reverse = reverse_graph(graph);
+
+  ASSERT_EQ(reverse.getNumberOfVertices(), 4u);
+  ASSERT_EQ(reverse.getNumberOfEdges(), 5u);
+  EXPECT_EQ(reverse.getPosition(3), graph.getPosition(3));
+  std::vector<std::pair<Vertex, Distance>> inEdges;
+  for_each_out_edge(reverse, 2, [&inEdges](Vertex source, Distance weight) { inEdges.emplace_back(source, weight); });
+  EXPECT_EQ(inEdges, (std::vector<std::pair<Vertex, Distance>>{{0, 3.0f}, {1, 1.0f}, {3, 1.0f}}));
+  inEdges.clear();
+  for_each_out_edge(reverse, 0, [&inEdges](Vertex source, Distance weight) { inEdges.emplace_back(source, weight); });
+  EXPECT_TRUE(inEdges.empty());
+}
+
+TEST(CompressedSparseRowGraph, throws_exception_on_inconsistent_arrays)
+{
+  EXPECT_THROW(CompressedSparseRowGraph({0, 1}, {1, 0}, {1.0f, 1.0f}, {{0}, {0}}), std::invalid_argument);
+  EXPECT_THROW(CompressedSparseRowGraph({0, 2}, {1, 0}, {1.0f}, {{0}, {0}}), std::invalid_argument);
+  EXPECT_THROW(CompressedSparseRowGraph({0, 2}, {1, 0}, {1.0f, 1.0f}, {{0}, {}}), std::invalid_argument);
+}
+
+TEST(CompressedSparseRowGraph, is_built_by_map_graph_loader)
+{
+  MapGraphLoader loader(
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/maze-32-32-2/maze-32-32-2.map")
+          .make_preferred()
+          .string());
+  const auto& adjacencyListGraph = *loader.getGraph();
+  const auto graph = loader.getCompressedGraph();
+
+  ASSERT_EQ(graph.getNumberOfVertices(), boost::num_vertices(adjacencyListGraph));
+  ASSERT_EQ(graph.getNumberOfEdges(), boost::num_edges(adjacencyListGraph));
+  for (Vertex vertex = 0; vertex < graph.getNumberOfVertices(); ++vertex)
+  {
+    EXPECT_EQ(graph.getPosition(vertex), adjacencyListGraph[vertex].position);
+
+    std::vector<std::pair<Vertex, Distance>> expectedOutEdges;
+    for_each_out_edge(
+        adjacencyListGraph,
+        vertex,
+        [&expectedOutEdges](Vertex target, Distance weight) { expectedOutEdges.emplace_back(target, weight); });
+    std::vector<std::pair<Vertex, Distance>> outEdges;
+    for_each_out_edge(
+        graph, vertex, [&outEdges](Vertex target, Distance weight) { outEdges.emplace_back(target, weight); });
+    EXPECT_EQ(outEdges, expectedOutEdges) << "vertex " << vertex;
+  }
+}
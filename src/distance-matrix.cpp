@@ -0,0 +1,156 @@
+#include "distance-matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "best-first-search.h"
+
+namespace
+{
+// Fills `distances` with the distance from `source` to each of `targets`
+template <typename Graph>
+void search_distances(
+    const Graph& graph,
+    Vertex source,
+    const std::vector<Vertex>& targets,
+    SearchContext& context,
+    Distance* distances)
+{
+  TargetSetSearchSpace<Graph> space(graph, source, targets, context);
+  BinaryHeapOpenList<Vertex> openList;
+  ZeroHeuristic heuristic;
+  NullSearchVisitor visitor;
+  best_first_search(space, source, heuristic, openList, visitor);
+  for (size_t index = 0; index < targets.size(); ++index)
+  {
+    distances[index] = context.getDistance(targets[index]);
+  }
+}
+
+template <typename Graph>
+std::vector<Distance> one_to_many_search(
+    const Graph& graph, Vertex source, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  std::vector<Distance> distances(targets.size());
+  search_distances(graph, source, targets, context, distances.data());
+  return distances;
+}
+}  // namespace
+
+DistanceMatrix::DistanceMatrix(size_t numberOfSources, size_t numberOfTargets)
+    : numberOfSources(numberOfSources)
+    , numberOfTargets(numberOfTargets)
+    , distances(numberOfSources * numberOfTargets)
+{
+}
+
+size_t DistanceMatrix::getNumberOfSources() const
+{
+  return numberOfSources;
+}
+
+size_t DistanceMatrix::getNumberOfTargets() const
+{
+  return numberOfTargets;
+}
+
+const Distance* DistanceMatrix::getRow(size_t sourceIndex) const
+{
+  return distances.data() + sourceIndex * numberOfTargets;
+}
+
+Distance* DistanceMatrix::getRow(size_t sourceIndex)
+{
+  return distances.data() + sourceIndex * numberOfTargets;
+}
+
+std::vector<Distance> one_to_many_distances(
+    const WeightedDiGraph& graph, Vertex source, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return one_to_many_search(graph, source, targets, context);
+}
+
+std::vector<Distance> one_to_many_distances(
+    const CompressedSparseRowGraph& graph, Vertex source, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return one_to_many_search(graph, source, targets, context);
+}
+
+std::vector<Distance> one_to_many_distances(
+    const GridGraph& graph, Vertex source, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return one_to_many_search(graph, source, targets, context);
+}
+
+DistanceMatrixCalculator::DistanceMatrixCalculator(unsigned numberOfThreads)
+    : contexts(numberOfThreads > 0 ? numberOfThreads : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+unsigned DistanceMatrixCalculator::getNumberOfThreads() const
+{
+  return static_cast<unsigned>(contexts.size());
+}
+
+template <typename Graph>
+DistanceMatrix DistanceMatrixCalculator::calculateMatrix(
+    const Graph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets)
+{
+  DistanceMatrix matrix(sources.size(), targets.size());
+  // Workers take the next source left, so that sources with far targets don't hold up the others
+  std::atomic<size_t> nextSource = 0;
+  auto work = [&](SearchContext& context)
+  {
+    for (size_t index = nextSource++; index < sources.size(); index = nextSource++)
+    {
+      search_distances(graph, sources[index], targets, context, matrix.getRow(index));
+    }
+  };
+
+  const size_t numberOfWorkers = std::min(contexts.size(), sources.size());
+  if (numberOfWorkers <= 1)
+  {
+    work(contexts.front());
+    return matrix;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(numberOfWorkers - 1);
+  for (size_t worker = 1; worker < numberOfWorkers; ++worker)
+  {
+    workers.emplace_back(work, std::ref(contexts[worker]));
+  }
+  // The calling thread works as well, with the first context
+  work(contexts.front());
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+  return matrix;
+}
+
+DistanceMatrix DistanceMatrixCalculator::calculate(
+    const WeightedDiGraph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets)
+{
+  return calculateMatrix(graph, sources, targets);
+}
+
+DistanceMatrix DistanceMatrixCalculator::calculate(
+    const CompressedSparseRowGraph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets)
+{
+  return calculateMatrix(graph, sources, targets);
+}
+
+DistanceMatrix DistanceMatrixCalculator::calculate(
+    const GridGraph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets)
+{
+  return calculateMatrix(graph, sources, targets);
+}
+
+DistanceMatrix many_to_many_distances(
+    const CompressedSparseRowGraph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets)
+{
+  DistanceMatrixCalculator calculator;
+  return calculator.calculate(graph, sources, targets);
+}
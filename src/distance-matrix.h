@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "csr-graph.h"
+#include "graph.h"
+#include "grid-graph.h"
+#include "search-context.h"
+
+/// @brief Distances from each of a set of sources (rows) to each of a set of targets (columns), stored row by row.
+/// Unreachable targets are at the maximum distance, like the unreached vertices of a `SearchContext`.
+class DistanceMatrix
+{
+ public:
+  DistanceMatrix(size_t numberOfSources, size_t numberOfTargets);
+
+  size_t getNumberOfSources() const;
+  size_t getNumberOfTargets() const;
+
+  /// @brief Distance from the source at `sourceIndex` to the target at `targetIndex`, both indices into the vertex sets
+  /// the matrix was calculated for.
+  Distance getDistance(size_t sourceIndex, size_t targetIndex) const
+  {
+    return distances[sourceIndex * numberOfTargets + targetIndex];
+  }
+
+  const Distance* getRow(size_t sourceIndex) const;
+  Distance* getRow(size_t sourceIndex);
+
+ private:
+  size_t numberOfSources;
+  size_t numberOfTargets;
+  std::vector<Distance> distances;
+};
+
+/// @brief Distances from `source` to each of `targets`, from one Dijkstra search that stops once the last target is
+/// settled.
+std::vector<Distance> one_to_many_distances(
+    const WeightedDiGraph& graph,
+    Vertex source,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+std::vector<Distance> one_to_many_distances(
+    const CompressedSparseRowGraph& graph,
+    Vertex source,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+std::vector<Distance> one_to_many_distances(
+    const GridGraph& graph,
+    Vertex source,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+
+/// @brief Many-to-many distances, one search per source as in `one_to_many_distances`, spread over worker threads.
+///
+/// Every worker keeps its `SearchContext` in the calculator, so that calculating a matrix every tick (e.g. the costs
+/// of assigning runners to jobs) doesn't allocate the per-vertex arrays again. A calculator serves one matrix at a
+/// time.
+class DistanceMatrixCalculator
+{
+ public:
+  /// @param numberOfThreads Worker threads, the number of hardware threads if 0.
+  explicit DistanceMatrixCalculator(unsigned numberOfThreads = 0);
+
+  unsigned getNumberOfThreads() const;
+
+  DistanceMatrix calculate(
+      const WeightedDiGraph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets);
+  DistanceMatrix calculate(
+      const CompressedSparseRowGraph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets);
+  DistanceMatrix calculate(
+      const GridGraph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets);
+
+ private:
+  template <typename Graph>
+  DistanceMatrix calculateMatrix(
+      const Graph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets);
+
+  std::vector<SearchContext> contexts;
+};
+
+/// @brief Many-to-many distances with a calculator of its own, using every hardware thread.
+DistanceMatrix many_to_many_distances(
+    const CompressedSparseRowGraph& graph, const std::vector<Vertex>& sources, const std::vector<Vertex>& targets);
@@ -0,0 +1,74 @@
+#include "distance-matrix.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "path-finding.h"
+#include "test-data.h"
+
+TEST(DistanceMatrix, one_to_many_distances_on_directed_graph)
+{
+  const auto graph = DefaultGraphLoader().getGraph();
+  EXPECT_EQ(one_to_many_distances(*graph, 0, {2, 3, 0, 1, 2}), (std::vector<Distance>{2.0f, 1.0f, 0.0f, 2.0f, 2.0f}));
+  const Distance unreachable = std::numeric_limits<Distance>::max();
+  EXPECT_EQ(one_to_many_distances(*graph, 2, {0, 2}), (std::vector<Distance>{unreachable, 0.0f}));
+  EXPECT_TRUE(one_to_many_distances(*graph, 1, {}).empty());
+}
+
+TEST(DistanceMatrix, one_to_many_search_stops_at_the_last_target)
+{
+  MapGraphLoader loader(getMapFilename("maze-128-128-1"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const Path path = dijkstra_shortest_path(graph, 0, 400);
+  SearchContext context;
+
+  const std::vector<Distance> distances = one_to_many_distances(graph, 0, {path[10], path[5]}, context);
+  EXPECT_EQ(distances, (std::vector<Distance>{10.0f, 5.0f}));
+  size_t expandedVertices = 0;
+  for (Vertex vertex = 0; vertex < graph.getNumberOfVertices(); ++vertex)
+  {
+    if (context.isExpanded(vertex)) ++expandedVertices;
+  }
+  EXPECT_LT(expandedVertices, graph.getNumberOfVertices() / 10);
+}
+
+TEST(DistanceMatrix, many_to_many_distances_match_single_source_searches)
+{
+  MapGraphLoader loader(getMapFilename("warehouse-10-20-10-2-1"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+  std::vector<Vertex> sources;
+  for (Vertex source = 0; source < numberOfVertices; source += numberOfVertices / 23 + 1)
+  {
+    sources.push_back(source);
+  }
+  // Repeated targets get a column each
+  std::vector<Vertex> targets{numberOfVertices - 1, 7, numberOfVertices / 2, 7};
+
+  DistanceMatrixCalculator calculator(4);
+  EXPECT_EQ(calculator.getNumberOfThreads(), 4u);
+  for (int tick = 0; tick < 2; ++tick)
+  {
+    const DistanceMatrix matrix = calculator.calculate(graph, sources, targets);
+    ASSERT_EQ(matrix.getNumberOfSources(), sources.size());
+    ASSERT_EQ(matrix.getNumberOfTargets(), targets.size());
+    SearchContext context;
+    for (size_t row = 0; row < sources.size(); ++row)
+    {
+      dijkstra_shortest_paths(graph, sources[row], context);
+      for (size_t column = 0; column < targets.size(); ++column)
+      {
+        EXPECT_EQ(matrix.getDistance(row, column), context.getDistance(targets[column])) << row << ", " << column;
+      }
+    }
+  }
+
+  const DistanceMatrix matrix = many_to_many_distances(graph, sources, targets);
+  const DistanceMatrix singleThreaded = DistanceMatrixCalculator(1).calculate(*loader.getGraph(), sources, targets);
+  for (size_t row = 0; row < sources.size(); ++row)
+  {
+    EXPECT_TRUE(std::equal(matrix.getRow(row), matrix.getRow(row) + targets.size(), singleThreaded.getRow(row)));
+  }
+  EXPECT_EQ(calculator.calculate(graph, {}, targets).getNumberOfSources(), 0u);
+}
@@ -0,0 +1,353 @@
+#include "edge-list-loader.h"
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "mapped-file.h"
+#include "strings.h"
+
+EdgeListGraphLoader::EdgeListGraphLoader(const std::string& filename) : filename(filename)
+{
+}
+
+SharedGraph EdgeListGraphLoader::getGraph() const
+{
+  auto graph = std::make_shared<WeightedDiGraph>(getNumberOfVertices());
+  for (size_t vertex = 0; vertex < getNumberOfVertices(); ++vertex)
+  {
+    (*graph)[vertex].position = positions[vertex];
+  }
+  for (size_t edge = 0; edge < getNumberOfEdges(); ++edge)
+  {
+    add_edge(sources[edge], targets[edge], weights[edge], *graph);
+  }
+  return graph;
+}
+
+CompressedSparseRowGraph EdgeListGraphLoader::getCompressedGraph() const
+{
+  // Counting sort of the edges by their source, stable to keep the file order of the out-edges of every vertex
+  std::vector<CompressedSparseRowGraph::EdgeIndex> offsets(getNumberOfVertices() + 1, 0);
+  for (const uint32_t source : sources)
+  {
+    ++offsets[source + 1];
+  }
+  for (size_t vertex = 0; vertex < getNumberOfVertices(); ++vertex)
+  {
+    offsets[vertex + 1] += offsets[vertex];
+  }
+  std::vector<CompressedSparseRowGraph::VertexIndex> sortedTargets(getNumberOfEdges());
+  std::vector<Distance> sortedWeights(getNumberOfEdges());
+  std::vector<CompressedSparseRowGraph::EdgeIndex> insertPositions(offsets.begin(), offsets.end() - 1);
+  for (size_t edge = 0; edge < getNumberOfEdges(); ++edge)
+  {
+    const CompressedSparseRowGraph::EdgeIndex position = insertPositions[sources[edge]]++;
+    sortedTargets[position] = targets[edge];
+    sortedWeights[position] = weights[edge];
+  }
+  return CompressedSparseRowGraph(std::move(offsets), std::move(sortedTargets), std::move(sortedWeights), positions);
+}
+
+const std::string& EdgeListGraphLoader::getFilename() const
+{
+  return filename;
+}
+
+size_t EdgeListGraphLoader::getNumberOfVertices() const
+{
+  return positions.size();
+}
+
+size_t EdgeListGraphLoader::getNumberOfEdges() const
+{
+  return sources.size();
+}
+
+void EdgeListGraphLoader::validate() const
+{
+  if (getNumberOfEdges() > std::numeric_limits<CompressedSparseRowGraph::EdgeIndex>::max())
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << filename << "': " << getNumberOfEdges() << " edges are more than supported";
+    throw std::invalid_argument(message.str());
+  }
+  for (size_t edge = 0; edge < getNumberOfEdges(); ++edge)
+  {
+    if (sources[edge] >= getNumberOfVertices() || targets[edge] >= getNumberOfVertices() || !(weights[edge] >= 0.0f))
+    {
+      std::ostringstream message;
+      message << "Failed to open '" << filename << "': invalid edge " << edge << " from " << sources[edge] << " to "
+              << targets[edge] << " with weight " << weights[edge] << " in a graph of " << getNumberOfVertices()
+              << " vertices";
+      throw std::invalid_argument(message.str());
+    }
+  }
+}
+
+namespace
+{
+// Parses the next field of a DIMACS line as a number
+template <typename Number>
+Number readNumber(std::string_view& line, const std::string& filename, size_t lineNumber)
+{
+  const std::string_view field = nextField(line);
+  Number value = 0;
+  const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  if (error != std::errc() || end != field.data() + field.size() || field.empty())
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << filename << "': invalid format. Expected a number on line " << lineNumber
+            << ", got '" << field << "'";
+    throw std::invalid_argument(message.str());
+  }
+  return value;
+}
+
+// Converts a vertex number of a DIMACS file, counted from 1, to a vertex of the graph
+uint32_t readDimacsVertex(std::string_view& line, const std::string& filename, size_t lineNumber)
+{
+  const auto vertex = readNumber<uint32_t>(line, filename, lineNumber);
+  if (vertex == 0)
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << filename << "': invalid vertex 0 on line " << lineNumber;
+    throw std::invalid_argument(message.str());
+  }
+  return vertex - 1;
+}
+
+// Checks the leading fields of the problem line of a DIMACS file after its `p`, leaving the numbers in `line`
+void readDimacsProblem(
+    std::string_view& line,
+    std::initializer_list<std::string_view> expectedFields,
+    const std::string& filename,
+    size_t lineNumber)
+{
+  for (const std::string_view expectedField : expectedFields)
+  {
+    const std::string_view field = nextField(line);
+    if (field != expectedField)
+    {
+      std::ostringstream message;
+      message << "Failed to open '" << filename << "': invalid format. Expected '" << expectedField << "' on line "
+              << lineNumber << ", got '" << field << "'";
+      throw std::invalid_argument(message.str());
+    }
+  }
+}
+
+struct EdgeListHeader
+{
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t numberOfVertices;
+  uint64_t numberOfEdges;
+};
+
+constexpr std::array<char, 8> EdgeListMagic{'P', 'F', 'E', 'D', 'G', 'E', 'S', '\0'};
+}  // namespace
+
+DimacsGraphLoader::DimacsGraphLoader(const std::string& filename, const std::string& coordinatesFilename)
+    : EdgeListGraphLoader(filename)
+{
+  readArcs();
+  if (!coordinatesFilename.empty())
+  {
+    readCoordinates(coordinatesFilename);
+  }
+  validate();
+}
+
+void DimacsGraphLoader::readArcs()
+{
+  const MappedFile file(filename);
+  const std::string_view buffer(file.data(), file.size());
+  size_t position = 0;
+  size_t lineNumber = 0;
+  bool hasProblem = false;
+  while (position < buffer.size())
+  {
+    std::string_view line = getLine(buffer, position);
+    ++lineNumber;
+    const std::string_view type = nextField(line);
+    if (type.empty() || type == "c") continue;
+
+    if (type == "p" && !hasProblem)
+    {
+      readDimacsProblem(line, {"sp"}, filename, lineNumber);
+      const auto numberOfVertices = readNumber<uint32_t>(line, filename, lineNumber);
+      const auto numberOfArcs = readNumber<size_t>(line, filename, lineNumber);
+      positions.x.assign(numberOfVertices, 0.0f);
+      positions.y.assign(numberOfVertices, 0.0f);
+      sources.reserve(numberOfArcs);
+      targets.reserve(numberOfArcs);
+      weights.reserve(numberOfArcs);
+      hasProblem = true;
+    }
+    else if (type == "a" && hasProblem)
+    {
+      sources.push_back(readDimacsVertex(line, filename, lineNumber));
+      targets.push_back(readDimacsVertex(line, filename, lineNumber));
+      // Arc weights are non-negative integers in DIMACS files
+      weights.push_back(static_cast<Distance>(readNumber<uint32_t>(line, filename, lineNumber)));
+    }
+    else
+    {
+      std::ostringstream message;
+      message << "Failed to open '" << filename << "': invalid format. Unexpected line " << lineNumber << " of type '"
+              << type << "'";
+      throw std::invalid_argument(message.str());
+    }
+  }
+  if (!hasProblem)
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << filename << "': invalid format. Missing problem line 'p sp'";
+    throw std::invalid_argument(message.str());
+  }
+}
+
+void DimacsGraphLoader::readCoordinates(const std::string& coordinatesFilename)
+{
+  const MappedFile file(coordinatesFilename);
+  const std::string_view buffer(file.data(), file.size());
+  size_t position = 0;
+  size_t lineNumber = 0;
+  while (position < buffer.size())
+  {
+    std::string_view line = getLine(buffer, position);
+    ++lineNumber;
+    const std::string_view type = nextField(line);
+    if (type.empty() || type == "c") continue;
+
+    if (type == "p")
+    {
+      readDimacsProblem(line, {"aux", "sp", "co"}, coordinatesFilename, lineNumber);
+      const auto numberOfVertices = readNumber<size_t>(line, coordinatesFilename, lineNumber);
+      if (numberOfVertices != getNumberOfVertices())
+      {
+        std::ostringstream message;
+        message << "Failed to open '" << coordinatesFilename << "': coordinates of " << numberOfVertices
+                << " vertices given for a graph of " << getNumberOfVertices() << " vertices";
+        throw std::invalid_argument(message.str());
+      }
+    }
+    else if (type == "v")
+    {
+      const uint32_t vertex = readDimacsVertex(line, coordinatesFilename, lineNumber);
+      if (vertex >= getNumberOfVertices())
+      {
+        std::ostringstream message;
+        message << "Failed to open '" << coordinatesFilename << "': invalid vertex " << vertex + 1 << " on line "
+                << lineNumber;
+        throw std::invalid_argument(message.str());
+      }
+      positions.x[vertex] = static_cast<float>(readNumber<int64_t>(line, coordinatesFilename, lineNumber));
+      positions.y[vertex] = static_cast<float>(readNumber<int64_t>(line, coordinatesFilename, lineNumber));
+    }
+    else
+    {
+      std::ostringstream message;
+      message << "Failed to open '" << coordinatesFilename << "': invalid format. Unexpected line " << lineNumber
+              << " of type '" << type << "'";
+      throw std::invalid_argument(message.str());
+    }
+  }
+}
+
+BinaryEdgeListGraphLoader::BinaryEdgeListGraphLoader(const std::string& filename) : EdgeListGraphLoader(filename)
+{
+  auto invalid = [&filename](const std::string& reason)
+  {
+    std::ostringstream message;
+    message << "Failed to load binary edge list '" << filename << "': " << reason;
+    return std::runtime_error(message.str());
+  };
+
+  const MappedFile file(filename);
+  EdgeListHeader header;
+  if (file.size() < sizeof(EdgeListHeader))
+  {
+    throw invalid("file is too short");
+  }
+  std::memcpy(&header, file.data(), sizeof(EdgeListHeader));
+  if (header.magic != EdgeListMagic)
+  {
+    throw invalid("not a binary edge list");
+  }
+  if (header.version != Version)
+  {
+    std::ostringstream reason;
+    reason << "version " << header.version << " is not supported, expected " << Version;
+    throw invalid(reason.str());
+  }
+  const uint64_t vertexBytes = header.numberOfVertices * 2 * sizeof(float);
+  const uint64_t edgeBytes = header.numberOfEdges * (2 * sizeof(uint32_t) + sizeof(Distance));
+  if (header.numberOfVertices > std::numeric_limits<uint32_t>::max()
+      || header.numberOfEdges > std::numeric_limits<uint32_t>::max()
+      || file.size() != sizeof(EdgeListHeader) + vertexBytes + edgeBytes)
+  {
+    throw invalid("file size does not match the number of vertices and edges");
+  }
+
+  const auto numberOfVertices = static_cast<size_t>(header.numberOfVertices);
+  const auto numberOfEdges = static_cast<size_t>(header.numberOfEdges);
+  const char* data = file.data() + sizeof(EdgeListHeader);
+  auto read = [&data](auto& values, size_t count)
+  {
+    values.resize(count);
+    std::memcpy(values.data(), data, count * sizeof(values[0]));
+    data += count * sizeof(values[0]);
+  };
+  read(positions.x, numberOfVertices);
+  read(positions.y, numberOfVertices);
+  read(sources, numberOfEdges);
+  read(targets, numberOfEdges);
+  read(weights, numberOfEdges);
+  validate();
+}
+
+void BinaryEdgeListGraphLoader::write(const std::string& filename, const CompressedSparseRowGraph& graph)
+{
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  const size_t numberOfEdges = graph.getNumberOfEdges();
+  std::vector<uint32_t> sources(numberOfEdges);
+  for (size_t vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    for (auto edge = graph.getOffsets()[vertex]; edge < graph.getOffsets()[vertex + 1]; ++edge)
+    {
+      sources[edge] = static_cast<uint32_t>(vertex);
+    }
+  }
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    std::ostringstream message;
+    message << "Failed to write binary edge list '" << filename << "' from " << std::filesystem::current_path();
+    throw std::runtime_error(message.str());
+  }
+  auto write = [&file](const void* data, size_t size)
+  { file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size)); };
+  const EdgeListHeader header{EdgeListMagic, Version, 0, numberOfVertices, numberOfEdges};
+  write(&header, sizeof(EdgeListHeader));
+  write(graph.getX(), numberOfVertices * sizeof(float));
+  write(graph.getY(), numberOfVertices * sizeof(float));
+  write(sources.data(), numberOfEdges * sizeof(uint32_t));
+  write(graph.getTargets(), numberOfEdges * sizeof(CompressedSparseRowGraph::VertexIndex));
+  write(graph.getWeights(), numberOfEdges * sizeof(Distance));
+  if (!file)
+  {
+    std::ostringstream message;
+    message << "Failed to write binary edge list '" << filename << "'";
+    throw std::runtime_error(message.str());
+  }
+}
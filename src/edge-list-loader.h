@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "csr-graph.h"
+#include "geometry.h"
+#include "graph.h"
+
+/// @brief Loads a graph given as a list of directed, weighted edges, e.g. a road network, instead of a grid map.
+///
+/// The edges are kept in file order, so the out-edges of every vertex come in the same order in `getGraph` and
+/// `getCompressedGraph`. For graphs of millions of vertices, prefer `getCompressedGraph`, which builds the arrays
+/// directly instead of a node per vertex and edge.
+class EdgeListGraphLoader : public GraphLoader
+{
+ public:
+  virtual ~EdgeListGraphLoader() = default;
+
+  /// @brief Builds a new adjacency list graph on every call.
+  SharedGraph getGraph() const override;
+  CompressedSparseRowGraph getCompressedGraph() const;
+  const std::string& getFilename() const;
+  size_t getNumberOfVertices() const;
+  size_t getNumberOfEdges() const;
+
+ protected:
+  explicit EdgeListGraphLoader(const std::string& filename);
+
+  /// @throws std::invalid_argument if an edge has an unknown end vertex or a negative weight.
+  void validate() const;
+
+  std::string filename;
+  Point2DArray positions;
+  std::vector<uint32_t> sources;
+  std::vector<uint32_t> targets;
+  std::vector<Distance> weights;
+};
+
+/// @brief Loads a graph of the 9th DIMACS implementation challenge: arcs from a `.gr` file and optionally vertex
+/// coordinates from a `.co` file.
+///
+/// Both are text files of lines starting with a type character: `c` comments, a single problem line `p sp <vertices>
+/// <arcs>` (`p aux sp co <vertices>` in `.co` files), arcs `a <source> <target> <weight>` and coordinates `v <vertex>
+/// <x> <y>`. Vertices are numbered from 1 in the files and from 0 in the graph. Without a `.co` file, all vertices are
+/// positioned at the origin.
+///
+/// DIMACS coordinates are integer longitudes and latitudes, not in the unit of the arc weights, so the Euclidean
+/// heuristic of the A* planners is not admissible on these graphs.
+class DimacsGraphLoader : public EdgeListGraphLoader
+{
+ public:
+  /// @throws std::runtime_error if a file can't be mapped, std::invalid_argument if it has an invalid format.
+  explicit DimacsGraphLoader(const std::string& filename, const std::string& coordinatesFilename = "");
+
+ private:
+  void readArcs();
+  void readCoordinates(const std::string& coordinatesFilename);
+};
+
+/// @brief Loads a graph from a binary edge-list file, which is read without parsing a single number.
+///
+/// The file is a header (`magic`, `version`, number of vertices and edges) followed by arrays in native byte order:
+/// x and y coordinates of every vertex, then the source vertices, target vertices and weights of every edge.
+class BinaryEdgeListGraphLoader : public EdgeListGraphLoader
+{
+ public:
+  static constexpr uint32_t Version = 1;
+
+  /// @throws std::runtime_error if the file can't be mapped, isn't a binary edge list of this `Version` or is
+  /// truncated, std::invalid_argument if an edge is invalid.
+  explicit BinaryEdgeListGraphLoader(const std::string& filename);
+
+  /// @brief Writes the edges of `graph`, e.g. to convert a DIMACS graph once and load it faster afterwards.
+  static void write(const std::string& filename, const CompressedSparseRowGraph& graph);
+};
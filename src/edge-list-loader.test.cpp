@@ -0,0 +1,112 @@
+#include "edge-list-loader.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "path-finding.h"
+
+std::string writeTemporaryFile(const std::string& name, const std::string& contents)
+{
+  const auto filename = std::filesystem::temp_directory_path() / ("path-finding-" + name);
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file << contents;
+  return filename.string();
+}
+
+std::vector<std::pair<Vertex, Distance>> getOutEdges(const CompressedSparseRowGraph& graph, Vertex vertex)
+{
+  std::vector<std::pair<Vertex, Distance>> outEdges;
+  for_each_out_edge(
+      graph, vertex, [&outEdges](Vertex target, Distance weight) { outEdges.emplace_back(target, weight); });
+  return outEdges;
+}
+
+const std::string DimacsArcs =
+    "c 9th DIMACS challenge graph\r\n"
+    "p sp 4 5\r\n"
+    "a 1 2 2\r\n"
+    "a 1 3 3\r\n"
+    "a 2 3 1\r\n"
+    "\r\n"
+    "a 1 4 1\r\n"
+    "a 4 3 1\r\n";
+
+TEST(DimacsGraphLoader, loads_arcs_and_coordinates)
+{
+  const std::string arcsFilename = writeTemporaryFile("dimacs.gr", DimacsArcs);
+  const std::string coordinatesFilename = writeTemporaryFile(
+      "dimacs.co", "c coordinates\np aux sp co 4\nv 1 0 1\nv 2 -1 4\nv 3 3 -4\nv 4 2 -10\n");
+  DimacsGraphLoader loader(arcsFilename, coordinatesFilename);
+
+  ASSERT_EQ(loader.getNumberOfVertices(), 4u);
+  ASSERT_EQ(loader.getNumberOfEdges(), 5u);
+  const auto graph = loader.getCompressedGraph();
+  EXPECT_EQ(getOutEdges(graph, 0), (std::vector<std::pair<Vertex, Distance>>{{1, 2.0f}, {2, 3.0f}, {3, 1.0f}}));
+  EXPECT_EQ(getOutEdges(graph, 3), (std::vector<std::pair<Vertex, Distance>>{{2, 1.0f}}));
+  EXPECT_TRUE(getOutEdges(graph, 2).empty());
+  EXPECT_EQ(graph.getPosition(1), (Point2D{-1.0f, 4.0f}));
+  EXPECT_EQ(graph.getPosition(3), (Point2D{2.0f, -10.0f}));
+
+  // Same graph as the default one, in the same out-edge order
+  const auto adjacencyListGraph = loader.getGraph();
+  const CompressedSparseRowGraph convertedGraph(*adjacencyListGraph);
+  for (Vertex vertex = 0; vertex < 4; ++vertex)
+  {
+    EXPECT_EQ(getOutEdges(convertedGraph, vertex), getOutEdges(graph, vertex));
+  }
+  EXPECT_EQ(dijkstra_shortest_path(graph, 0, 2), (Path{0, 3, 2}));
+}
+
+TEST(DimacsGraphLoader, positions_vertices_at_origin_without_coordinates)
+{
+  DimacsGraphLoader loader(writeTemporaryFile("dimacs.gr", DimacsArcs));
+  EXPECT_EQ(loader.getCompressedGraph().getPosition(2), (Point2D{0.0f, 0.0f}));
+}
+
+TEST(DimacsGraphLoader, throws_exception_on_invalid_file)
+{
+  EXPECT_THROW(DimacsGraphLoader(writeTemporaryFile("invalid.gr", "a 1 2 3\n")), std::invalid_argument);
+  EXPECT_THROW(DimacsGraphLoader(writeTemporaryFile("invalid.gr", "p sp 2 1\na 1 3 1\n")), std::invalid_argument);
+  EXPECT_THROW(DimacsGraphLoader(writeTemporaryFile("invalid.gr", "p sp 2 1\na 0 1 1\n")), std::invalid_argument);
+  EXPECT_THROW(DimacsGraphLoader(writeTemporaryFile("invalid.gr", "p sp 2 1\na 1 2 x\n")), std::invalid_argument);
+  EXPECT_THROW(DimacsGraphLoader(writeTemporaryFile("invalid.gr", "p max 2 1\n")), std::invalid_argument);
+  const std::string arcsFilename = writeTemporaryFile("arcs.gr", DimacsArcs);
+  EXPECT_THROW(
+      DimacsGraphLoader(arcsFilename, writeTemporaryFile("invalid.co", "p aux sp co 3\n")), std::invalid_argument);
+  EXPECT_THROW(DimacsGraphLoader("does-not-exist.gr"), std::runtime_error);
+}
+
+TEST(BinaryEdgeListGraphLoader, reads_written_graph)
+{
+  const auto graph =
+      MapGraphLoader(std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/maze-32-32-2/maze-32-32-2.map")
+                         .make_preferred()
+                         .string())
+          .getCompressedGraph();
+  const std::string filename = (std::filesystem::temp_directory_path() / "path-finding-maze-32-32-2.edges").string();
+  BinaryEdgeListGraphLoader::write(filename, graph);
+
+  BinaryEdgeListGraphLoader loader(filename);
+  const auto loadedGraph = loader.getCompressedGraph();
+  ASSERT_EQ(loadedGraph.getNumberOfVertices(), graph.getNumberOfVertices());
+  ASSERT_EQ(loadedGraph.getNumberOfEdges(), graph.getNumberOfEdges());
+  for (Vertex vertex = 0; vertex < graph.getNumberOfVertices(); ++vertex)
+  {
+    EXPECT_EQ(loadedGraph.getPosition(vertex), graph.getPosition(vertex));
+    EXPECT_EQ(getOutEdges(loadedGraph, vertex), getOutEdges(graph, vertex));
+  }
+}
+
+TEST(BinaryEdgeListGraphLoader, throws_exception_on_invalid_file)
+{
+  EXPECT_THROW(BinaryEdgeListGraphLoader(writeTemporaryFile("invalid.edges", "PFEDGES")), std::runtime_error);
+  EXPECT_THROW(
+      BinaryEdgeListGraphLoader(writeTemporaryFile("invalid.edges", std::string(32, '\0'))), std::runtime_error);
+
+  const std::string filename = (std::filesystem::temp_directory_path() / "path-finding-truncated.edges").string();
+  BinaryEdgeListGraphLoader::write(filename, CompressedSparseRowGraph(*DefaultGraphLoader().getGraph()));
+  std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 4);
+  EXPECT_THROW(BinaryEdgeListGraphLoader{filename}, std::runtime_error);
+}
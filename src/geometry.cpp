@@ -15,3 +15,25 @@ std::ostream& operator<<(std::ostream& stream, const Point2D& point)
   stream << "[ " << point.x << "," << point.y << " ]";
   return stream;
 }
+
+size_t Point2DArray::size() const
+{
+  return x.size();
+}
+
+void Point2DArray::reserve(size_t capacity)
+{
+  x.reserve(capacity);
+  y.reserve(capacity);
+}
+
+void Point2DArray::push_back(const Point2D& point)
+{
+  x.push_back(point.x);
+  y.push_back(point.y);
+}
+
+Point2D Point2DArray::operator[](size_t index) const
+{
+  return {x[index], y[index]};
+}
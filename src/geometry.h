@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ostream>
+#include <vector>
 
 class Point2D
 {
@@ -12,3 +13,17 @@ class Point2D
 bool operator==(const Point2D& p1, const Point2D& p2);
 bool isNear(const Point2D& p1, const Point2D& p2, const float precision);
 std::ostream& operator<<(std::ostream& stream, const Point2D& point);
+
+/// @brief Points stored as separate contiguous x and y arrays (structure of arrays), so that kernels evaluating many
+/// points at once load them with unit stride.
+class Point2DArray
+{
+ public:
+  std::vector<float> x;
+  std::vector<float> y;
+
+  size_t size() const;
+  void reserve(size_t capacity);
+  void push_back(const Point2D& point);
+  Point2D operator[](size_t index) const;
+};
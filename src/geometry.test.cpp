@@ -38,3 +38,14 @@ TEST(Point2D, print_to_stream)
   out << point;
   EXPECT_EQ(out.str(), "[ 0.3,1.7 ]");
 }
+
+TEST(Point2DArray, stores_coordinates_in_separate_arrays)
+{
+  Point2DArray points;
+  points.push_back({0.3f, 1.7f});
+  points.push_back({2.0f, -1.0f});
+  ASSERT_EQ(points.size(), 2u);
+  EXPECT_EQ(points.x, std::vector<float>({0.3f, 2.0f}));
+  EXPECT_EQ(points.y, std::vector<float>({1.7f, -1.0f}));
+  EXPECT_EQ(points[1], Point2D({2.0f, -1.0f}));
+}
@@ -0,0 +1,299 @@
+#include "graph-cache.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "mapped-file.h"
+
+struct GraphCache::Header
+{
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t ordering;
+  FileStamp sourceStamp;
+  uint64_t sourceHash;
+  uint32_t width;
+  uint32_t height;
+  uint64_t numberOfVertices;
+  uint64_t numberOfEdges;
+};
+
+namespace
+{
+constexpr std::array<char, 8> GraphCacheMagic{'P', 'F', 'G', 'R', 'A', 'P', 'H', '\0'};
+constexpr size_t GraphCacheAlignment = 8;
+
+size_t align(size_t size)
+{
+  return (size + GraphCacheAlignment - 1) / GraphCacheAlignment * GraphCacheAlignment;
+}
+}  // namespace
+
+uint64_t hash_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open())
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << filename << "' from " << std::filesystem::current_path();
+    throw std::runtime_error(message.str());
+  }
+
+  uint64_t hash = 14695981039346656037ull;
+  std::vector<char> buffer(1 << 16);
+  while (file)
+  {
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    const size_t count = static_cast<size_t>(file.gcount());
+    for (size_t index = 0; index < count; ++index)
+    {
+      hash ^= static_cast<unsigned char>(buffer[index]);
+      hash *= 1099511628211ull;
+    }
+  }
+  return hash;
+}
+
+FileStamp stamp_file(const std::string& filename)
+{
+  std::error_code error;
+  const uintmax_t size = std::filesystem::file_size(filename, error);
+  const auto lastWriteTime = std::filesystem::last_write_time(filename, error);
+  if (error)
+  {
+    std::ostringstream message;
+    message << "Failed to stat '" << filename << "' from " << std::filesystem::current_path() << ": "
+            << error.message();
+    throw std::runtime_error(message.str());
+  }
+  return {static_cast<uint64_t>(size), static_cast<int64_t>(lastWriteTime.time_since_epoch().count())};
+}
+
+std::string temporary_filename(const std::string& filename)
+{
+  std::random_device randomDevice;
+  const uint64_t randomBits = (uint64_t(randomDevice()) << 32) | randomDevice();
+  const uint64_t suffix = randomBits ^ std::hash<std::thread::id>()(std::this_thread::get_id());
+  std::ostringstream temporaryFilename;
+  temporaryFilename << filename << "." << std::hex << suffix << ".tmp";
+  return temporaryFilename.str();
+}
+
+GraphCache::GraphCache(const std::string& filename)
+    : file(std::make_shared<const MappedFile>(filename)), header(nullptr), cellVertices(nullptr), vertexCells(nullptr)
+{
+  auto invalid = [&filename](const std::string& reason)
+  {
+    std::ostringstream message;
+    message << "Failed to load graph cache '" << filename << "': " << reason;
+    return std::runtime_error(message.str());
+  };
+
+  if (file->size() < sizeof(Header))
+  {
+    throw invalid("file is too short");
+  }
+  header = reinterpret_cast<const Header*>(file->data());
+  if (header->magic != GraphCacheMagic)
+  {
+    throw invalid("not a graph cache");
+  }
+  if (header->version != Version)
+  {
+    std::ostringstream reason;
+    reason << "expected version " << Version << ", got " << header->version;
+    throw invalid(reason.str());
+  }
+
+  const size_t numberOfVertices = static_cast<size_t>(header->numberOfVertices);
+  const size_t numberOfEdges = static_cast<size_t>(header->numberOfEdges);
+  const size_t numberOfCells = size_t(header->width) * header->height;
+  if (numberOfVertices > file->size() || numberOfEdges > file->size() || numberOfCells > file->size())
+  {
+    throw invalid("array sizes exceed the file size");
+  }
+  size_t position = align(sizeof(Header));
+  auto next = [this, &position](size_t count, size_t elementSize)
+  {
+    const char* array = file->data() + position;
+    position += align(count * elementSize);
+    return array;
+  };
+  const char* offsets = next(numberOfVertices + 1, sizeof(CompressedSparseRowGraph::EdgeIndex));
+  const char* targets = next(numberOfEdges, sizeof(CompressedSparseRowGraph::VertexIndex));
+  const char* weights = next(numberOfEdges, sizeof(Distance));
+  const char* x = next(numberOfVertices, sizeof(float));
+  const char* y = next(numberOfVertices, sizeof(float));
+  const char* cells = next(numberOfCells, sizeof(uint32_t));
+  const char* vertices = next(numberOfVertices, sizeof(uint32_t));
+  if (position != file->size())
+  {
+    std::ostringstream reason;
+    reason << "expected " << position << " bytes, got " << file->size();
+    throw invalid(reason.str());
+  }
+
+  // Indices are checked once here, so that a corrupted cache is rebuilt instead of sending searches out of bounds
+  const auto* edgeOffsets = reinterpret_cast<const CompressedSparseRowGraph::EdgeIndex*>(offsets);
+  if (edgeOffsets[0] != 0 || edgeOffsets[numberOfVertices] != numberOfEdges
+      || !std::is_sorted(edgeOffsets, edgeOffsets + numberOfVertices + 1))
+  {
+    throw invalid("edge offsets are out of range");
+  }
+  const auto* edgeTargets = reinterpret_cast<const CompressedSparseRowGraph::VertexIndex*>(targets);
+  if (std::any_of(
+          edgeTargets, edgeTargets + numberOfEdges, [=](uint32_t target) { return target >= numberOfVertices; }))
+  {
+    throw invalid("edge target is out of range");
+  }
+  const auto* cellVertexArray = reinterpret_cast<const uint32_t*>(cells);
+  if (std::any_of(
+          cellVertexArray,
+          cellVertexArray + numberOfCells,
+          [=](uint32_t vertex) { return vertex >= numberOfVertices && vertex != NoVertex; }))
+  {
+    throw invalid("cell vertex is out of range");
+  }
+  const auto* vertexCellArray = reinterpret_cast<const uint32_t*>(vertices);
+  if (std::any_of(
+          vertexCellArray, vertexCellArray + numberOfVertices, [=](uint32_t cell) { return cell >= numberOfCells; }))
+  {
+    throw invalid("vertex cell is out of range");
+  }
+
+  graph = CompressedSparseRowGraph(
+      file,
+      numberOfVertices,
+      numberOfEdges,
+      edgeOffsets,
+      edgeTargets,
+      reinterpret_cast<const Distance*>(weights),
+      reinterpret_cast<const float*>(x),
+      reinterpret_cast<const float*>(y));
+  cellVertices = cellVertexArray;
+  vertexCells = vertexCellArray;
+}
+
+void GraphCache::write(
+    const std::string& filename,
+    const FileStamp& sourceStamp,
+    uint64_t sourceHash,
+    VertexOrdering ordering,
+    unsigned width,
+    unsigned height,
+    const CompressedSparseRowGraph& graph)
+{
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  const size_t numberOfEdges = graph.getNumberOfEdges();
+  std::vector<uint32_t> cellVertices(size_t(width) * height, NoVertex);
+  std::vector<uint32_t> vertexCells(numberOfVertices);
+  for (size_t vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    const auto row = static_cast<uint32_t>(graph.getX()[vertex]);
+    const auto column = static_cast<uint32_t>(graph.getY()[vertex]);
+    vertexCells[vertex] = row * width + column;
+    cellVertices[vertexCells[vertex]] = static_cast<uint32_t>(vertex);
+  }
+
+  // Written next to the target and renamed at the end, so that concurrent readers never map a half-written cache
+  const std::string temporaryFilename = temporary_filename(filename);
+  auto failed = [&filename, &temporaryFilename]()
+  {
+    std::error_code error;
+    std::filesystem::remove(temporaryFilename, error);
+    std::ostringstream message;
+    message << "Failed to write graph cache '" << filename << "' from " << std::filesystem::current_path();
+    return std::runtime_error(message.str());
+  };
+  {
+    std::ofstream file(temporaryFilename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      throw failed();
+    }
+
+    auto write = [&file](const void* data, size_t size)
+    {
+      const char padding[GraphCacheAlignment] = {};
+      file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+      file.write(padding, static_cast<std::streamsize>(align(size) - size));
+    };
+    const Header header{
+        GraphCacheMagic,
+        Version,
+        static_cast<uint32_t>(ordering),
+        sourceStamp,
+        sourceHash,
+        width,
+        height,
+        numberOfVertices,
+        numberOfEdges};
+    write(&header, sizeof(Header));
+    write(graph.getOffsets(), (numberOfVertices + 1) * sizeof(CompressedSparseRowGraph::EdgeIndex));
+    write(graph.getTargets(), numberOfEdges * sizeof(CompressedSparseRowGraph::VertexIndex));
+    write(graph.getWeights(), numberOfEdges * sizeof(Distance));
+    write(graph.getX(), numberOfVertices * sizeof(float));
+    write(graph.getY(), numberOfVertices * sizeof(float));
+    write(cellVertices.data(), cellVertices.size() * sizeof(uint32_t));
+    write(vertexCells.data(), vertexCells.size() * sizeof(uint32_t));
+    file.close();
+    if (!file)
+    {
+      throw failed();
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporaryFilename, filename, error);
+  if (error)
+  {
+    throw failed();
+  }
+}
+
+const FileStamp& GraphCache::getSourceStamp() const
+{
+  return header->sourceStamp;
+}
+
+uint64_t GraphCache::getSourceHash() const
+{
+  return header->sourceHash;
+}
+
+VertexOrdering GraphCache::getOrdering() const
+{
+  return static_cast<VertexOrdering>(header->ordering);
+}
+
+unsigned GraphCache::getWidth() const
+{
+  return header->width;
+}
+
+unsigned GraphCache::getHeight() const
+{
+  return header->height;
+}
+
+const CompressedSparseRowGraph& GraphCache::getGraph() const
+{
+  return graph;
+}
+
+const uint32_t* GraphCache::getCellVertices() const
+{
+  return cellVertices;
+}
+
+const uint32_t* GraphCache::getVertexCells() const
+{
+  return vertexCells;
+}
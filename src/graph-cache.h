@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "csr-graph.h"
+#include "vertex-ordering.h"
+
+class MappedFile;
+
+/// @brief 64-bit FNV-1a hash of the file contents. Tells whether a graph cache was built from the current version of
+/// its source map.
+uint64_t hash_file(const std::string& filename);
+
+/// @brief Size and last write time of a file. Unchanged ones tell that a graph cache is up to date without reading its
+/// source map; the hash is only compared when they differ, e.g. after the map was copied or touched.
+struct FileStamp
+{
+  uint64_t size;
+  int64_t lastWriteTime;
+
+  bool operator==(const FileStamp& other) const = default;
+};
+
+/// @throws std::runtime_error if the file doesn't exist.
+FileStamp stamp_file(const std::string& filename);
+
+/// @brief Name next to `filename`, unique to the calling process and thread, to write a file under before renaming it
+/// to `filename`, so that concurrent writers never share a half-written file.
+std::string temporary_filename(const std::string& filename);
+
+/// @brief Versioned binary image of a graph built from a `.map` file, loaded by memory-mapping it without parsing a
+/// single element. The compressed sparse row graph returned by `getGraph` is a view straight into the mapped pages.
+///
+/// The file is a header followed by arrays in native byte order, each starting at a multiple of 8 bytes: offsets,
+/// targets, weights, x and y coordinates of the graph, the vertex of every cell in row-major order (`NoVertex` for
+/// blocked cells) and the cell (`row * width + column`) of every vertex.
+class GraphCache
+{
+ public:
+  static constexpr uint32_t Version = 2;
+  static constexpr uint32_t NoVertex = MapGraphLoader::NoVertex;
+
+  /// @throws std::runtime_error if the file can't be mapped, isn't a graph cache of this `Version`, is truncated or
+  /// holds a vertex, edge or cell index out of range.
+  explicit GraphCache(const std::string& filename);
+
+  /// @brief Writes the cache of `graph`, whose vertex positions are the (row, column) map cells of its vertices.
+  /// @throws std::runtime_error if the file can't be written, leaving any previous cache in place.
+  static void write(
+      const std::string& filename,
+      const FileStamp& sourceStamp,
+      uint64_t sourceHash,
+      VertexOrdering ordering,
+      unsigned width,
+      unsigned height,
+      const CompressedSparseRowGraph& graph);
+
+  const FileStamp& getSourceStamp() const;
+  uint64_t getSourceHash() const;
+  VertexOrdering getOrdering() const;
+  unsigned getWidth() const;
+  unsigned getHeight() const;
+  const CompressedSparseRowGraph& getGraph() const;
+  /// @brief `width * height` vertices of the cells in row-major order, `NoVertex` for blocked cells.
+  const uint32_t* getCellVertices() const;
+  /// @brief Cell `row * width + column` of every vertex.
+  const uint32_t* getVertexCells() const;
+
+ private:
+  struct Header;
+
+  std::shared_ptr<const MappedFile> file;
+  const Header* header;
+  CompressedSparseRowGraph graph;
+  const uint32_t* cellVertices;
+  const uint32_t* vertexCells;
+};
@@ -0,0 +1,183 @@
+#include "graph-cache.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "test-data.h"
+
+std::string getCacheFilename(const std::string& name)
+{
+  const auto filename = std::filesystem::temp_directory_path() / ("path-finding-" + name + ".graph");
+  std::filesystem::remove(filename);
+  return filename.string();
+}
+
+void expectSameGraphs(const MapGraphLoader& expected, const MapGraphLoader& actual)
+{
+  const auto& expectedGraph = *expected.getGraph();
+  const auto& graph = *actual.getGraph();
+  ASSERT_EQ(boost::num_vertices(graph), boost::num_vertices(expectedGraph));
+  ASSERT_EQ(boost::num_edges(graph), boost::num_edges(expectedGraph));
+  for (Vertex vertex = 0; vertex < boost::num_vertices(graph); ++vertex)
+  {
+    EXPECT_EQ(graph[vertex].position, expectedGraph[vertex].position);
+    EXPECT_EQ(
+        actual.convertVertexIndexToMapPosition(static_cast<unsigned>(vertex)),
+        expected.convertVertexIndexToMapPosition(static_cast<unsigned>(vertex)));
+
+    std::vector<std::pair<Vertex, Distance>> expectedOutEdges;
+    for_each_out_edge(
+        expectedGraph,
+        vertex,
+        [&expectedOutEdges](Vertex target, Distance weight) { expectedOutEdges.emplace_back(target, weight); });
+    std::vector<std::pair<Vertex, Distance>> outEdges;
+    for_each_out_edge(
+        graph, vertex, [&outEdges](Vertex target, Distance weight) { outEdges.emplace_back(target, weight); });
+    EXPECT_EQ(outEdges, expectedOutEdges) << "vertex " << vertex;
+  }
+}
+
+TEST(hash_file, differs_for_different_contents)
+{
+  const std::string filename = getMapFilename("maze-32-32-2");
+  EXPECT_EQ(hash_file(filename), hash_file(filename));
+  EXPECT_NE(hash_file(filename), hash_file(getMapFilename("maze-128-128-2")));
+  EXPECT_THROW(hash_file("this-file-does-not-exist.map"), std::runtime_error);
+}
+
+TEST(GraphCache, is_written_on_first_load_and_mapped_on_the_next_ones)
+{
+  const std::string mapFilename = getMapFilename("maze-32-32-2");
+  const std::string cacheFilename = getCacheFilename("maze-32-32-2");
+
+  MapGraphLoader parsingLoader(mapFilename, VertexOrdering::Hilbert);
+  MapGraphLoader writingLoader(mapFilename, VertexOrdering::Hilbert, cacheFilename);
+  ASSERT_TRUE(std::filesystem::exists(cacheFilename));
+  expectSameGraphs(parsingLoader, writingLoader);
+
+  const GraphCache cache(cacheFilename);
+  EXPECT_EQ(cache.getSourceStamp(), stamp_file(mapFilename));
+  EXPECT_EQ(cache.getSourceHash(), hash_file(mapFilename));
+  EXPECT_EQ(cache.getOrdering(), VertexOrdering::Hilbert);
+  EXPECT_EQ(cache.getWidth(), 32u);
+  EXPECT_EQ(cache.getHeight(), 32u);
+  for (size_t row = 0; row < cache.getHeight(); ++row)
+  {
+    for (size_t column = 0; column < cache.getWidth(); ++column)
+    {
+      const uint32_t vertex = cache.getCellVertices()[row * cache.getWidth() + column];
+      const auto expectedVertex = parsingLoader.convertMapPositionToVertexIndex(row, column);
+      EXPECT_EQ(vertex == GraphCache::NoVertex ? std::nullopt : std::optional<unsigned>(vertex), expectedVertex);
+    }
+  }
+
+  const auto lastWriteTime = std::filesystem::last_write_time(cacheFilename);
+  MapGraphLoader cachedLoader(mapFilename, VertexOrdering::Hilbert, cacheFilename);
+  EXPECT_EQ(std::filesystem::last_write_time(cacheFilename), lastWriteTime);
+  expectSameGraphs(parsingLoader, cachedLoader);
+  for (size_t row = 0; row < 32; ++row)
+  {
+    for (size_t column = 0; column < 32; ++column)
+    {
+      EXPECT_EQ(
+          cachedLoader.convertMapPositionToVertexIndex(row, column),
+          parsingLoader.convertMapPositionToVertexIndex(row, column));
+    }
+  }
+
+  const CompressedSparseRowGraph compressedGraph = cachedLoader.getCompressedGraph();
+  const CompressedSparseRowGraph expectedCompressedGraph = parsingLoader.getCompressedGraph();
+  ASSERT_EQ(compressedGraph.getNumberOfEdges(), expectedCompressedGraph.getNumberOfEdges());
+  for (size_t edge = 0; edge < compressedGraph.getNumberOfEdges(); ++edge)
+  {
+    EXPECT_EQ(compressedGraph.getTargets()[edge], expectedCompressedGraph.getTargets()[edge]);
+  }
+}
+
+TEST(GraphCache, is_rebuilt_when_map_or_ordering_changes)
+{
+  const std::string cacheFilename = getCacheFilename("stale");
+  MapGraphLoader(getMapFilename("maze-32-32-2"), VertexOrdering::RowMajor, cacheFilename);
+  EXPECT_EQ(GraphCache(cacheFilename).getSourceHash(), hash_file(getMapFilename("maze-32-32-2")));
+
+  MapGraphLoader otherMapLoader(getMapFilename("maze-128-128-2"), VertexOrdering::RowMajor, cacheFilename);
+  EXPECT_EQ(GraphCache(cacheFilename).getSourceHash(), hash_file(getMapFilename("maze-128-128-2")));
+  expectSameGraphs(MapGraphLoader(getMapFilename("maze-128-128-2")), otherMapLoader);
+
+  MapGraphLoader otherOrderingLoader(getMapFilename("maze-128-128-2"), VertexOrdering::Morton, cacheFilename);
+  EXPECT_EQ(GraphCache(cacheFilename).getOrdering(), VertexOrdering::Morton);
+}
+
+TEST(GraphCache, is_kept_when_the_map_is_touched_but_unchanged)
+{
+  const std::string mapFilename = getCacheFilename("touched.map");
+  std::filesystem::copy_file(getMapFilename("maze-32-32-2"), mapFilename);
+  const std::string cacheFilename = getCacheFilename("touched");
+  MapGraphLoader(mapFilename, VertexOrdering::RowMajor, cacheFilename);
+  const auto lastWriteTime = std::filesystem::last_write_time(cacheFilename);
+
+  std::filesystem::last_write_time(mapFilename, std::filesystem::last_write_time(mapFilename) + std::chrono::hours(1));
+  EXPECT_NE(GraphCache(cacheFilename).getSourceStamp(), stamp_file(mapFilename));
+  MapGraphLoader touchedLoader(mapFilename, VertexOrdering::RowMajor, cacheFilename);
+  EXPECT_EQ(std::filesystem::last_write_time(cacheFilename), lastWriteTime);
+  expectSameGraphs(MapGraphLoader(mapFilename), touchedLoader);
+  std::filesystem::remove(mapFilename);
+}
+
+TEST(GraphCache, throws_exception_on_invalid_file)
+{
+  const std::string filename = getCacheFilename("invalid");
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file << "type octile\nheight 4\nwidth 4\nmap\n....\n....\n....\n....\n";
+  }
+  EXPECT_THROW(GraphCache{filename}, std::runtime_error);
+  EXPECT_THROW(GraphCache{"this-file-does-not-exist.graph"}, std::runtime_error);
+}
+
+TEST(GraphCache, throws_exception_on_out_of_range_indices)
+{
+  const std::string filename = getCacheFilename("out-of-range");
+  // A single vertex in a 1x1 map, with an edge to a vertex that doesn't exist
+  const Point2DArray positions{{0.0f}, {0.0f}};
+  GraphCache::write(
+      filename, {}, 0, VertexOrdering::RowMajor, 1, 1, CompressedSparseRowGraph({0, 1}, {1}, {1.0f}, positions));
+  EXPECT_THROW(GraphCache{filename}, std::runtime_error);
+
+  // The last two arrays are the vertex of the cell and the cell of the vertex, each padded to 8 bytes
+  auto corrupt = [&filename, &positions](std::streamoff offsetFromEnd)
+  {
+    GraphCache::write(
+        filename, {}, 0, VertexOrdering::RowMajor, 1, 1, CompressedSparseRowGraph({0, 1}, {0}, {1.0f}, positions));
+    EXPECT_NO_THROW(GraphCache{filename});
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-offsetFromEnd, std::ios::end);
+    const uint32_t index = 7;
+    file.write(reinterpret_cast<const char*>(&index), sizeof(index));
+  };
+  corrupt(16);
+  EXPECT_THROW(GraphCache{filename}, std::runtime_error);
+  corrupt(8);
+  EXPECT_THROW(GraphCache{filename}, std::runtime_error);
+}
+
+TEST(GraphCache, is_skipped_when_it_cannot_be_written)
+{
+  const auto directory = std::filesystem::temp_directory_path() / "path-finding-missing-directory";
+  std::filesystem::remove_all(directory);
+  const std::string cacheFilename = (directory / "maze-32-32-2.graph").string();
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"), VertexOrdering::RowMajor, cacheFilename);
+  EXPECT_FALSE(std::filesystem::exists(directory));
+  expectSameGraphs(MapGraphLoader(getMapFilename("maze-32-32-2")), loader);
+}
+
+TEST(temporary_filename, is_unique_next_to_the_file)
+{
+  const std::string filename = getCacheFilename("temporary");
+  const std::string temporaryFilename = temporary_filename(filename);
+  EXPECT_EQ(temporaryFilename.rfind(filename, 0), 0u);
+  EXPECT_NE(temporaryFilename, filename);
+  EXPECT_NE(temporaryFilename, temporary_filename(filename));
+}
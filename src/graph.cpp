@@ -5,13 +5,14 @@
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <filesystem>
-#include <fstream>
 #include <optional>
 #include <ostream>
 #include <queue>
 
+#include "csr-graph.h"
+#include "graph-cache.h"
+#include "map-reader.h"
 #include "sequence.h"
-#include "strings.h"
 
 std::ostream& operator<<(std::ostream& stream, const Path& path)
 {
@@ -24,7 +25,7 @@ std::ostream& operator<<(std::ostream& stream, const Path& path)
   return stream;
 }
 
-Path extract_path(std::vector<Vertex> predecessor, const Vertex& target, const Vertex& start)
+Path extract_path(const std::vector<Vertex>& predecessor, const Vertex& target, const Vertex& start)
 {
   std::vector<boost::graph_traits<WeightedDiGraph>::vertex_descriptor> path;
   boost::graph_traits<WeightedDiGraph>::vertex_descriptor current = target;
@@ -70,26 +71,26 @@ std::vector<Vertex> intersection(const Path& path1, const Path& path2)
   return intersection;
 }
 
-WeightedDiGraph DefaultGraphLoader::getGraph() const
+SharedGraph DefaultGraphLoader::getGraph() const
 {
-  WeightedDiGraph graph(4);
+  auto graph = std::make_shared<WeightedDiGraph>(4);
 
   LinearSequence<float> linearSequence;
   AlternateSequence<float> alternateSequence;
 
-  for (size_t index = 0; index < graph.m_vertices.size(); ++index)
+  for (size_t index = 0; index < graph->m_vertices.size(); ++index)
   {
     float v = linearSequence();
     float x = v;
     float y = alternateSequence() * (v + 1);
-    graph.m_vertices[index].m_property.position = {x, y};
+    graph->m_vertices[index].m_property.position = {x, y};
   }
 
-  add_edge(0, 1, 2.0f, graph);
-  add_edge(0, 2, 3.0f, graph);
-  add_edge(1, 2, 1.0f, graph);
-  add_edge(0, 3, 1.0f, graph);
-  add_edge(3, 2, 1.0f, graph);
+  add_edge(0, 1, 2.0f, *graph);
+  add_edge(0, 2, 3.0f, *graph);
+  add_edge(1, 2, 1.0f, *graph);
+  add_edge(0, 3, 1.0f, *graph);
+  add_edge(3, 2, 1.0f, *graph);
 
   return graph;
 }
@@ -99,72 +100,121 @@ bool isVertexPassable(char value)
   return value == '.' || value == 'G';
 }
 
-void readStaticHeaderLine(std::ifstream& file, const std::string expectedLine, const std::string& filename)
+MapGraphLoader::MapGraphLoader(const std::string& filename, VertexOrdering ordering, const std::string& cacheFilename)
+    : filename(filename), ordering(ordering), width(0), height(0)
 {
-  std::string line;
-  getLine(file, line);
-  if (line != expectedLine)
+  if (cacheFilename.empty())
   {
-    std::ostringstream message;
-    message << "Failed to open '" << filename << "': invalid format. Expected 'type octile', got '" << line << "'";
-    throw std::invalid_argument(message.str());
+    graph = std::make_shared<const WeightedDiGraph>(readFile());
+    return;
+  }
+
+  const FileStamp sourceStamp = stamp_file(filename);
+  if (!readCache(cacheFilename, sourceStamp))
+  {
+    graph = std::make_shared<const WeightedDiGraph>(readFile());
+    try
+    {
+      GraphCache::write(cacheFilename, sourceStamp, hash_file(filename), ordering, width, height, getCompressedGraph());
+    } catch (const std::runtime_error&)
+    {
+      // The cache only saves parsing the map next time, so e.g. a read-only cache directory just goes without one
+    }
   }
 }
 
-unsigned readUnsignedValue(std::ifstream& file, const std::string expectedParameterTitle, const std::string& filename)
+bool MapGraphLoader::readCache(const std::string& cacheFilename, const FileStamp& sourceStamp)
 {
-  std::string line;
-  getLine(file, line);
-  std::string label;
-  std::string stringValue;
-  std::istringstream lineStream(line);
-  std::getline(lineStream, label, ' ');
-  if (label != expectedParameterTitle)
+  if (!std::filesystem::exists(cacheFilename))
   {
-    std::ostringstream message;
-    message << "Failed to open '" << filename << "': invalid format. Expected 'type octile', got '" << label << "'";
-    throw std::invalid_argument(message.str());
+    return false;
   }
-  std::getline(lineStream, stringValue, ' ');
-  int value = std::stoi(stringValue);
-  if (value < 0)
+  std::optional<GraphCache> cache;
+  try
+  {
+    cache.emplace(cacheFilename);
+  } catch (const std::runtime_error&)
   {
-    std::ostringstream message;
-    message << "Failed to open '" << filename << "': invalid format. Expected height to be positive, got '" << value
-            << "'";
-    throw std::invalid_argument(message.str());
+    // Caches of another format version, or truncated ones, are rebuilt
+    return false;
   }
-  return static_cast<unsigned>(value);
+  if (cache->getOrdering() != ordering
+      || (cache->getSourceStamp() != sourceStamp && cache->getSourceHash() != hash_file(filename)))
+  {
+    return false;
+  }
+
+  width = cache->getWidth();
+  height = cache->getHeight();
+  const CompressedSparseRowGraph& compressedGraph = cache->getGraph();
+  const size_t numberOfVertices = compressedGraph.getNumberOfVertices();
+  cellVertices.assign(cache->getCellVertices(), cache->getCellVertices() + size_t(width) * height);
+  vertexCells.assign(cache->getVertexCells(), cache->getVertexCells() + numberOfVertices);
+  cachedGraph = std::make_shared<const CompressedSparseRowGraph>(compressedGraph);
+  return true;
 }
 
-std::vector<std::string> readMap(std::ifstream& file, unsigned width, unsigned height, const std::string& filename)
+SharedGraph MapGraphLoader::getGraph() const
 {
-  std::vector<std::string> map;
-  map.reserve(height);
-  for (unsigned h = 0; h < height; ++h)
+  if (!graph)
   {
-    std::string line;
-    getLine(file, line);
-    map.push_back(line);
-    if (line.size() != width)
+    // The adjacency list needs one node per edge, so it is only copied from the cached arrays when asked for
+    WeightedDiGraph loadedGraph(cachedGraph->getNumberOfVertices());
+    for (Vertex vertex = 0; vertex < cachedGraph->getNumberOfVertices(); ++vertex)
     {
-      std::ostringstream message;
-      message << "Failed to open '" << filename << "': invalid format. Expected map row " << h << " will have " << width
-              << " characters, but got " << line.size();
-      throw std::invalid_argument(message.str());
+      loadedGraph.m_vertices[vertex].m_property.position = cachedGraph->getPosition(vertex);
+      for_each_out_edge(
+          *cachedGraph,
+          vertex,
+          [&loadedGraph, vertex](Vertex target, Distance weight) { add_edge(vertex, target, weight, loadedGraph); });
     }
+    graph = std::make_shared<const WeightedDiGraph>(std::move(loadedGraph));
   }
-  return map;
+  return graph;
 }
 
-MapGraphLoader::MapGraphLoader(const std::string& filename) : filename(filename), width(0), height(0)
+CompressedSparseRowGraph MapGraphLoader::getCompressedGraph() const
 {
-  graph = readFile();
-}
+  if (cachedGraph)
+  {
+    return *cachedGraph;
+  }
 
-WeightedDiGraph MapGraphLoader::getGraph() const
-{
-  return graph;
+  typedef CompressedSparseRowGraph::EdgeIndex EdgeIndex;
+  typedef CompressedSparseRowGraph::VertexIndex VertexIndex;
+
+  const size_t numberOfVertices = vertexCells.size();
+  std::vector<EdgeIndex> offsets;
+  offsets.reserve(numberOfVertices + 1);
+  offsets.push_back(0);
+  std::vector<VertexIndex> targets;
+  targets.reserve(4 * numberOfVertices);
+  Point2DArray positions;
+  positions.reserve(numberOfVertices);
+
+  // Neighbors are listed in the order `readFile` inserts the corresponding edges (left, top, right, bottom), so both
+  // graph types break ties between equally long paths the same way.
+  auto addNeighbor = [this, &targets](size_t cell)
+  {
+    if (cellVertices[cell] != NoVertex)
+    {
+      targets.push_back(cellVertices[cell]);
+    }
+  };
+  for (const uint32_t cell : vertexCells)
+  {
+    const size_t row = cell / width;
+    const size_t column = cell % width;
+    if (column > 0) addNeighbor(cell - 1);
+    if (row > 0) addNeighbor(cell - width);
+    if (column + 1 < width) addNeighbor(cell + 1);
+    if (row + 1 < height) addNeighbor(cell + width);
+    offsets.push_back(static_cast<EdgeIndex>(targets.size()));
+    positions.push_back({float(row), float(column)});
+  }
+
+  std::vector<Distance> weights(targets.size(), 1.0f);
+  return CompressedSparseRowGraph(std::move(offsets), std::move(targets), std::move(weights), std::move(positions));
 }
 
 const std::string& MapGraphLoader::getFilename() const
@@ -174,12 +224,17 @@ const std::string& MapGraphLoader::getFilename() const
 
 std::optional<unsigned> MapGraphLoader::convertMapPositionToVertexIndex(size_t row, size_t column) const
 {
-  return mapPositionToVertexIndex[row][column];
+  const uint32_t vertex = cellVertices[row * width + column];
+  if (vertex == NoVertex)
+  {
+    return std::nullopt;
+  }
+  return vertex;
 }
 
 std::pair<size_t, size_t> MapGraphLoader::convertVertexIndexToMapPosition(unsigned vertex) const
 {
-  return vertexIndexToMapPosition[vertex];
+  return {vertexCells[vertex] / width, vertexCells[vertex] % width};
 }
 
 // Map Format (https://movingai.com/benchmarks/formats.html)
@@ -202,70 +257,74 @@ std::pair<size_t, size_t> MapGraphLoader::convertVertexIndexToMapPosition(unsign
 // T - trees(unpassable)
 // S - swamp(passable from regular terrain)
 // W - water(traversable, but not passable from terrain)
+//
+// The file is memory-mapped and its rows are scanned in place, so the only per-cell memory is the flat cell-to-vertex
+// array.
 WeightedDiGraph MapGraphLoader::readFile()
 {
-  std::ifstream file(filename);
-  if (!file.is_open())
-  {
-    std::ostringstream message;
-    message << "Failed to open '" << filename << "' from " << std::filesystem::current_path();
-    throw std::runtime_error(message.str());
-  }
-
-  readStaticHeaderLine(file, "type octile", filename);
-  height = readUnsignedValue(file, "height", filename);
-  width = readUnsignedValue(file, "width", filename);
-  readStaticHeaderLine(file, "map", filename);
+  MapReader reader(filename);
+  height = reader.getHeight();
+  width = reader.getWidth();
 
-  map = readMap(file, width, height, filename);
-
-  mapPositionToVertexIndex = std::vector<std::vector<std::optional<unsigned>>>(
-      height, std::vector<std::optional<unsigned>>(width, std::nullopt));
-  vertexIndexToMapPosition = std::vector<std::pair<size_t, size_t>>();
-  unsigned numberOfPassableNodes = 0;
+  cellVertices.assign(size_t(width) * height, NoVertex);
+  vertexCells.clear();
   for (size_t row = 0; row < height; ++row)
   {
+    const std::string_view line = reader.readRow();
     for (size_t column = 0; column < width; ++column)
     {
-      const char& value = map[row][column];
-      if (isVertexPassable(value))
+      if (isVertexPassable(line[column]))
       {
-        vertexIndexToMapPosition.emplace_back(std::make_pair(row, column));
-        mapPositionToVertexIndex[row][column] = numberOfPassableNodes;
-        ++numberOfPassableNodes;
+        vertexCells.push_back(static_cast<uint32_t>(row * width + column));
       }
     }
   }
+  if (ordering != VertexOrdering::RowMajor)
+  {
+    std::vector<std::pair<size_t, size_t>> cells;
+    cells.reserve(vertexCells.size());
+    for (const uint32_t cell : vertexCells)
+    {
+      cells.emplace_back(cell / width, cell % width);
+    }
+    const std::vector<size_t> order = vertex_order(cells, width, height, ordering);
+    std::vector<uint32_t> reorderedCells;
+    reorderedCells.reserve(order.size());
+    for (size_t index : order)
+    {
+      reorderedCells.push_back(vertexCells[index]);
+    }
+    vertexCells = std::move(reorderedCells);
+  }
+  const unsigned numberOfPassableNodes = static_cast<unsigned>(vertexCells.size());
+  for (unsigned vertex = 0; vertex < numberOfPassableNodes; ++vertex)
+  {
+    cellVertices[vertexCells[vertex]] = vertex;
+  }
 
   WeightedDiGraph loadedGraph(numberOfPassableNodes);
   for (size_t row = 0; row < height; ++row)
   {
     for (size_t column = 0; column < width; ++column)
     {
-      const char& value = map[row][column];
-      if (isVertexPassable(value))
+      const size_t cell = row * width + column;
+      const uint32_t currentVertexIndex = cellVertices[cell];
+      if (currentVertexIndex != NoVertex)
       {
-        size_t currentVertexIndex = *mapPositionToVertexIndex[row][column];
         loadedGraph.m_vertices[currentVertexIndex].m_property.position = {float(row), float(column)};
         // Add edge to the left
-        if (column > 0 && isVertexPassable(map[row][column - 1]))
+        if (column > 0 && cellVertices[cell - 1] != NoVertex)
         {
-          std::optional<unsigned> leftVertexIndex = mapPositionToVertexIndex[row][column - 1];
-          if (leftVertexIndex)
-          {
-            add_edge(currentVertexIndex, *leftVertexIndex, 1.0f, loadedGraph);
-            add_edge(*leftVertexIndex, currentVertexIndex, 1.0f, loadedGraph);
-          }
+          const uint32_t leftVertexIndex = cellVertices[cell - 1];
+          add_edge(currentVertexIndex, leftVertexIndex, 1.0f, loadedGraph);
+          add_edge(leftVertexIndex, currentVertexIndex, 1.0f, loadedGraph);
         }
         // Add edge to the top
-        if (row > 0 && isVertexPassable(map[row - 1][column]))
+        if (row > 0 && cellVertices[cell - width] != NoVertex)
         {
-          std::optional<unsigned> topVertexIndex = mapPositionToVertexIndex[row - 1][column];
-          if (topVertexIndex)
-          {
-            add_edge(currentVertexIndex, *topVertexIndex, 1.0f, loadedGraph);
-            add_edge(*topVertexIndex, currentVertexIndex, 1.0f, loadedGraph);
-          }
+          const uint32_t topVertexIndex = cellVertices[cell - width];
+          add_edge(currentVertexIndex, topVertexIndex, 1.0f, loadedGraph);
+          add_edge(topVertexIndex, currentVertexIndex, 1.0f, loadedGraph);
         }
       }
     }
@@ -2,9 +2,14 @@
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/astar_search.hpp>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
 #include <string>
 
 #include "geometry.h"
+#include "vertex-ordering.h"
 
 class VertexNode
 {
@@ -19,50 +24,97 @@ typedef boost::adjacency_list<boost::listS, boost::vecS, boost::directedS, Verte
     WeightedDiGraph;
 typedef boost::graph_traits<WeightedDiGraph>::vertex_descriptor Vertex;
 typedef WeightedDiGraph::edge_descriptor Edge;
+/// @brief Read-only graph shared by everything planning on it (loaders, runners, simulation), instead of each of them
+/// holding its own deep copy.
+typedef std::shared_ptr<const WeightedDiGraph> SharedGraph;
 
 typedef std::vector<Vertex> Path;
 std::ostream& operator<<(std::ostream& stream, const Path& path);
 
 float path_length(const WeightedDiGraph& graph, const Path& path);
 std::vector<Vertex> intersection(const Path& path1, const Path& path2);
-Path extract_path(std::vector<Vertex> predecessor, const Vertex& target, const Vertex& start);
+Path extract_path(const std::vector<Vertex>& predecessor, const Vertex& target, const Vertex& start);
+
+/// @brief Calls `visitor(target, weight)` for every out-edge of `vertex`. The searches in `path-finding.cpp` walk the
+/// graph only through this and `vertex_position`, so they run on every graph type providing both.
+template <typename Visitor>
+void for_each_out_edge(const WeightedDiGraph& graph, Vertex vertex, Visitor&& visitor)
+{
+  boost::graph_traits<WeightedDiGraph>::out_edge_iterator edgeIterator, edgeIteratorEnd;
+  for (boost::tie(edgeIterator, edgeIteratorEnd) = boost::out_edges(vertex, graph); edgeIterator != edgeIteratorEnd;
+       ++edgeIterator)
+  {
+    visitor(boost::target(*edgeIterator, graph), boost::get(boost::edge_weight_t(), graph, *edgeIterator));
+  }
+}
+
+inline const Point2D& vertex_position(const WeightedDiGraph& graph, Vertex vertex)
+{
+  return graph[vertex].position;
+}
+
+class CompressedSparseRowGraph;
+struct FileStamp;
+
+/// @brief Whether a cell of a `.map` file (see `MapGraphLoader::readFile`) becomes a vertex.
+bool isVertexPassable(char value);
 
 class GraphLoader
 {
  public:
-  virtual WeightedDiGraph getGraph() const = 0;
+  virtual SharedGraph getGraph() const = 0;
 };
 
 class DefaultGraphLoader : public GraphLoader
 {
  public:
-  WeightedDiGraph getGraph() const override;
+  SharedGraph getGraph() const override;
 };
 
 class MapGraphLoader : public GraphLoader
 {
  public:
-  MapGraphLoader(const std::string& filename);
+  /// @brief Vertex index of blocked map cells.
+  static constexpr uint32_t NoVertex = UINT32_MAX;
+
+  /// @param cacheFilename Optional `GraphCache` of the map. It is loaded instead of parsing the map if it was built
+  /// from the current map contents (the same `FileStamp`, or else the same hash) with the same ordering, otherwise the
+  /// map is parsed and the cache (re)written if possible.
+  MapGraphLoader(
+      const std::string& filename,
+      VertexOrdering ordering = VertexOrdering::RowMajor,
+      const std::string& cacheFilename = "");
   virtual ~MapGraphLoader() = default;
 
   MapGraphLoader() = delete;
   MapGraphLoader(const MapGraphLoader&) = delete;
   MapGraphLoader& operator=(const MapGraphLoader&) = delete;
 
-  WeightedDiGraph getGraph() const override;
+  /// @brief When loaded from a cache, the adjacency list is only built on the first call, which is not thread-safe:
+  /// searches on `getCompressedGraph` never pay for it.
+  SharedGraph getGraph() const override;
+  /// @brief Builds the same graph as `getGraph` straight from the parsed map into compressed sparse row layout. When
+  /// loaded from a cache, returns a view into the mapped cache instead.
+  CompressedSparseRowGraph getCompressedGraph() const;
   const std::string& getFilename() const;
   std::optional<unsigned> convertMapPositionToVertexIndex(size_t row, size_t column) const;
   std::pair<size_t, size_t> convertVertexIndexToMapPosition(unsigned vertex) const;
 
  private:
   WeightedDiGraph readFile();
+  bool readCache(const std::string& cacheFilename, const FileStamp& sourceStamp);
 
   std::string filename;
+  VertexOrdering ordering;
   unsigned width;
   unsigned height;
-  std::vector<std::string> map;
-  std::vector<std::vector<std::optional<unsigned>>> mapPositionToVertexIndex;
-  std::vector<std::pair<size_t, size_t>> vertexIndexToMapPosition;
+  /// @brief Vertex of every map cell (`row * width + column`), `NoVertex` for blocked cells.
+  std::vector<uint32_t> cellVertices;
+  /// @brief Map cell of every vertex.
+  std::vector<uint32_t> vertexCells;
 
-  WeightedDiGraph graph;
+  /// @brief Built from `cachedGraph` on the first `getGraph`, when the graph was loaded from a cache.
+  mutable SharedGraph graph;
+  /// @brief View into the mapped cache, when the graph was loaded from one.
+  std::shared_ptr<const CompressedSparseRowGraph> cachedGraph;
 };
@@ -2,17 +2,18 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <filesystem>
 
 TEST(DefaultGraphLoader, creates_graph_with_4_vertices)
 {
   DefaultGraphLoader loader;
   const auto graph = loader.getGraph();
-  ASSERT_EQ(graph.m_vertices.size(), 4);
-  EXPECT_EQ(graph[0].position, Point2D({0.0, +1.0}));
-  EXPECT_EQ(graph[1].position, Point2D({1.0, -2.0}));
-  EXPECT_EQ(graph[2].position, Point2D({2.0, +3.0}));
-  EXPECT_EQ(graph[3].position, Point2D({3.0, -4.0}));
+  ASSERT_EQ(graph->m_vertices.size(), 4);
+  EXPECT_EQ((*graph)[0].position, Point2D({0.0, +1.0}));
+  EXPECT_EQ((*graph)[1].position, Point2D({1.0, -2.0}));
+  EXPECT_EQ((*graph)[2].position, Point2D({2.0, +3.0}));
+  EXPECT_EQ((*graph)[3].position, Point2D({3.0, -4.0}));
 }
 
 TEST(MapGraphLoader, loads_test_data)
@@ -20,7 +21,60 @@ TEST(MapGraphLoader, loads_test_data)
   MapGraphLoader loader(
       std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/sample_test/test.map").make_preferred().string());
   const auto graph = loader.getGraph();
-  ASSERT_EQ(graph.m_vertices.size(), 3);
+  ASSERT_EQ(graph->m_vertices.size(), 3);
+}
+
+TEST(MapGraphLoader, shares_one_graph_instead_of_copying_it)
+{
+  MapGraphLoader loader(
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/sample_test/test.map").make_preferred().string());
+  EXPECT_EQ(loader.getGraph().get(), loader.getGraph().get());
+}
+
+TEST(MapGraphLoader, keeps_vertex_index_maps_consistent_for_every_vertex_ordering)
+{
+  const std::string filename =
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/maze-32-32-2/maze-32-32-2.map")
+          .make_preferred()
+          .string();
+  MapGraphLoader rowMajorLoader(filename);
+  const auto& rowMajorGraph = *rowMajorLoader.getGraph();
+
+  for (auto ordering : {VertexOrdering::Morton, VertexOrdering::Hilbert, VertexOrdering::BreadthFirst})
+  {
+    MapGraphLoader loader(filename, ordering);
+    const auto& graph = *loader.getGraph();
+    ASSERT_EQ(boost::num_vertices(graph), boost::num_vertices(rowMajorGraph));
+    ASSERT_EQ(boost::num_edges(graph), boost::num_edges(rowMajorGraph));
+
+    for (unsigned vertex = 0; vertex < boost::num_vertices(graph); ++vertex)
+    {
+      const auto [row, column] = loader.convertVertexIndexToMapPosition(vertex);
+      EXPECT_EQ(loader.convertMapPositionToVertexIndex(row, column), vertex);
+      EXPECT_EQ(graph[vertex].position, Point2D({float(row), float(column)}));
+
+      // Same neighbors as in the row-major numbering, translated through the map positions
+      const unsigned rowMajorVertex = *rowMajorLoader.convertMapPositionToVertexIndex(row, column);
+      std::vector<std::pair<size_t, size_t>> neighbors;
+      for_each_out_edge(
+          graph,
+          vertex,
+          [&](Vertex target, Distance)
+          { neighbors.push_back(loader.convertVertexIndexToMapPosition(static_cast<unsigned>(target))); });
+      std::vector<std::pair<size_t, size_t>> expectedNeighbors;
+      for_each_out_edge(
+          rowMajorGraph,
+          rowMajorVertex,
+          [&](Vertex target, Distance)
+          {
+            expectedNeighbors.push_back(
+                rowMajorLoader.convertVertexIndexToMapPosition(static_cast<unsigned>(target)));
+          });
+      std::sort(neighbors.begin(), neighbors.end());
+      std::sort(expectedNeighbors.begin(), expectedNeighbors.end());
+      EXPECT_EQ(neighbors, expectedNeighbors);
+    }
+  }
 }
 
 TEST(intersection, returns_all_shared_vertices_of_the_paths)
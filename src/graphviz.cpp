@@ -46,7 +46,7 @@ std::map<EdgeKeyType, std::string> getEdgeColors(const std::vector<Runner> &runn
   return edge_colors;
 }
 
-std::string print_graph_to_dot_file(WeightedDiGraph &graph, const std::vector<Runner> &runners = {})
+std::string print_graph_to_dot_file(const WeightedDiGraph &graph, const std::vector<Runner> &runners = {})
 {
   std::vector<std::string> vertexColors = getVertexColors(graph, runners);
   std::map<EdgeKeyType, std::string> edge_colors = getEdgeColors(runners);
@@ -75,7 +75,7 @@ std::string print_graph_to_dot_file(WeightedDiGraph &graph, const std::vector<Ru
 }
 
 void write_graph_to_dot_file(
-    const std::filesystem::path &filename, WeightedDiGraph &graph, const std::vector<Runner> &runners)
+    const std::filesystem::path &filename, const WeightedDiGraph &graph, const std::vector<Runner> &runners)
 {
   const std::string graphDotFileContent = print_graph_to_dot_file(graph, runners);
   std::ofstream graph_dot_file_stream(filename);
@@ -7,4 +7,4 @@
 #include "runner.h"
 
 void write_graph_to_dot_file(
-    const std::filesystem::path &filename, WeightedDiGraph &graph, const std::vector<Runner> &runners = {});
+    const std::filesystem::path &filename, const WeightedDiGraph &graph, const std::vector<Runner> &runners = {});
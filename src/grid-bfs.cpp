@@ -0,0 +1,145 @@
+#include "grid-bfs.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <utility>
+
+namespace
+{
+typedef GridGraph::Word Word;
+constexpr Distance Unreachable = std::numeric_limits<Distance>::max();
+
+// Searches from up to 64 `sources` at once, filling the rows of `matrix` from `firstRow` on
+void search_distance_fields(
+    const GridGraph& graph, const Vertex* sources, size_t numberOfSources, DistanceMatrix& matrix, size_t firstRow)
+{
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  // Bit `i` of a vertex's words stands for `sources[i]`
+  std::vector<Word> visited(numberOfVertices, 0);
+  std::vector<Word> frontier(numberOfVertices, 0);
+  std::vector<Word> next(numberOfVertices, 0);
+  std::vector<Vertex> frontierVertices;
+  std::vector<Vertex> nextVertices;
+  for (size_t index = 0; index < numberOfSources; ++index)
+  {
+    const Vertex source = sources[index];
+    if (!frontier[source]) frontierVertices.push_back(source);
+    frontier[source] |= Word(1) << index;
+    visited[source] |= Word(1) << index;
+    matrix.getRow(firstRow + index)[source] = 0.0f;
+  }
+
+  for (unsigned step = 1; !frontierVertices.empty(); ++step)
+  {
+    nextVertices.clear();
+    for (const Vertex vertex : frontierVertices)
+    {
+      const Word sourcesOfVertex = frontier[vertex];
+      for_each_out_edge(
+          graph,
+          vertex,
+          [&](Vertex neighbor, Distance)
+          {
+            const Word reached = sourcesOfVertex & ~visited[neighbor];
+            if (!reached) return;
+            if (!next[neighbor]) nextVertices.push_back(neighbor);
+            next[neighbor] |= reached;
+          });
+    }
+    for (const Vertex vertex : frontierVertices)
+    {
+      frontier[vertex] = 0;
+    }
+    for (const Vertex vertex : nextVertices)
+    {
+      visited[vertex] |= next[vertex];
+      for (Word reached = next[vertex]; reached; reached &= reached - 1)
+      {
+        matrix.getRow(firstRow + static_cast<size_t>(std::countr_zero(reached)))[vertex] = static_cast<Distance>(step);
+      }
+      frontier[vertex] = next[vertex];
+      next[vertex] = 0;
+    }
+    std::swap(frontierVertices, nextVertices);
+  }
+}
+}  // namespace
+
+std::vector<Distance> grid_bfs_distances(const GridGraph& graph, Vertex source)
+{
+  const size_t height = graph.getHeight();
+  const size_t wordsPerRow = GridGraph::getWordsPerRow(graph.getWidth());
+  const std::vector<Word>& passability = graph.getPassability();
+  std::vector<Distance> distances(graph.getNumberOfVertices(), Unreachable);
+  std::vector<Word> visited(passability.size(), 0);
+  std::vector<Word> frontier(passability.size(), 0);
+  // Cleared again after every step, so that only the rows written by a step hold bits
+  std::vector<Word> next(passability.size(), 0);
+
+  const auto [sourceRow, sourceColumn] = graph.convertVertexIndexToMapPosition(source);
+  const size_t sourceWord = sourceRow * wordsPerRow + sourceColumn / GridGraph::BitsPerWord;
+  frontier[sourceWord] = visited[sourceWord] = Word(1) << (sourceColumn % GridGraph::BitsPerWord);
+  distances[source] = 0.0f;
+
+  // Rows holding the frontier, as only they and the rows next to them can change
+  size_t firstRow = sourceRow;
+  size_t lastRow = sourceRow;
+  for (unsigned step = 1;; ++step)
+  {
+    const size_t beginRow = firstRow > 0 ? firstRow - 1 : 0;
+    const size_t endRow = std::min(lastRow + 2, height);
+    size_t firstNextRow = height;
+    size_t lastNextRow = 0;
+    for (size_t row = beginRow; row < endRow; ++row)
+    {
+      for (size_t column = 0; column < wordsPerRow; ++column)
+      {
+        const size_t word = row * wordsPerRow + column;
+        const Word cells = frontier[word];
+        // Right and left neighbors, carrying the cells at the ends of the neighboring words
+        Word reached = (cells << 1) | (cells >> 1);
+        if (column > 0) reached |= frontier[word - 1] >> (GridGraph::BitsPerWord - 1);
+        if (column + 1 < wordsPerRow) reached |= frontier[word + 1] << (GridGraph::BitsPerWord - 1);
+        // Neighbors below and above
+        if (row > 0) reached |= frontier[word - wordsPerRow];
+        if (row + 1 < height) reached |= frontier[word + wordsPerRow];
+        reached &= passability[word] & ~visited[word];
+        if (!reached) continue;
+
+        next[word] = reached;
+        visited[word] |= reached;
+        firstNextRow = std::min(firstNextRow, row);
+        lastNextRow = std::max(lastNextRow, row);
+        for (Word cell = reached; cell; cell &= cell - 1)
+        {
+          const size_t cellColumn = column * GridGraph::BitsPerWord + static_cast<size_t>(std::countr_zero(cell));
+          distances[*graph.convertMapPositionToVertexIndex(row, cellColumn)] = static_cast<Distance>(step);
+        }
+      }
+    }
+    if (firstNextRow == height) break;
+
+    std::fill(frontier.begin() + firstRow * wordsPerRow, frontier.begin() + (lastRow + 1) * wordsPerRow, 0);
+    std::swap(frontier, next);
+    firstRow = firstNextRow;
+    lastRow = lastNextRow;
+  }
+  return distances;
+}
+
+DistanceMatrix grid_bfs_distance_fields(const GridGraph& graph, const std::vector<Vertex>& sources)
+{
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  DistanceMatrix matrix(sources.size(), numberOfVertices);
+  for (size_t row = 0; row < sources.size(); ++row)
+  {
+    std::fill(matrix.getRow(row), matrix.getRow(row) + numberOfVertices, Unreachable);
+  }
+  for (size_t first = 0; first < sources.size(); first += GridGraph::BitsPerWord)
+  {
+    const size_t count = std::min<size_t>(GridGraph::BitsPerWord, sources.size() - first);
+    search_distance_fields(graph, sources.data() + first, count, matrix, first);
+  }
+  return matrix;
+}
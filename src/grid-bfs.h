@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+#include "distance-matrix.h"
+#include "graph.h"
+#include "grid-graph.h"
+
+/// @brief Breadth-first distances from `source` to every vertex of a unit-weight grid, the maximum distance for the
+/// vertices it can't reach. The frontier is a bitmap like the passability of the grid, and each step expands a whole
+/// word of 64 cells at a time: shifted by one to the left and the right, carrying across neighboring words, and taken
+/// from the rows above and below, masked by the passable cells not visited yet.
+std::vector<Distance> grid_bfs_distances(const GridGraph& graph, Vertex source);
+
+/// @brief Breadth-first distance fields of many sources, row `i` of the matrix holding the distances from `sources[i]`
+/// to every vertex.
+///
+/// Sources are searched 64 at a time, one bit per source in a word per vertex. A vertex enters the frontier once with
+/// all the sources that reach it at the same step, so that sources close to each other, like the cells of one
+/// station, share their expansion instead of running one search each.
+DistanceMatrix grid_bfs_distance_fields(const GridGraph& graph, const std::vector<Vertex>& sources);
@@ -0,0 +1,68 @@
+#include "grid-bfs.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "path-finding.h"
+#include "test-data.h"
+
+TEST(grid_bfs, leaves_cells_behind_walls_unreachable)
+{
+  // Rows "..@." and ".@@.", numbered "01@2" and "3@@4": 2 and 4 are cut off from the others
+  const GridGraph graph(4, 2, {0b1011, 0b1001});
+  ASSERT_EQ(graph.getNumberOfVertices(), 5u);
+  const Distance unreachable = std::numeric_limits<Distance>::max();
+
+  EXPECT_EQ(grid_bfs_distances(graph, 0), (std::vector<Distance>{0.0f, 1.0f, unreachable, 1.0f, unreachable}));
+  EXPECT_EQ(grid_bfs_distances(graph, 4), (std::vector<Distance>{unreachable, unreachable, 1.0f, unreachable, 0.0f}));
+
+  const DistanceMatrix fields = grid_bfs_distance_fields(graph, {2, 1});
+  EXPECT_EQ(fields.getDistance(0, 4), 1.0f);
+  EXPECT_EQ(fields.getDistance(0, 0), unreachable);
+  EXPECT_EQ(fields.getDistance(1, 3), 2.0f);
+}
+
+TEST(grid_bfs, distances_match_dijkstra_across_word_boundaries)
+{
+  for (const std::string name : {"maze-32-32-2", "maze-128-128-1", "warehouse-10-20-10-2-1"})
+  {
+    GridGraphLoader loader(getMapFilename(name));
+    const GridGraph& graph = loader.getGraph();
+    const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+    SearchContext context;
+    for (Vertex source = 0; source < numberOfVertices; source += numberOfVertices / 5 + 1)
+    {
+      dijkstra_shortest_paths(graph, source, context);
+      const std::vector<Distance> distances = grid_bfs_distances(graph, source);
+      ASSERT_EQ(distances.size(), numberOfVertices);
+      for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+      {
+        ASSERT_EQ(distances[vertex], context.getDistance(vertex)) << name << ": " << source << " -> " << vertex;
+      }
+    }
+  }
+}
+
+TEST(grid_bfs, distance_fields_of_many_sources_match_single_source_searches)
+{
+  GridGraphLoader loader(getMapFilename("warehouse-10-20-10-2-1"));
+  const GridGraph& graph = loader.getGraph();
+  const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+  // More than one word of sources, some of them next to each other and one repeated
+  std::vector<Vertex> sources;
+  for (Vertex source = 0; source < 90; ++source)
+  {
+    sources.push_back(source * 37 % numberOfVertices);
+  }
+  sources.push_back(sources.front());
+
+  const DistanceMatrix fields = grid_bfs_distance_fields(graph, sources);
+  ASSERT_EQ(fields.getNumberOfSources(), sources.size());
+  ASSERT_EQ(fields.getNumberOfTargets(), numberOfVertices);
+  for (size_t row = 0; row < sources.size(); ++row)
+  {
+    const std::vector<Distance> distances = grid_bfs_distances(graph, sources[row]);
+    EXPECT_TRUE(std::equal(distances.begin(), distances.end(), fields.getRow(row))) << row;
+  }
+}
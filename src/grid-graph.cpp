@@ -0,0 +1,165 @@
+#include "grid-graph.h"
+
+#include <bit>
+#include <sstream>
+#include <stdexcept>
+
+#include "map-reader.h"
+
+GridGraph::GridGraph() : width(0), height(0), wordsPerRow(0), wordRanks(1, 0)
+{
+}
+
+GridGraph::GridGraph(unsigned width, unsigned height, std::vector<Word> passability)
+    : width(width), height(height), wordsPerRow(getWordsPerRow(width)), passability(std::move(passability))
+{
+  if (this->passability.size() != wordsPerRow * height)
+  {
+    std::ostringstream message;
+    message << "Invalid passability bitmap for " << width << "x" << height << " grid: expected "
+            << wordsPerRow * height << " words, got " << this->passability.size();
+    throw std::invalid_argument(message.str());
+  }
+  // Bits past the width in the last word of a row would be counted as vertices without a cell
+  if (width % BitsPerWord != 0)
+  {
+    const Word paddingMask = ~((Word(1) << (width % BitsPerWord)) - 1);
+    for (size_t row = 0; row < height; ++row)
+    {
+      if (this->passability[(row + 1) * wordsPerRow - 1] & paddingMask)
+      {
+        std::ostringstream message;
+        message << "Invalid passability bitmap for " << width << "x" << height
+                << " grid: bits past the width are set in row " << row;
+        throw std::invalid_argument(message.str());
+      }
+    }
+  }
+
+  wordRanks.reserve(this->passability.size() + 1);
+  uint32_t numberOfPassableCells = 0;
+  for (Word word : this->passability)
+  {
+    wordRanks.push_back(numberOfPassableCells);
+    numberOfPassableCells += static_cast<uint32_t>(std::popcount(word));
+  }
+  wordRanks.push_back(numberOfPassableCells);
+
+  vertexToCell.reserve(numberOfPassableCells);
+  for (size_t row = 0; row < height; ++row)
+  {
+    for (size_t column = 0; column < width; ++column)
+    {
+      if (isPassable(row, column))
+      {
+        vertexToCell.push_back(static_cast<uint32_t>(row * width + column));
+      }
+    }
+  }
+}
+
+size_t GridGraph::getWordsPerRow(unsigned width)
+{
+  return (width + BitsPerWord - 1) / BitsPerWord;
+}
+
+unsigned GridGraph::getWidth() const
+{
+  return width;
+}
+
+unsigned GridGraph::getHeight() const
+{
+  return height;
+}
+
+size_t GridGraph::getNumberOfVertices() const
+{
+  return vertexToCell.size();
+}
+
+const std::vector<GridGraph::Word>& GridGraph::getPassability() const
+{
+  return passability;
+}
+
+bool GridGraph::isPassable(size_t row, size_t column) const
+{
+  return (passability[row * wordsPerRow + column / BitsPerWord] >> (column % BitsPerWord)) & 1u;
+}
+
+size_t GridGraph::rank(size_t row, size_t column) const
+{
+  const size_t wordIndex = row * wordsPerRow + column / BitsPerWord;
+  const Word precedingCellsMask = (Word(1) << (column % BitsPerWord)) - 1;
+  return wordRanks[wordIndex] + std::popcount(passability[wordIndex] & precedingCellsMask);
+}
+
+std::optional<unsigned> GridGraph::convertMapPositionToVertexIndex(size_t row, size_t column) const
+{
+  if (row >= height || column >= width || !isPassable(row, column))
+  {
+    return std::nullopt;
+  }
+  return static_cast<unsigned>(rank(row, column));
+}
+
+std::pair<size_t, size_t> GridGraph::convertVertexIndexToMapPosition(Vertex vertex) const
+{
+  const size_t cell = vertexToCell[vertex];
+  return std::make_pair(cell / width, cell % width);
+}
+
+Point2D GridGraph::getPosition(Vertex vertex) const
+{
+  const auto [row, column] = convertVertexIndexToMapPosition(vertex);
+  return {float(row), float(column)};
+}
+
+size_t num_vertices(const GridGraph& graph)
+{
+  return graph.getNumberOfVertices();
+}
+
+Point2D vertex_position(const GridGraph& graph, Vertex vertex)
+{
+  return graph.getPosition(vertex);
+}
+
+GridGraphLoader::GridGraphLoader(const std::string& filename) : filename(filename)
+{
+  graph = readFile();
+}
+
+const GridGraph& GridGraphLoader::getGraph() const
+{
+  return graph;
+}
+
+const std::string& GridGraphLoader::getFilename() const
+{
+  return filename;
+}
+
+GridGraph GridGraphLoader::readFile()
+{
+  MapReader reader(filename);
+  const unsigned height = reader.getHeight();
+  const unsigned width = reader.getWidth();
+
+  const size_t wordsPerRow = GridGraph::getWordsPerRow(width);
+  std::vector<GridGraph::Word> passability(wordsPerRow * height, 0);
+  for (unsigned row = 0; row < height; ++row)
+  {
+    const std::string_view line = reader.readRow();
+    for (unsigned column = 0; column < width; ++column)
+    {
+      if (isVertexPassable(line[column]))
+      {
+        const size_t wordIndex = row * wordsPerRow + column / GridGraph::BitsPerWord;
+        passability[wordIndex] |= GridGraph::Word(1) << (column % GridGraph::BitsPerWord);
+      }
+    }
+  }
+  return GridGraph(width, height, std::move(passability));
+}
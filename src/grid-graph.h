@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geometry.h"
+#include "graph.h"
+
+/// @brief Implicit 4-connected grid graph. No edges are stored: neighbors of a cell are derived on the fly from a
+/// packed passability bitmap (one bit per cell, every row padded to whole 64-bit words).
+///
+/// Vertices are numbered like `MapGraphLoader` numbers them - passable cells in row-major order - so vertex indices,
+/// paths and job requests are interchangeable between both representations. A vertex costs 4 bytes (its cell index)
+/// plus 1.5 bits per cell for the bitmap and its per-word rank index.
+class GridGraph
+{
+ public:
+  typedef uint64_t Word;
+  static constexpr unsigned BitsPerWord = 64;
+  static constexpr Distance EdgeWeight = 1.0f;
+
+  GridGraph();
+  /// @param passability Row-major bitmap, `getWordsPerRow(width)` words per row. Bit `column % 64` of word
+  /// `row * getWordsPerRow(width) + column / 64` is set for passable cells, the bits past `width` are clear.
+  /// @throws std::invalid_argument if the bitmap has another number of words or bits past `width` are set.
+  GridGraph(unsigned width, unsigned height, std::vector<Word> passability);
+
+  static size_t getWordsPerRow(unsigned width);
+
+  unsigned getWidth() const;
+  unsigned getHeight() const;
+  size_t getNumberOfVertices() const;
+  const std::vector<Word>& getPassability() const;
+
+  bool isPassable(size_t row, size_t column) const;
+  std::optional<unsigned> convertMapPositionToVertexIndex(size_t row, size_t column) const;
+  std::pair<size_t, size_t> convertVertexIndexToMapPosition(Vertex vertex) const;
+  Point2D getPosition(Vertex vertex) const;
+
+  template <typename Visitor>
+  void forEachOutEdge(Vertex vertex, Visitor&& visitor) const
+  {
+    const size_t cell = vertexToCell[vertex];
+    const size_t row = cell / width;
+    const size_t column = cell % width;
+    // Same neighbor order as the edges `MapGraphLoader` inserts (left, top, right, bottom). Passable cells of one row
+    // are numbered consecutively, so the horizontal neighbors are the adjacent vertex indices.
+    if (column > 0 && isPassable(row, column - 1))
+    {
+      visitor(vertex - 1, EdgeWeight);
+    }
+    if (row > 0 && isPassable(row - 1, column))
+    {
+      visitor(static_cast<Vertex>(rank(row - 1, column)), EdgeWeight);
+    }
+    if (column + 1 < width && isPassable(row, column + 1))
+    {
+      visitor(vertex + 1, EdgeWeight);
+    }
+    if (row + 1 < height && isPassable(row + 1, column))
+    {
+      visitor(static_cast<Vertex>(rank(row + 1, column)), EdgeWeight);
+    }
+  }
+
+ private:
+  /// Number of passable cells preceding (row, column) in row-major order.
+  size_t rank(size_t row, size_t column) const;
+
+  unsigned width;
+  unsigned height;
+  size_t wordsPerRow;
+  std::vector<Word> passability;
+  /// Number of passable cells in all words preceding the given word.
+  std::vector<uint32_t> wordRanks;
+  std::vector<uint32_t> vertexToCell;
+};
+
+size_t num_vertices(const GridGraph& graph);
+Point2D vertex_position(const GridGraph& graph, Vertex vertex);
+
+template <typename Visitor>
+void for_each_out_edge(const GridGraph& graph, Vertex vertex, Visitor&& visitor)
+{
+  graph.forEachOutEdge(vertex, std::forward<Visitor>(visitor));
+}
+
+/// @brief Reads a `.map` file straight into a `GridGraph`, one row at a time, without building any edges or keeping
+/// the ASCII map around.
+class GridGraphLoader
+{
+ public:
+  GridGraphLoader(const std::string& filename);
+
+  GridGraphLoader() = delete;
+  GridGraphLoader(const GridGraphLoader&) = delete;
+  GridGraphLoader& operator=(const GridGraphLoader&) = delete;
+
+  const GridGraph& getGraph() const;
+  const std::string& getFilename() const;
+
+ private:
+  GridGraph readFile();
+
+  std::string filename;
+  GridGraph graph;
+};
@@ -0,0 +1,86 @@
+#include "grid-graph.h"
+
+#include <gtest/gtest.h>
+
+#include "test-data.h"
+
+TEST(GridGraph, is_empty_by_default)
+{
+  GridGraph graph;
+  EXPECT_EQ(graph.getNumberOfVertices(), 0u);
+}
+
+TEST(GridGraph, throws_exception_on_bitmap_of_wrong_size)
+{
+  EXPECT_THROW(GridGraph(65, 2, std::vector<GridGraph::Word>(2, 0)), std::invalid_argument);
+}
+
+TEST(GridGraph, throws_exception_on_bitmap_with_cells_past_the_width)
+{
+  EXPECT_THROW(GridGraph(3, 1, {GridGraph::Word(0b1111)}), std::invalid_argument);
+  EXPECT_THROW(GridGraph(65, 2, {0, 0, 0, GridGraph::Word(0b10)}), std::invalid_argument);
+  EXPECT_NO_THROW(GridGraph(65, 2, {~GridGraph::Word(0), 1, 0, 1}));
+  EXPECT_EQ(GridGraph(64, 1, {~GridGraph::Word(0)}).getNumberOfVertices(), 64u);
+}
+
+TEST(GridGraph, numbers_passable_cells_in_row_major_order)
+{
+  // Row 0: passable columns 0, 1 and 64; row 1: passable columns 1 and 64.
+  const GridGraph::Word one = 1;
+  GridGraph graph(65, 2, {one | (one << 1), one, one << 1, one});
+
+  ASSERT_EQ(graph.getNumberOfVertices(), 5u);
+  EXPECT_EQ(graph.convertMapPositionToVertexIndex(0, 0), 0u);
+  EXPECT_EQ(graph.convertMapPositionToVertexIndex(0, 1), 1u);
+  EXPECT_EQ(graph.convertMapPositionToVertexIndex(0, 2), std::nullopt);
+  EXPECT_EQ(graph.convertMapPositionToVertexIndex(0, 64), 2u);
+  EXPECT_EQ(graph.convertMapPositionToVertexIndex(1, 0), std::nullopt);
+  EXPECT_EQ(graph.convertMapPositionToVertexIndex(1, 1), 3u);
+  EXPECT_EQ(graph.convertMapPositionToVertexIndex(1, 64), 4u);
+  EXPECT_EQ(graph.convertMapPositionToVertexIndex(2, 0), std::nullopt);
+
+  EXPECT_EQ(graph.convertVertexIndexToMapPosition(2), std::make_pair(size_t(0), size_t(64)));
+  EXPECT_EQ(graph.getPosition(3), Point2D({1.0f, 1.0f}));
+
+  std::vector<Vertex> neighbors;
+  for_each_out_edge(graph, 1, [&neighbors](Vertex target, Distance) { neighbors.push_back(target); });
+  EXPECT_EQ(neighbors, std::vector<Vertex>({0, 3}));
+  neighbors.clear();
+  for_each_out_edge(graph, 4, [&neighbors](Vertex target, Distance) { neighbors.push_back(target); });
+  EXPECT_EQ(neighbors, std::vector<Vertex>({2}));
+}
+
+TEST(GridGraphLoader, loads_the_same_graph_as_map_graph_loader)
+{
+  for (const std::string name : {"maze-32-32-2", "warehouse-10-20-10-2-1"})
+  {
+    MapGraphLoader mapLoader(getMapFilename(name));
+    GridGraphLoader gridLoader(getMapFilename(name));
+    const auto& adjacencyListGraph = *mapLoader.getGraph();
+    const auto& graph = gridLoader.getGraph();
+
+    ASSERT_EQ(graph.getNumberOfVertices(), boost::num_vertices(adjacencyListGraph));
+    for (Vertex vertex = 0; vertex < graph.getNumberOfVertices(); ++vertex)
+    {
+      const auto [row, column] = mapLoader.convertVertexIndexToMapPosition(static_cast<unsigned>(vertex));
+      EXPECT_EQ(graph.convertVertexIndexToMapPosition(vertex), std::make_pair(row, column));
+      EXPECT_EQ(graph.convertMapPositionToVertexIndex(row, column), vertex);
+      EXPECT_EQ(graph.getPosition(vertex), adjacencyListGraph[vertex].position);
+
+      std::vector<std::pair<Vertex, Distance>> expectedOutEdges;
+      for_each_out_edge(
+          adjacencyListGraph,
+          vertex,
+          [&expectedOutEdges](Vertex target, Distance weight) { expectedOutEdges.emplace_back(target, weight); });
+      std::vector<std::pair<Vertex, Distance>> outEdges;
+      for_each_out_edge(
+          graph, vertex, [&outEdges](Vertex target, Distance weight) { outEdges.emplace_back(target, weight); });
+      EXPECT_EQ(outEdges, expectedOutEdges) << name << ", vertex " << vertex;
+    }
+  }
+}
+
+TEST(GridGraphLoader, throws_exception_if_file_does_not_exist)
+{
+  EXPECT_THROW(GridGraphLoader("does-not-exist.map"), std::runtime_error);
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "geometry.h"
+#include "graph.h"
+
+// Distance metrics of the offset `(dx, dy)` between a point and the goal. They are inline function objects, so that
+// they are inlined into the loops scoring a batch of points instead of being called per point.
+struct manhattan_metric {
+  Distance operator()(float dx, float dy) const
+  {
+    return std::abs(dx) + std::abs(dy);
+  }
+};
+
+struct euclidean_metric {
+  Distance operator()(float dx, float dy) const
+  {
+    return std::sqrt(dx * dx + dy * dy);
+  }
+};
+
+/// Distance on an 8-connected grid with diagonal moves of cost sqrt(2).
+struct octile_metric {
+  Distance operator()(float dx, float dy) const
+  {
+    const float diagonalSurcharge = std::sqrt(2.0f) - 1.0f;
+    dx = std::abs(dx);
+    dy = std::abs(dy);
+    return std::max(dx, dy) + diagonalSurcharge * std::min(dx, dy);
+  }
+};
+
+/// @brief `distances[i]` is the distance from `(x[i], y[i])` to `goal` by `Metric`, for every `i < count`. The points
+/// are read in sequence, so the loop is branch-free over contiguous arrays, which the compiler may vectorize.
+template <typename Metric>
+void metric_distances(const float* x, const float* y, size_t count, const Point2D& goal, Distance* distances)
+{
+  const Metric metric;
+  const float goalX = goal.x;
+  const float goalY = goal.y;
+  for (size_t index = 0; index < count; ++index)
+  {
+    distances[index] = metric(goalX - x[index], goalY - y[index]);
+  }
+}
+
+inline void manhattan_distances(const float* x, const float* y, size_t count, const Point2D& goal, Distance* distances)
+{
+  metric_distances<manhattan_metric>(x, y, count, goal, distances);
+}
+
+inline void euclidean_distances(const float* x, const float* y, size_t count, const Point2D& goal, Distance* distances)
+{
+  metric_distances<euclidean_metric>(x, y, count, goal, distances);
+}
+
+inline void octile_distances(const float* x, const float* y, size_t count, const Point2D& goal, Distance* distances)
+{
+  metric_distances<octile_metric>(x, y, count, goal, distances);
+}
+
+/// @brief Estimates the distance of vertices to a goal from their positions, one vertex at a time or all successors
+/// of an expanded vertex at once.
+///
+/// Graphs keeping their coordinates in x and y arrays (`CompressedSparseRowGraph`) are scored straight from them,
+/// loading the coordinates of each vertex by index; other graphs through `vertex_position`. Either way, the `Metric`
+/// is inlined into the loop over the batch, which saves a call per vertex. The loads by vertex index are gathers, so
+/// the loop isn't vectorized.
+template <typename Graph, typename Metric>
+class distance_heuristic
+{
+ public:
+  distance_heuristic(const Graph& graph, Vertex goal) : m_graph(graph), m_goal(vertex_position(graph, goal))
+  {
+  }
+
+  Distance operator()(Vertex v) const
+  {
+    Distance distance;
+    operator()(&v, 1, &distance);
+    return distance;
+  }
+
+  void operator()(const Vertex* vertices, size_t count, Distance* distances) const
+  {
+    const Metric metric;
+    if constexpr (requires { m_graph.getX(); m_graph.getY(); })
+    {
+      const float* x = m_graph.getX();
+      const float* y = m_graph.getY();
+      for (size_t index = 0; index < count; ++index)
+      {
+        distances[index] = metric(m_goal.x - x[vertices[index]], m_goal.y - y[vertices[index]]);
+      }
+    }
+    else
+    {
+      for (size_t index = 0; index < count; ++index)
+      {
+        const Point2D position = vertex_position(m_graph, vertices[index]);
+        distances[index] = metric(m_goal.x - position.x, m_goal.y - position.y);
+      }
+    }
+  }
+
+ private:
+  const Graph& m_graph;
+  Point2D m_goal;
+};
+
+template <typename Graph>
+class manhattan_distance_heuristic : public distance_heuristic<Graph, manhattan_metric>
+{
+ public:
+  manhattan_distance_heuristic(const Graph& graph, Vertex goal)
+      : distance_heuristic<Graph, manhattan_metric>(graph, goal)
+  {
+  }
+};
+
+template <typename Graph>
+class euclidean_distance_heuristic : public distance_heuristic<Graph, euclidean_metric>
+{
+ public:
+  euclidean_distance_heuristic(const Graph& graph, Vertex goal)
+      : distance_heuristic<Graph, euclidean_metric>(graph, goal)
+  {
+  }
+};
+
+template <typename Graph>
+class octile_distance_heuristic : public distance_heuristic<Graph, octile_metric>
+{
+ public:
+  octile_distance_heuristic(const Graph& graph, Vertex goal) : distance_heuristic<Graph, octile_metric>(graph, goal)
+  {
+  }
+};
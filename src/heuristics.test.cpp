@@ -0,0 +1,70 @@
+#include "heuristics.h"
+
+#include <gtest/gtest.h>
+
+#include "csr-graph.h"
+
+TEST(distance_kernels, score_every_point)
+{
+  const std::vector<float> x{0.0f, 3.0f, -3.0f, 1.0f, 5.0f};
+  const std::vector<float> y{0.0f, 4.0f, 4.0f, 1.0f, 0.0f};
+  std::vector<Distance> distances(x.size());
+
+  manhattan_distances(x.data(), y.data(), x.size(), {0.0f, 0.0f}, distances.data());
+  EXPECT_EQ(distances, std::vector<Distance>({0.0f, 7.0f, 7.0f, 2.0f, 5.0f}));
+
+  euclidean_distances(x.data(), y.data(), x.size(), {0.0f, 0.0f}, distances.data());
+  EXPECT_EQ(distances, std::vector<Distance>({0.0f, 5.0f, 5.0f, std::sqrt(2.0f), 5.0f}));
+
+  octile_distances(x.data(), y.data(), x.size(), {0.0f, 0.0f}, distances.data());
+  const float diagonal = std::sqrt(2.0f);
+  EXPECT_NEAR(distances[0], 0.0f, 1E-05);
+  EXPECT_NEAR(distances[1], 1.0f + 3.0f * diagonal, 1E-05);
+  EXPECT_NEAR(distances[2], 1.0f + 3.0f * diagonal, 1E-05);
+  EXPECT_NEAR(distances[3], diagonal, 1E-05);
+  EXPECT_NEAR(distances[4], 5.0f, 1E-05);
+}
+
+TEST(octile_distance_heuristic, distance)
+{
+  DefaultGraphLoader loader;
+  const auto graph = loader.getGraph();
+  octile_distance_heuristic heuristic(*graph, 3);
+  EXPECT_NEAR(heuristic(0), 5.0f + 3.0f * (std::sqrt(2.0f) - 1.0f), 1E-05);  // [0,1] - [3, -4]
+}
+
+TEST(distance_heuristic, batch_scores_every_vertex_by_its_position)
+{
+  const size_t numberOfVertices = 197;
+  WeightedDiGraph graph(numberOfVertices);
+  for (size_t index = 0; index < numberOfVertices; ++index)
+  {
+    graph[index].position = {float(index % 17), float(index / 17)};
+  }
+  const CompressedSparseRowGraph compressedGraph(graph);
+
+  std::vector<Vertex> vertices(numberOfVertices);
+  for (size_t index = 0; index < numberOfVertices; ++index)
+  {
+    vertices[index] = (index * 7) % numberOfVertices;
+  }
+
+  const Vertex goal = 42;
+  euclidean_distance_heuristic heuristic(graph, goal);
+  manhattan_distance_heuristic compressedHeuristic(compressedGraph, goal);
+  std::vector<Distance> distances(numberOfVertices);
+  std::vector<Distance> compressedDistances(numberOfVertices);
+  heuristic(vertices.data(), vertices.size(), distances.data());
+  compressedHeuristic(vertices.data(), vertices.size(), compressedDistances.data());
+  const Point2D goalPosition = graph[goal].position;
+  for (size_t index = 0; index < numberOfVertices; ++index)
+  {
+    const Point2D position = graph[vertices[index]].position;
+    const float dx = goalPosition.x - position.x;
+    const float dy = goalPosition.y - position.y;
+    EXPECT_FLOAT_EQ(distances[index], std::sqrt(dx * dx + dy * dy)) << vertices[index];
+    EXPECT_FLOAT_EQ(compressedDistances[index], std::abs(dx) + std::abs(dy)) << vertices[index];
+    EXPECT_EQ(heuristic(vertices[index]), distances[index]);
+    EXPECT_EQ(compressedHeuristic(vertices[index]), compressedDistances[index]);
+  }
+}
@@ -0,0 +1,431 @@
+#include "jump-point-search.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+#include "best-first-search.h"
+#include "heuristics.h"
+
+namespace
+{
+const ptrdiff_t rowSteps[4] = {0, -1, 0, 1};
+const ptrdiff_t columnSteps[4] = {-1, 0, 1, 0};
+
+bool isHorizontal(GridDirection direction)
+{
+  return direction == GridDirection::Left || direction == GridDirection::Right;
+}
+
+size_t getIndex(GridDirection direction)
+{
+  return static_cast<size_t>(direction);
+}
+
+bool isPassable(const GridGraph& graph, ptrdiff_t row, ptrdiff_t column)
+{
+  return row >= 0 && column >= 0 && row < ptrdiff_t(graph.getHeight()) && column < ptrdiff_t(graph.getWidth())
+      && graph.isPassable(size_t(row), size_t(column));
+}
+
+// Whether moving horizontally into (row, column), a cell above or below can only be reached shortest through it
+bool hasForcedNeighborHorizontally(const GridGraph& graph, ptrdiff_t row, ptrdiff_t column, ptrdiff_t columnStep)
+{
+  return (isPassable(graph, row - 1, column) && !isPassable(graph, row - 1, column - columnStep))
+      || (isPassable(graph, row + 1, column) && !isPassable(graph, row + 1, column - columnStep));
+}
+
+// Whether moving vertically into (row, column), a cell left or right can only be reached shortest through it
+bool hasForcedNeighborVertically(const GridGraph& graph, ptrdiff_t row, ptrdiff_t column, ptrdiff_t rowStep)
+{
+  return (isPassable(graph, row, column - 1) && !isPassable(graph, row - rowStep, column - 1))
+      || (isPassable(graph, row, column + 1) && !isPassable(graph, row - rowStep, column + 1));
+}
+
+// Jump distance of a cell from the one of the next cell in the same direction
+int32_t extendJump(int32_t nextDistance)
+{
+  return nextDistance > 0 ? nextDistance + 1 : nextDistance - 1;
+}
+}  // namespace
+
+JumpDistanceTable::JumpDistanceTable(const GridGraph& graph)
+    : graph(graph), distances(graph.getNumberOfVertices(), {0, 0, 0, 0})
+{
+  const auto height = ptrdiff_t(graph.getHeight());
+  const auto width = ptrdiff_t(graph.getWidth());
+  auto getDistances = [&](ptrdiff_t row, ptrdiff_t column) -> std::array<int32_t, 4>&
+  { return distances[*graph.convertMapPositionToVertexIndex(size_t(row), size_t(column))]; };
+
+  // Horizontal jumps first, as the vertical ones stop where a horizontal one finds a jump point
+  for (ptrdiff_t row = 0; row < height; ++row)
+  {
+    for (const GridDirection direction : {GridDirection::Left, GridDirection::Right})
+    {
+      const ptrdiff_t step = columnSteps[getIndex(direction)];
+      // Cells are visited from the end of the jumps, each extending the jump of the next cell
+      for (ptrdiff_t column = step > 0 ? width - 1 : 0; column >= 0 && column < width; column -= step)
+      {
+        if (!isPassable(graph, row, column)) continue;
+        const ptrdiff_t next = column + step;
+        int32_t& distance = getDistances(row, column)[getIndex(direction)];
+        if (!isPassable(graph, row, next))
+        {
+          distance = 0;
+        }
+        else if (hasForcedNeighborHorizontally(graph, row, next, step))
+        {
+          distance = 1;
+        }
+        else
+        {
+          distance = extendJump(getDistances(row, next)[getIndex(direction)]);
+        }
+      }
+    }
+  }
+
+  for (ptrdiff_t column = 0; column < width; ++column)
+  {
+    for (const GridDirection direction : {GridDirection::Up, GridDirection::Down})
+    {
+      const ptrdiff_t step = rowSteps[getIndex(direction)];
+      for (ptrdiff_t row = step > 0 ? height - 1 : 0; row >= 0 && row < height; row -= step)
+      {
+        if (!isPassable(graph, row, column)) continue;
+        const ptrdiff_t next = row + step;
+        int32_t& distance = getDistances(row, column)[getIndex(direction)];
+        if (!isPassable(graph, next, column))
+        {
+          distance = 0;
+          continue;
+        }
+        const auto& nextDistances = getDistances(next, column);
+        if (hasForcedNeighborVertically(graph, next, column, step)
+            || nextDistances[getIndex(GridDirection::Left)] > 0 || nextDistances[getIndex(GridDirection::Right)] > 0)
+        {
+          distance = 1;
+        }
+        else
+        {
+          distance = extendJump(nextDistances[getIndex(direction)]);
+        }
+      }
+    }
+  }
+}
+
+const GridGraph& JumpDistanceTable::getGraph() const
+{
+  return graph;
+}
+
+int32_t JumpDistanceTable::getJumpDistance(Vertex vertex, GridDirection direction) const
+{
+  return distances[vertex][getIndex(direction)];
+}
+
+JumpPointSearchSpace::JumpPointSearchSpace(
+    const GridGraph& graph,
+    Vertex start,
+    Vertex goal,
+    SearchContext& context,
+    const JumpDistanceTable* jumpDistances)
+    : graph(graph)
+    , jumpDistances(jumpDistances)
+    , context(context)
+    , start(start)
+    , goal(goal)
+    , goalCell(graph.convertVertexIndexToMapPosition(goal))
+{
+  context.startSearch(graph.getNumberOfVertices());
+  context.reach(start, 0.0f, start);
+}
+
+bool JumpPointSearchSpace::beginExpansion(Vertex state)
+{
+  if (context.isExpanded(state)) return false;
+  context.setExpanded(state);
+  return true;
+}
+
+void JumpPointSearchSpace::findJumpPoints(Vertex state)
+{
+  jumpPoints.clear();
+  const Cell cell = graph.convertVertexIndexToMapPosition(state);
+  const Vertex predecessor = context.getPredecessor(state);
+
+  std::array<GridDirection, 4> directions{
+      GridDirection::Left, GridDirection::Up, GridDirection::Right, GridDirection::Down};
+  size_t numberOfDirections = 4;
+  if (predecessor != state)
+  {
+    // Ahead and to both sides of the jump which reached the cell
+    const Cell predecessorCell = graph.convertVertexIndexToMapPosition(predecessor);
+    if (predecessorCell.first == cell.first)
+    {
+      directions = {
+          GridDirection::Up,
+          GridDirection::Down,
+          predecessorCell.second < cell.second ? GridDirection::Right : GridDirection::Left};
+    }
+    else
+    {
+      directions = {
+          GridDirection::Left,
+          GridDirection::Right,
+          predecessorCell.first < cell.first ? GridDirection::Down : GridDirection::Up};
+    }
+    numberOfDirections = 3;
+  }
+
+  for (size_t index = 0; index < numberOfDirections; ++index)
+  {
+    const auto jumpPoint = jump(cell, directions[index]);
+    if (!jumpPoint) continue;
+    const size_t steps = std::max(jumpPoint->first, cell.first) - std::min(jumpPoint->first, cell.first)
+        + std::max(jumpPoint->second, cell.second) - std::min(jumpPoint->second, cell.second);
+    jumpPoints.emplace_back(*graph.convertMapPositionToVertexIndex(jumpPoint->first, jumpPoint->second), steps);
+  }
+}
+
+std::optional<JumpPointSearchSpace::Cell> JumpPointSearchSpace::jump(Cell cell, GridDirection direction) const
+{
+  if (jumpDistances != nullptr) return lookUpJump(cell, direction);
+  if (isHorizontal(direction)) return jumpHorizontally(cell.first, cell.second, direction);
+  return jumpVertically(cell.first, cell.second, direction);
+}
+
+std::optional<JumpPointSearchSpace::Cell> JumpPointSearchSpace::jumpHorizontally(
+    size_t row, size_t column, GridDirection direction) const
+{
+  const ptrdiff_t step = columnSteps[getIndex(direction)];
+  const ptrdiff_t first = ptrdiff_t(column) + step;
+  if (first < 0 || first >= ptrdiff_t(graph.getWidth())) return std::nullopt;
+
+  const RowStop stop = scanRow(row, size_t(first), direction);
+  if (goalCell.first == row)
+  {
+    const auto goalColumn = ptrdiff_t(goalCell.second);
+    if (std::min(first, stop.column) <= goalColumn && goalColumn <= std::max(first, stop.column)) return goalCell;
+  }
+  if (stop.isWall) return std::nullopt;
+  return Cell(row, size_t(stop.column));
+}
+
+std::optional<JumpPointSearchSpace::Cell> JumpPointSearchSpace::jumpVertically(
+    size_t row, size_t column, GridDirection direction) const
+{
+  const ptrdiff_t step = rowSteps[getIndex(direction)];
+  for (auto current = ptrdiff_t(row) + step; isPassable(graph, current, ptrdiff_t(column)); current += step)
+  {
+    const Cell cell(size_t(current), column);
+    if (cell == goalCell || hasForcedNeighborVertically(graph, current, ptrdiff_t(column), step)
+        || jumpHorizontally(cell.first, column, GridDirection::Left)
+        || jumpHorizontally(cell.first, column, GridDirection::Right))
+    {
+      return cell;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<JumpPointSearchSpace::Cell> JumpPointSearchSpace::lookUpJump(Cell cell, GridDirection direction) const
+{
+  const int32_t distance =
+      jumpDistances->getJumpDistance(*graph.convertMapPositionToVertexIndex(cell.first, cell.second), direction);
+  const auto reach = ptrdiff_t(std::abs(distance));
+  const auto row = ptrdiff_t(cell.first);
+  const auto column = ptrdiff_t(cell.second);
+  const auto goalRow = ptrdiff_t(goalCell.first);
+  const auto goalColumn = ptrdiff_t(goalCell.second);
+  const ptrdiff_t rowStep = rowSteps[getIndex(direction)];
+  const ptrdiff_t columnStep = columnSteps[getIndex(direction)];
+
+  if (isHorizontal(direction))
+  {
+    const ptrdiff_t goalSteps = (goalColumn - column) * columnStep;
+    if (goalRow == row && goalSteps >= 1 && goalSteps <= reach) return goalCell;
+  }
+  else
+  {
+    const ptrdiff_t goalSteps = (goalRow - row) * rowStep;
+    if (goalSteps >= 1 && goalSteps <= reach)
+    {
+      if (goalColumn == column) return goalCell;
+      // The jump stops in the row of the goal if a horizontal jump from there finds it
+      const Cell crossing(size_t(goalRow), cell.second);
+      const GridDirection towardsGoal = goalColumn < column ? GridDirection::Left : GridDirection::Right;
+      const int32_t crossingDistance = jumpDistances->getJumpDistance(
+          *graph.convertMapPositionToVertexIndex(crossing.first, crossing.second), towardsGoal);
+      if (std::abs(goalColumn - column) <= std::abs(crossingDistance)) return crossing;
+    }
+  }
+
+  if (distance <= 0) return std::nullopt;
+  return Cell(size_t(row + rowStep * distance), size_t(column + columnStep * distance));
+}
+
+JumpPointSearchSpace::RowStop JumpPointSearchSpace::scanRow(
+    size_t row, size_t column, GridDirection direction) const
+{
+  typedef GridGraph::Word Word;
+  const unsigned bits = GridGraph::BitsPerWord;
+  const auto wordsPerRow = ptrdiff_t(GridGraph::getWordsPerRow(graph.getWidth()));
+  const std::vector<Word>& passability = graph.getPassability();
+  // Word of the row `rowOffset` rows away, 0 outside of the grid
+  auto getWord = [&](ptrdiff_t rowOffset, ptrdiff_t word) -> Word
+  {
+    const ptrdiff_t wordRow = ptrdiff_t(row) + rowOffset;
+    if (wordRow < 0 || wordRow >= ptrdiff_t(graph.getHeight()) || word < 0 || word >= wordsPerRow) return 0;
+    return passability[size_t(wordRow * wordsPerRow + word)];
+  };
+  // Cells whose neighbor above (below) is passable, but not the one above (below) the cell the jump came from, have a
+  // forced neighbor. The stops are those cells and the walls.
+  auto getStops = [&](ptrdiff_t word, Word aboveBehind, Word belowBehind) -> Word
+  { return ~getWord(0, word) | (getWord(-1, word) & ~aboveBehind) | (getWord(1, word) & ~belowBehind); };
+  auto toStop = [&](ptrdiff_t word, unsigned bit) -> RowStop
+  {
+    const ptrdiff_t stopColumn = word * ptrdiff_t(bits) + ptrdiff_t(bit);
+    return {stopColumn, ((getWord(0, word) >> bit) & 1u) == 0};
+  };
+
+  const auto firstWord = ptrdiff_t(column / bits);
+  const auto firstBit = unsigned(column % bits);
+  if (direction == GridDirection::Right)
+  {
+    for (ptrdiff_t word = firstWord; word < wordsPerRow; ++word)
+    {
+      Word stops = getStops(
+          word,
+          (getWord(-1, word) << 1) | (getWord(-1, word - 1) >> (bits - 1)),
+          (getWord(1, word) << 1) | (getWord(1, word - 1) >> (bits - 1)));
+      if (word == firstWord) stops &= ~Word(0) << firstBit;
+      if (stops != 0) return toStop(word, unsigned(std::countr_zero(stops)));
+    }
+    return {ptrdiff_t(graph.getWidth()), true};
+  }
+
+  for (ptrdiff_t word = firstWord; word >= 0; --word)
+  {
+    Word stops = getStops(
+        word,
+        (getWord(-1, word) >> 1) | (getWord(-1, word + 1) << (bits - 1)),
+        (getWord(1, word) >> 1) | (getWord(1, word + 1) << (bits - 1)));
+    if (word == firstWord) stops &= ~Word(0) >> (bits - 1 - firstBit);
+    if (stops != 0) return toStop(word, unsigned(bits - 1 - std::countl_zero(stops)));
+  }
+  return {-1, true};
+}
+
+Path JumpPointSearchSpace::getPath() const
+{
+  Path path;
+  if (!context.isReached(goal)) return path;
+
+  path.push_back(goal);
+  for (Vertex vertex = goal; vertex != start;)
+  {
+    const Vertex predecessor = context.getPredecessor(vertex);
+    const Cell to = graph.convertVertexIndexToMapPosition(predecessor);
+    Cell cell = graph.convertVertexIndexToMapPosition(vertex);
+    // Walk the straight jump back, cell by cell
+    while (cell != to)
+    {
+      if (cell.first != to.first)
+      {
+        cell.first = cell.first < to.first ? cell.first + 1 : cell.first - 1;
+      }
+      else
+      {
+        cell.second = cell.second < to.second ? cell.second + 1 : cell.second - 1;
+      }
+      path.push_back(*graph.convertMapPositionToVertexIndex(cell.first, cell.second));
+    }
+    vertex = predecessor;
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+namespace
+{
+Path jump_point_search(const GridGraph& graph, Vertex start, Vertex target, const JumpDistanceTable* jumpDistances)
+{
+  JumpPointSearchSpace space(graph, start, target, SearchContext::getThreadContext(), jumpDistances);
+  BinaryHeapOpenList<Vertex> openList;
+  NullSearchVisitor visitor;
+  best_first_search(space, start, manhattan_distance_heuristic<GridGraph>(graph, target), openList, visitor);
+  Path path = space.getPath();
+  if (path.empty())
+  {
+    std::ostringstream message;
+    message << "Unable to find path from " << start << " to " << target << std::endl;
+    throw std::runtime_error(message.str());
+  }
+  return path;
+}
+
+// The paths of Jump Point Search are numbered like the cells of the grid, so the graph they are planned for must be
+// too: same size, and every vertex at the position of the cell with its number (i.e. the row-major ordering)
+void check_numbering(const WeightedDiGraph& weightedGraph, const GridGraph& graph)
+{
+  check_calculator_graph(weightedGraph, graph.getNumberOfVertices(), "Jump Point Search");
+  for (Vertex vertex = 0; vertex < graph.getNumberOfVertices(); ++vertex)
+  {
+    const Point2D& position = vertex_position(weightedGraph, vertex);
+    if (!(position == graph.getPosition(vertex)))
+    {
+      std::ostringstream message;
+      message << "Jump Point Search needs the row-major vertex ordering, vertex " << vertex << " of the graph is at "
+              << position << " instead of " << graph.getPosition(vertex);
+      throw std::invalid_argument(message.str());
+    }
+  }
+}
+
+ShortestPathCalculator bind_calculator(
+    const GridGraph& graph, std::function<Path(const Vertex& start, const Vertex& target)> shortestPath)
+{
+  // Checking every vertex is linear, so it is done once per graph and not for every path
+  const WeightedDiGraph* checkedGraph = nullptr;
+  return [&graph, shortestPath = std::move(shortestPath), checkedGraph](
+             const WeightedDiGraph& weightedGraph, const Vertex& start, const Vertex& target) mutable
+  {
+    if (&weightedGraph != checkedGraph)
+    {
+      check_numbering(weightedGraph, graph);
+      checkedGraph = &weightedGraph;
+    }
+    return shortestPath(start, target);
+  };
+}
+}  // namespace
+
+Path jump_point_search_shortest_path(const GridGraph& graph, const Vertex& start, const Vertex& target)
+{
+  return jump_point_search(graph, start, target, nullptr);
+}
+
+Path jump_point_search_shortest_path(
+    const JumpDistanceTable& jumpDistances, const Vertex& start, const Vertex& target)
+{
+  return jump_point_search(jumpDistances.getGraph(), start, target, &jumpDistances);
+}
+
+ShortestPathCalculator jump_point_search_calculator(const GridGraph& graph)
+{
+  return bind_calculator(
+      graph, [&graph](const Vertex& start, const Vertex& target)
+      { return jump_point_search_shortest_path(graph, start, target); });
+}
+
+ShortestPathCalculator jump_point_search_calculator(const JumpDistanceTable& jumpDistances)
+{
+  return bind_calculator(
+      jumpDistances.getGraph(),
+      [&jumpDistances](const Vertex& start, const Vertex& target)
+      { return jump_point_search_shortest_path(jumpDistances, start, target); });
+}
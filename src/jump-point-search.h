@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "grid-graph.h"
+#include "path-finding.h"
+#include "search-context.h"
+
+/// @brief Moves on a 4-connected grid, in the neighbor order of `GridGraph`.
+enum class GridDirection : uint8_t { Left, Up, Right, Down };
+
+/// @brief Jump distances of JPS+: for every passable cell and direction, the number of steps to the next jump point
+/// that doesn't depend on the goal, or minus the number of steps before a wall if there is none. The jumps are those of
+/// `JumpPointSearchSpace`, so a query only adds the checks whether the goal lies on a jump.
+class JumpDistanceTable
+{
+ public:
+  explicit JumpDistanceTable(const GridGraph& graph);
+
+  const GridGraph& getGraph() const;
+  int32_t getJumpDistance(Vertex vertex, GridDirection direction) const;
+
+ private:
+  const GridGraph& graph;
+  /// Indexed by vertex, then by direction
+  std::vector<std::array<int32_t, 4>> distances;
+};
+
+/// @brief Search space of Jump Point Search on a 4-connected grid of unit-cost edges. Instead of its neighbors, an
+/// expanded cell generates the jump points straight ahead and to its sides: the first cells of these lines where an
+/// optimal path may turn, because a neighbor can't be reached as short a way without passing it (a forced neighbor),
+/// or because a horizontal jump from it finds a jump point, or the goal. Shortest paths differing only in the order of
+/// their moves are thus searched once, and the cells between jump points are never put into the open list.
+///
+/// Jumps scan a row word by word on the passability bitmap of the grid, or are looked up in a `JumpDistanceTable`
+/// (JPS+). Distances and predecessors of the jump points are kept in a `SearchContext`.
+class JumpPointSearchSpace
+{
+ public:
+  typedef Vertex State;
+
+  /// @param jumpDistances Table of the graph to look up the jumps in, or none to scan for them.
+  JumpPointSearchSpace(
+      const GridGraph& graph,
+      Vertex start,
+      Vertex goal,
+      SearchContext& context = SearchContext::getThreadContext(),
+      const JumpDistanceTable* jumpDistances = nullptr);
+
+  static Vertex getVertex(Vertex state)
+  {
+    return state;
+  }
+
+  bool isGoal(Vertex state) const
+  {
+    return state == goal;
+  }
+
+  bool beginExpansion(Vertex state);
+
+  template <typename Generate>
+  void forEachSuccessor(Vertex state, Generate&& generate)
+  {
+    findJumpPoints(state);
+    const Distance distance = context.getDistance(state);
+    for (const auto& [next, steps] : jumpPoints)
+    {
+      const Distance nextDistance = distance + static_cast<Distance>(steps) * GridGraph::EdgeWeight;
+      if (nextDistance < context.getDistance(next))
+      {
+        context.reach(next, nextDistance, state);
+        generate(next, nextDistance, 0.0f);
+      }
+    }
+  }
+
+  /// @brief Path through every cell from the start to the goal, or an empty path if the goal wasn't reached.
+  Path getPath() const;
+
+ private:
+  typedef std::pair<size_t, size_t> Cell;
+
+  /// Fills `jumpPoints` with the jump points reached from `state`, and the number of steps to each
+  void findJumpPoints(Vertex state);
+  std::optional<Cell> jump(Cell cell, GridDirection direction) const;
+  std::optional<Cell> jumpHorizontally(size_t row, size_t column, GridDirection direction) const;
+  std::optional<Cell> jumpVertically(size_t row, size_t column, GridDirection direction) const;
+  std::optional<Cell> lookUpJump(Cell cell, GridDirection direction) const;
+
+  /// First cell of a row at which a horizontal jump stops: a cell with a forced neighbor, or a wall
+  struct RowStop {
+    ptrdiff_t column;
+    bool isWall;
+  };
+  RowStop scanRow(size_t row, size_t column, GridDirection direction) const;
+
+  const GridGraph& graph;
+  const JumpDistanceTable* jumpDistances;
+  SearchContext& context;
+  Vertex start;
+  Vertex goal;
+  Cell goalCell;
+  std::vector<std::pair<Vertex, size_t>> jumpPoints;
+};
+
+/// @brief Jump Point Search, scanning the grid for jumps. Paths are as long as those of `a_star_shortest_path`.
+Path jump_point_search_shortest_path(const GridGraph& graph, const Vertex& start, const Vertex& target);
+/// @brief Jump Point Search with the precomputed jumps of JPS+.
+Path jump_point_search_shortest_path(
+    const JumpDistanceTable& jumpDistances, const Vertex& start, const Vertex& target);
+
+/// @brief Binds a Jump Point Search planner on `graph` to a `ShortestPathCalculator`. The search runs on the grid, so
+/// the `WeightedDiGraph` given to the calculator only names the vertices: it must be the graph `MapGraphLoader` loads
+/// from the same map in row-major ordering, or the calculator throws `std::invalid_argument` (checked once per graph).
+/// The grid (and table) must outlive the calculator.
+ShortestPathCalculator jump_point_search_calculator(const GridGraph& graph);
+ShortestPathCalculator jump_point_search_calculator(const JumpDistanceTable& jumpDistances);
@@ -0,0 +1,173 @@
+#include "jump-point-search.h"
+
+#include <gtest/gtest.h>
+
+#include "best-first-search.h"
+#include "test-data.h"
+
+namespace
+{
+// Grid from rows of '.' (passable) and '@' (blocked) cells
+GridGraph createGrid(const std::vector<std::string>& rows)
+{
+  const auto width = static_cast<unsigned>(rows.front().size());
+  const size_t wordsPerRow = GridGraph::getWordsPerRow(width);
+  std::vector<GridGraph::Word> passability(wordsPerRow * rows.size(), 0);
+  for (size_t row = 0; row < rows.size(); ++row)
+  {
+    for (size_t column = 0; column < width; ++column)
+    {
+      if (rows[row][column] == '.')
+      {
+        passability[row * wordsPerRow + column / GridGraph::BitsPerWord] |= GridGraph::Word(1)
+            << (column % GridGraph::BitsPerWord);
+      }
+    }
+  }
+  return GridGraph(width, static_cast<unsigned>(rows.size()), std::move(passability));
+}
+
+void expectValidPath(const GridGraph& graph, const Path& path, Vertex start, Vertex target)
+{
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path.front(), start);
+  EXPECT_EQ(path.back(), target);
+  for (size_t index = 1; index < path.size(); ++index)
+  {
+    bool isNeighbor = false;
+    for_each_out_edge(graph, path[index - 1], [&](Vertex next, Distance) { isNeighbor |= next == path[index]; });
+    ASSERT_TRUE(isNeighbor) << path[index - 1] << " -> " << path[index];
+  }
+}
+
+struct ExpansionCounter {
+  size_t examinedStates = 0;
+
+  void examineState(Vertex)
+  {
+    ++examinedStates;
+  }
+
+  void generateState(Vertex)
+  {
+  }
+};
+}  // namespace
+
+TEST(JumpDistanceTable, stores_distances_to_jump_points_and_walls)
+{
+  const GridGraph graph = createGrid({
+      ".....",
+      "...@.",
+      ".....",
+  });
+  const JumpDistanceTable table(graph);
+  // Moving right on the top row, the cell below (1, 4) is forced behind the wall (1, 3)
+  EXPECT_EQ(table.getJumpDistance(0, GridDirection::Right), 4);
+  EXPECT_EQ(table.getJumpDistance(4, GridDirection::Right), 0);
+  // Moving left, the cell below (1, 2) is forced behind the wall (1, 3), then there is none before the border
+  EXPECT_EQ(table.getJumpDistance(4, GridDirection::Left), 2);
+  EXPECT_EQ(table.getJumpDistance(2, GridDirection::Left), -2);
+  // Moving down the first column, a horizontal jump from (1, 0) finds no jump point, but one from (2, 0) does
+  EXPECT_EQ(table.getJumpDistance(0, GridDirection::Down), 2);
+  EXPECT_EQ(table.getJumpDistance(0, GridDirection::Up), 0);
+}
+
+TEST(JumpPointSearch, finds_shortest_paths_around_obstacles)
+{
+  const GridGraph graph = createGrid({
+      "..........",
+      ".@@@@@@@..",
+      "........@.",
+      "@@@@@@..@.",
+      "..........",
+  });
+  const JumpDistanceTable table(graph);
+  const Vertex start = *graph.convertMapPositionToVertexIndex(2, 0);
+  const Vertex target = *graph.convertMapPositionToVertexIndex(4, 0);
+  for (const Path& path :
+       {jump_point_search_shortest_path(graph, start, target), jump_point_search_shortest_path(table, start, target)})
+  {
+    expectValidPath(graph, path, start, target);
+    EXPECT_EQ(path.size(), 15u);
+  }
+  EXPECT_EQ(jump_point_search_shortest_path(graph, start, start), (Path{start}));
+}
+
+TEST(JumpPointSearch, paths_are_as_long_as_a_star_paths)
+{
+  for (const std::string name : {"maze-32-32-2", "maze-128-128-1", "warehouse-10-20-10-2-1"})
+  {
+    GridGraphLoader loader(getMapFilename(name));
+    const GridGraph& graph = loader.getGraph();
+    const JumpDistanceTable table(graph);
+    const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+    for (Vertex start = 0; start < numberOfVertices; start += numberOfVertices / 5 + 1)
+    {
+      for (Vertex target = 7; target < numberOfVertices; target += numberOfVertices / 17 + 1)
+      {
+        Path expected;
+        try
+        {
+          expected = a_star_shortest_path(graph, start, target);
+        } catch (const std::runtime_error&)
+        {
+          EXPECT_THROW(jump_point_search_shortest_path(graph, start, target), std::runtime_error);
+          EXPECT_THROW(jump_point_search_shortest_path(table, start, target), std::runtime_error);
+          continue;
+        }
+        const Path path = jump_point_search_shortest_path(graph, start, target);
+        expectValidPath(graph, path, start, target);
+        EXPECT_EQ(path.size(), expected.size()) << name << ": " << start << " -> " << target;
+        EXPECT_EQ(jump_point_search_shortest_path(table, start, target), path);
+      }
+    }
+  }
+}
+
+TEST(JumpPointSearch, expands_fewer_states_than_a_star_in_open_aisles)
+{
+  GridGraphLoader loader(getMapFilename("warehouse-20-40-10-2-1"));
+  const GridGraph& graph = loader.getGraph();
+  const JumpDistanceTable table(graph);
+  const Vertex start = 0;
+  const auto target = static_cast<Vertex>(graph.getNumberOfVertices() - 1);
+
+  VertexSearchSpace<GridGraph> aStarSpace(graph, start, target);
+  BinaryHeapOpenList<Vertex> aStarOpenList;
+  ExpansionCounter aStarCounter;
+  best_first_search(
+      aStarSpace, start, euclidean_distance_heuristic<GridGraph>(graph, target), aStarOpenList, aStarCounter);
+
+  JumpPointSearchSpace space(graph, start, target, SearchContext::getThreadContext(), &table);
+  BinaryHeapOpenList<Vertex> openList;
+  ExpansionCounter counter;
+  best_first_search(space, start, manhattan_distance_heuristic<GridGraph>(graph, target), openList, counter);
+
+  const Path path = space.getPath();
+  EXPECT_EQ(path.size(), a_star_shortest_path(graph, start, target).size());
+  EXPECT_LT(counter.examinedStates * 10, aStarCounter.examinedStates)
+      << counter.examinedStates << " vs. " << aStarCounter.examinedStates;
+}
+
+TEST(JumpPointSearch, binds_to_shortest_path_calculator_of_map_graph)
+{
+  const std::string filename = getMapFilename("maze-32-32-2");
+  GridGraphLoader gridLoader(filename);
+  MapGraphLoader loader(filename);
+  const auto graph = loader.getGraph();
+  const ShortestPathCalculator calculator = jump_point_search_calculator(gridLoader.getGraph());
+  const auto target = static_cast<Vertex>(num_vertices(*graph) - 1);
+  EXPECT_EQ(calculator(*graph, 0, target).size(), a_star_shortest_path(*graph, 0, target).size());
+}
+
+TEST(JumpPointSearch, calculator_rejects_graphs_not_numbered_like_its_grid)
+{
+  const std::string filename = getMapFilename("maze-32-32-2");
+  GridGraphLoader gridLoader(filename);
+  const ShortestPathCalculator calculator = jump_point_search_calculator(gridLoader.getGraph());
+  const auto otherGraph = MapGraphLoader(getMapFilename("maze-128-128-1")).getGraph();
+  EXPECT_THROW(calculator(*otherGraph, 0, 1), std::invalid_argument);
+  const auto hilbertGraph = MapGraphLoader(filename, VertexOrdering::Hilbert).getGraph();
+  EXPECT_THROW(calculator(*hilbertGraph, 0, 1), std::invalid_argument);
+}
@@ -0,0 +1,434 @@
+#include "landmarks.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "best-first-search.h"
+#include "graph-cache.h"
+#include "mapped-file.h"
+#include "search-context.h"
+
+struct LandmarkTable::Header
+{
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t selection;
+  uint64_t sourceHash;
+  uint64_t numberOfVertices;
+  uint64_t numberOfLandmarks;
+};
+
+namespace
+{
+constexpr std::array<char, 8> LandmarkTableMagic{'P', 'F', 'L', 'N', 'D', 'M', 'R', 'K'};
+constexpr size_t LandmarkTableAlignment = 8;
+constexpr Distance Infinity = std::numeric_limits<Distance>::max();
+
+size_t align(size_t size)
+{
+  return (size + LandmarkTableAlignment - 1) / LandmarkTableAlignment * LandmarkTableAlignment;
+}
+
+struct LandmarkArrays {
+  std::vector<uint32_t> landmarks;
+  std::vector<Distance> distancesFrom;
+  std::vector<Distance> distancesTo;
+};
+
+// Runs Dijkstra from `source` over all of `graph`, leaving the distances and the shortest path tree in `context`
+void search_from(const CompressedSparseRowGraph& graph, Vertex source, SearchContext& context)
+{
+  VertexSearchSpace<CompressedSparseRowGraph> space(graph, source, std::nullopt, context);
+  BinaryHeapOpenList<Vertex> openList;
+  NullSearchVisitor visitor;
+  best_first_search(space, source, ZeroHeuristic(), openList, visitor);
+}
+
+std::vector<Distance> get_distances(const SearchContext& context, size_t numberOfVertices)
+{
+  std::vector<Distance> distances(numberOfVertices);
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    distances[vertex] = context.getDistance(vertex);
+  }
+  return distances;
+}
+
+// Landmarks chosen so far with their distances, one array per landmark, while the table is being computed
+class LandmarkSelector
+{
+ public:
+  explicit LandmarkSelector(const CompressedSparseRowGraph& graph)
+      : graph(graph), reverseGraph(reverse_graph(graph)), numberOfVertices(graph.getNumberOfVertices())
+  {
+  }
+
+  void add(Vertex landmark)
+  {
+    landmarks.push_back(static_cast<uint32_t>(landmark));
+    search_from(graph, landmark, context);
+    distancesFrom.push_back(get_distances(context, numberOfVertices));
+    search_from(reverseGraph, landmark, context);
+    distancesTo.push_back(get_distances(context, numberOfVertices));
+  }
+
+  // The vertex whose distance from the closest landmark is largest, preferring those no landmark reaches
+  Vertex selectFarthest()
+  {
+    std::vector<Distance> closest;
+    if (landmarks.empty())
+    {
+      search_from(graph, 0, context);
+      closest = get_distances(context, numberOfVertices);
+    }
+    else
+    {
+      closest = distancesFrom.front();
+      for (const std::vector<Distance>& distances : distancesFrom)
+      {
+        for (size_t vertex = 0; vertex < numberOfVertices; ++vertex)
+        {
+          closest[vertex] = std::min(closest[vertex], distances[vertex]);
+        }
+      }
+    }
+    // The landmarks themselves are at distance 0, so they are only taken again if every vertex is
+    for (uint32_t landmark : landmarks)
+    {
+      closest[landmark] = -1.0f;
+    }
+    return static_cast<Vertex>(std::max_element(closest.begin(), closest.end()) - closest.begin());
+  }
+
+  // Grows a shortest path tree from a random root, weighs every vertex by how much its distance from the root exceeds
+  // the current lower bound, and descends from the root into the heaviest subtree without a landmark down to a leaf
+  std::optional<Vertex> selectAvoid(std::mt19937& random)
+  {
+    // Drawn straight from the engine, as the distributions of the standard libraries differ
+    auto root = static_cast<Vertex>(random() % numberOfVertices);
+    while (std::find(landmarks.begin(), landmarks.end(), root) != landmarks.end())
+    {
+      root = static_cast<Vertex>(random() % numberOfVertices);
+    }
+    search_from(graph, root, context);
+
+    std::vector<Vertex> tree;
+    for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+    {
+      if (context.isReached(vertex)) tree.push_back(vertex);
+    }
+    std::sort(
+        tree.begin(),
+        tree.end(),
+        [this](Vertex a, Vertex b) { return context.getDistance(a) > context.getDistance(b); });
+
+    std::vector<Distance> sizes(numberOfVertices, 0.0f);
+    std::vector<bool> hasLandmark(numberOfVertices, false);
+    for (uint32_t landmark : landmarks)
+    {
+      hasLandmark[landmark] = true;
+    }
+    const Vertex noChild = std::numeric_limits<Vertex>::max();
+    std::vector<Vertex> heaviestChildren(numberOfVertices, noChild);
+    // Children are farther from the root than their parents, so their subtrees are complete when they are visited
+    for (Vertex vertex : tree)
+    {
+      if (hasLandmark[vertex])
+      {
+        sizes[vertex] = 0.0f;
+      }
+      else
+      {
+        sizes[vertex] += context.getDistance(vertex) - getLowerBound(root, vertex);
+      }
+      if (vertex == root) continue;
+      const Vertex parent = context.getPredecessor(vertex);
+      hasLandmark[parent] = hasLandmark[parent] || hasLandmark[vertex];
+      sizes[parent] += sizes[vertex];
+      if (sizes[vertex] > 0.0f
+          && (heaviestChildren[parent] == noChild || sizes[vertex] > sizes[heaviestChildren[parent]]))
+      {
+        heaviestChildren[parent] = vertex;
+      }
+    }
+
+    Vertex vertex = root;
+    while (heaviestChildren[vertex] != noChild)
+    {
+      vertex = heaviestChildren[vertex];
+    }
+    if (vertex == root) return std::nullopt;
+    return vertex;
+  }
+
+  LandmarkArrays getArrays() const
+  {
+    const size_t numberOfLandmarks = landmarks.size();
+    LandmarkArrays arrays{
+        landmarks,
+        std::vector<Distance>(numberOfVertices * numberOfLandmarks),
+        std::vector<Distance>(numberOfVertices * numberOfLandmarks)};
+    for (size_t index = 0; index < numberOfLandmarks; ++index)
+    {
+      for (size_t vertex = 0; vertex < numberOfVertices; ++vertex)
+      {
+        arrays.distancesFrom[vertex * numberOfLandmarks + index] = distancesFrom[index][vertex];
+        arrays.distancesTo[vertex * numberOfLandmarks + index] = distancesTo[index][vertex];
+      }
+    }
+    return arrays;
+  }
+
+ private:
+  Distance getLowerBound(Vertex source, Vertex target) const
+  {
+    Distance bound = 0.0f;
+    for (size_t index = 0; index < landmarks.size(); ++index)
+    {
+      const std::vector<Distance>& from = distancesFrom[index];
+      const std::vector<Distance>& to = distancesTo[index];
+      if (from[source] != Infinity && from[target] != Infinity) bound = std::max(bound, from[target] - from[source]);
+      if (to[source] != Infinity && to[target] != Infinity) bound = std::max(bound, to[source] - to[target]);
+    }
+    return bound;
+  }
+
+  const CompressedSparseRowGraph& graph;
+  CompressedSparseRowGraph reverseGraph;
+  size_t numberOfVertices;
+  SearchContext context;
+  std::vector<uint32_t> landmarks;
+  std::vector<std::vector<Distance>> distancesFrom;
+  std::vector<std::vector<Distance>> distancesTo;
+};
+}  // namespace
+
+LandmarkTable::LandmarkTable(
+    const CompressedSparseRowGraph& graph, size_t numberOfLandmarks, LandmarkSelection selection)
+    : numberOfVertices(graph.getNumberOfVertices())
+    , numberOfLandmarks(std::min(numberOfLandmarks, graph.getNumberOfVertices()))
+    , selection(selection)
+    , sourceHash(0)
+{
+  LandmarkSelector selector(graph);
+  // Seeded, so that the same graph always gets the same landmarks
+  std::mt19937 random(42);
+  for (size_t index = 0; index < this->numberOfLandmarks; ++index)
+  {
+    std::optional<Vertex> landmark;
+    if (selection == LandmarkSelection::Avoid) landmark = selector.selectAvoid(random);
+    // The root is covered by the bounds already, or isolated: take a vertex far from all landmarks instead
+    if (!landmark) landmark = selector.selectFarthest();
+    selector.add(*landmark);
+  }
+
+  auto arrays = std::make_shared<const LandmarkArrays>(selector.getArrays());
+  landmarks = arrays->landmarks.data();
+  distancesFrom = arrays->distancesFrom.data();
+  distancesTo = arrays->distancesTo.data();
+  storage = arrays;
+}
+
+LandmarkTable::LandmarkTable(const std::string& filename)
+{
+  auto file = std::make_shared<const MappedFile>(filename);
+  auto invalid = [&filename](const std::string& reason)
+  {
+    std::ostringstream message;
+    message << "Failed to load landmark table '" << filename << "': " << reason;
+    return std::runtime_error(message.str());
+  };
+
+  if (file->size() < sizeof(Header))
+  {
+    throw invalid("file is too short");
+  }
+  const auto* header = reinterpret_cast<const Header*>(file->data());
+  if (header->magic != LandmarkTableMagic)
+  {
+    throw invalid("not a landmark table");
+  }
+  if (header->version != Version)
+  {
+    std::ostringstream reason;
+    reason << "expected version " << Version << ", got " << header->version;
+    throw invalid(reason.str());
+  }
+  if (header->numberOfVertices > file->size() || header->numberOfLandmarks > file->size())
+  {
+    throw invalid("array sizes exceed the file size");
+  }
+
+  numberOfVertices = static_cast<size_t>(header->numberOfVertices);
+  numberOfLandmarks = static_cast<size_t>(header->numberOfLandmarks);
+  selection = static_cast<LandmarkSelection>(header->selection);
+  sourceHash = header->sourceHash;
+  const size_t numberOfDistances = numberOfVertices * numberOfLandmarks;
+  const size_t expectedSize = align(sizeof(Header)) + align(numberOfLandmarks * sizeof(uint32_t))
+      + 2 * align(numberOfDistances * sizeof(Distance));
+  if (file->size() != expectedSize)
+  {
+    std::ostringstream reason;
+    reason << "expected " << expectedSize << " bytes, got " << file->size();
+    throw invalid(reason.str());
+  }
+
+  const char* position = file->data() + align(sizeof(Header));
+  landmarks = reinterpret_cast<const uint32_t*>(position);
+  if (std::any_of(
+          landmarks, landmarks + numberOfLandmarks, [this](uint32_t landmark) { return landmark >= numberOfVertices; }))
+  {
+    throw invalid("landmark is out of range");
+  }
+  position += align(numberOfLandmarks * sizeof(uint32_t));
+  distancesFrom = reinterpret_cast<const Distance*>(position);
+  position += align(numberOfDistances * sizeof(Distance));
+  distancesTo = reinterpret_cast<const Distance*>(position);
+  storage = file;
+}
+
+LandmarkTable LandmarkTable::loadOrCompute(
+    const std::string& filename,
+    uint64_t sourceHash,
+    const CompressedSparseRowGraph& graph,
+    size_t numberOfLandmarks,
+    LandmarkSelection selection)
+{
+  if (std::filesystem::exists(filename))
+  {
+    try
+    {
+      LandmarkTable table(filename);
+      if (table.getSourceHash() == sourceHash && table.getNumberOfVertices() == graph.getNumberOfVertices()
+          && table.getNumberOfLandmarks() == std::min(numberOfLandmarks, graph.getNumberOfVertices())
+          && table.getSelection() == selection)
+      {
+        return table;
+      }
+    } catch (const std::runtime_error&)
+    {
+      // Tables of another format version, or truncated ones, are recomputed
+    }
+  }
+
+  LandmarkTable table(graph, numberOfLandmarks, selection);
+  try
+  {
+    table.write(filename, sourceHash);
+  } catch (const std::runtime_error&)
+  {
+    // The file only saves computing the table next time, so e.g. a read-only directory just goes without one
+  }
+  table.sourceHash = sourceHash;
+  return table;
+}
+
+void LandmarkTable::write(const std::string& filename, uint64_t sourceHash) const
+{
+  // Written next to the target and renamed at the end, so that concurrent readers never map a half-written table
+  const std::string temporaryFilename = temporary_filename(filename);
+  auto failed = [&filename, &temporaryFilename]()
+  {
+    std::error_code error;
+    std::filesystem::remove(temporaryFilename, error);
+    std::ostringstream message;
+    message << "Failed to write landmark table '" << filename << "' from " << std::filesystem::current_path();
+    return std::runtime_error(message.str());
+  };
+  {
+    std::ofstream file(temporaryFilename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      throw failed();
+    }
+
+    auto write = [&file](const void* data, size_t size)
+    {
+      const char padding[LandmarkTableAlignment] = {};
+      file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+      file.write(padding, static_cast<std::streamsize>(align(size) - size));
+    };
+    const Header header{
+        LandmarkTableMagic,
+        Version,
+        static_cast<uint32_t>(selection),
+        sourceHash,
+        numberOfVertices,
+        numberOfLandmarks};
+    write(&header, sizeof(Header));
+    write(landmarks, numberOfLandmarks * sizeof(uint32_t));
+    write(distancesFrom, numberOfVertices * numberOfLandmarks * sizeof(Distance));
+    write(distancesTo, numberOfVertices * numberOfLandmarks * sizeof(Distance));
+    file.close();
+    if (!file)
+    {
+      throw failed();
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporaryFilename, filename, error);
+  if (error)
+  {
+    throw failed();
+  }
+}
+
+size_t LandmarkTable::getNumberOfVertices() const
+{
+  return numberOfVertices;
+}
+
+size_t LandmarkTable::getNumberOfLandmarks() const
+{
+  return numberOfLandmarks;
+}
+
+LandmarkSelection LandmarkTable::getSelection() const
+{
+  return selection;
+}
+
+uint64_t LandmarkTable::getSourceHash() const
+{
+  return sourceHash;
+}
+
+const uint32_t* LandmarkTable::getLandmarks() const
+{
+  return landmarks;
+}
+
+landmark_distance_heuristic::landmark_distance_heuristic(const LandmarkTable& landmarks, Vertex goal)
+    : m_landmarks(landmarks), m_goalFrom(landmarks.getNumberOfLandmarks()), m_goalTo(landmarks.getNumberOfLandmarks())
+{
+  for (size_t index = 0; index < landmarks.getNumberOfLandmarks(); ++index)
+  {
+    m_goalFrom[index] = landmarks.getDistanceFromLandmark(index, goal);
+    m_goalTo[index] = landmarks.getDistanceToLandmark(index, goal);
+  }
+}
+
+void landmark_distance_heuristic::operator()(const Vertex* vertices, size_t count, Distance* distances) const
+{
+  const size_t numberOfLandmarks = m_landmarks.getNumberOfLandmarks();
+  for (size_t index = 0; index < count; ++index)
+  {
+    // Terms with an infinite distance bound nothing, unless the goal is unreachable, which the search finds anyway
+    Distance bound = 0.0f;
+    for (size_t landmark = 0; landmark < numberOfLandmarks; ++landmark)
+    {
+      const Distance from = m_landmarks.getDistanceFromLandmark(landmark, vertices[index]);
+      const Distance to = m_landmarks.getDistanceToLandmark(landmark, vertices[index]);
+      if (from != Infinity && m_goalFrom[landmark] != Infinity) bound = std::max(bound, m_goalFrom[landmark] - from);
+      if (to != Infinity && m_goalTo[landmark] != Infinity) bound = std::max(bound, to - m_goalTo[landmark]);
+    }
+    distances[index] = bound;
+  }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "csr-graph.h"
+#include "graph.h"
+
+/// @brief How `LandmarkTable` places its landmarks.
+enum class LandmarkSelection {
+  /// Every landmark is the vertex farthest from the landmarks chosen before.
+  Farthest,
+  /// Goldberg and Harrelson's selection: a landmark is added in the largest subtree of a shortest path tree whose
+  /// vertices are badly covered by the bounds of the previous landmarks, so that it lies behind many of them.
+  Avoid
+};
+
+/// @brief Precomputed distances between every vertex and a few landmarks, which bound the distance of any two vertices
+/// from below by the triangle inequality (ALT: A*, landmarks, triangle inequality).
+///
+/// Both directions are stored, so that the bounds hold on directed graphs: the distances from every landmark (a
+/// Dijkstra search on the graph) and to every landmark (a search on its reverse graph), vertex by vertex so that the
+/// bounds of one vertex are read from contiguous memory. Unreachable pairs have an infinite distance. `Obstacles` don't
+/// invalidate the table, as a bound on the distance without them also bounds the longer distance around them.
+///
+/// Tables are persisted next to their map like a `GraphCache`: a versioned header followed by the landmarks and the
+/// distances in native byte order, which are memory-mapped when loaded.
+class LandmarkTable
+{
+ public:
+  static constexpr uint32_t Version = 1;
+
+  /// @brief Selects `numberOfLandmarks` landmarks (fewer if the graph has fewer vertices) and computes their distances.
+  LandmarkTable(
+      const CompressedSparseRowGraph& graph,
+      size_t numberOfLandmarks,
+      LandmarkSelection selection = LandmarkSelection::Avoid);
+  /// @throws std::runtime_error if the file can't be mapped, isn't a landmark table of this `Version`, is truncated or
+  /// has a landmark out of range.
+  explicit LandmarkTable(const std::string& filename);
+
+  /// @brief Loads the table from `filename` if it was computed for the map contents hashed to `sourceHash` (see
+  /// `hash_file`) with the same number of landmarks and selection, otherwise computes it and (re)writes the file if
+  /// possible.
+  static LandmarkTable loadOrCompute(
+      const std::string& filename,
+      uint64_t sourceHash,
+      const CompressedSparseRowGraph& graph,
+      size_t numberOfLandmarks,
+      LandmarkSelection selection = LandmarkSelection::Avoid);
+
+  /// @throws std::runtime_error if the file can't be written, leaving any previous table in place.
+  void write(const std::string& filename, uint64_t sourceHash) const;
+
+  size_t getNumberOfVertices() const;
+  size_t getNumberOfLandmarks() const;
+  LandmarkSelection getSelection() const;
+  /// @brief Hash of the source map given to `write` or read from the file, 0 for a table that was never written.
+  uint64_t getSourceHash() const;
+  const uint32_t* getLandmarks() const;
+
+  /// @brief Distance from the landmark at `landmarkIndex` to `vertex`.
+  Distance getDistanceFromLandmark(size_t landmarkIndex, Vertex vertex) const
+  {
+    return distancesFrom[vertex * numberOfLandmarks + landmarkIndex];
+  }
+
+  /// @brief Distance from `vertex` to the landmark at `landmarkIndex`.
+  Distance getDistanceToLandmark(size_t landmarkIndex, Vertex vertex) const
+  {
+    return distancesTo[vertex * numberOfLandmarks + landmarkIndex];
+  }
+
+ private:
+  struct Header;
+
+  std::shared_ptr<const void> storage;
+  size_t numberOfVertices;
+  size_t numberOfLandmarks;
+  LandmarkSelection selection;
+  uint64_t sourceHash;
+  const uint32_t* landmarks;
+  const Distance* distancesFrom;
+  const Distance* distancesTo;
+};
+
+/// @brief Lower bound of the distance to `goal` from the landmark distances: for every landmark `l`, both
+/// `d(l, goal) - d(l, v)` and `d(v, l) - d(goal, l)`, the largest of them. The bound is consistent, so A* with it
+/// still returns shortest paths. It scores batches of vertices like `distance_heuristic`.
+class landmark_distance_heuristic
+{
+ public:
+  landmark_distance_heuristic(const LandmarkTable& landmarks, Vertex goal);
+
+  Distance operator()(Vertex v) const
+  {
+    Distance distance;
+    operator()(&v, 1, &distance);
+    return distance;
+  }
+
+  void operator()(const Vertex* vertices, size_t count, Distance* distances) const;
+
+ private:
+  const LandmarkTable& m_landmarks;
+  /// Distances of the goal from and to every landmark
+  std::vector<Distance> m_goalFrom;
+  std::vector<Distance> m_goalTo;
+};
@@ -0,0 +1,243 @@
+#include "landmarks.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include "best-first-search.h"
+#include "graph-cache.h"
+#include "path-finding.h"
+#include "test-data.h"
+
+namespace
+{
+std::string getTableFilename(const std::string& name)
+{
+  const auto filename = std::filesystem::temp_directory_path() / ("path-finding-" + name + ".landmarks");
+  std::filesystem::remove(filename);
+  return filename.string();
+}
+
+struct ExpansionCounter {
+  size_t examinedStates = 0;
+
+  void examineState(Vertex)
+  {
+    ++examinedStates;
+  }
+
+  void generateState(Vertex)
+  {
+  }
+};
+
+template <typename Heuristic>
+size_t countExpansions(const CompressedSparseRowGraph& graph, Vertex start, Vertex goal, const Heuristic& heuristic)
+{
+  VertexSearchSpace<CompressedSparseRowGraph> space(graph, start, goal);
+  BinaryHeapOpenList<Vertex> openList;
+  ExpansionCounter counter;
+  best_first_search(space, start, heuristic, openList, counter);
+  return counter.examinedStates;
+}
+
+void expectSameTables(const LandmarkTable& expected, const LandmarkTable& actual)
+{
+  ASSERT_EQ(actual.getNumberOfVertices(), expected.getNumberOfVertices());
+  ASSERT_EQ(actual.getNumberOfLandmarks(), expected.getNumberOfLandmarks());
+  for (size_t index = 0; index < expected.getNumberOfLandmarks(); ++index)
+  {
+    EXPECT_EQ(actual.getLandmarks()[index], expected.getLandmarks()[index]);
+    for (Vertex vertex = 0; vertex < expected.getNumberOfVertices(); ++vertex)
+    {
+      EXPECT_EQ(actual.getDistanceFromLandmark(index, vertex), expected.getDistanceFromLandmark(index, vertex));
+      EXPECT_EQ(actual.getDistanceToLandmark(index, vertex), expected.getDistanceToLandmark(index, vertex));
+    }
+  }
+}
+}  // namespace
+
+TEST(LandmarkTable, stores_distances_in_both_directions_on_directed_graph)
+{
+  DefaultGraphLoader loader;
+  const CompressedSparseRowGraph graph(*loader.getGraph());
+  const LandmarkTable table(graph, 2, LandmarkSelection::Farthest);
+
+  ASSERT_EQ(table.getNumberOfLandmarks(), 2u);
+  // Vertex 1 is the first of the farthest from vertex 0, and vertex 0 is the first one vertex 1 doesn't reach
+  EXPECT_EQ(table.getLandmarks()[0], 1u);
+  EXPECT_EQ(table.getLandmarks()[1], 0u);
+  EXPECT_EQ(table.getDistanceToLandmark(0, 0), 2.0f);
+  EXPECT_EQ(table.getDistanceFromLandmark(0, 2), 1.0f);
+  EXPECT_EQ(table.getDistanceFromLandmark(0, 0), std::numeric_limits<Distance>::max());
+  EXPECT_EQ(table.getDistanceToLandmark(0, 2), std::numeric_limits<Distance>::max());
+  EXPECT_EQ(table.getDistanceFromLandmark(1, 3), 1.0f);
+  EXPECT_EQ(table.getDistanceToLandmark(1, 3), std::numeric_limits<Distance>::max());
+
+  EXPECT_EQ(landmark_distance_heuristic(table, 2)(0), 2.0f);
+  EXPECT_EQ(landmark_distance_heuristic(table, 2)(1), 1.0f);
+}
+
+TEST(LandmarkTable, selects_distinct_landmarks)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  for (const LandmarkSelection selection : {LandmarkSelection::Farthest, LandmarkSelection::Avoid})
+  {
+    const LandmarkTable table(graph, 8, selection);
+    ASSERT_EQ(table.getNumberOfLandmarks(), 8u);
+    const std::set<uint32_t> landmarks(table.getLandmarks(), table.getLandmarks() + 8);
+    EXPECT_EQ(landmarks.size(), 8u);
+    for (size_t index = 0; index < 8; ++index)
+    {
+      EXPECT_EQ(table.getDistanceFromLandmark(index, table.getLandmarks()[index]), 0.0f);
+    }
+  }
+  EXPECT_EQ(LandmarkTable(CompressedSparseRowGraph(), 4).getNumberOfLandmarks(), 0u);
+}
+
+TEST(landmark_distance_heuristic, bounds_distances_from_below_and_is_exact_towards_a_landmark)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+  const LandmarkTable table(graph, 4);
+
+  SearchContext context;
+  for (Vertex goal = 3; goal < numberOfVertices; goal += numberOfVertices / 11)
+  {
+    // Distances to the goal are distances from it, as the edges of the map graph go both ways
+    dijkstra_shortest_paths(graph, goal, context);
+    const landmark_distance_heuristic heuristic(table, goal);
+    for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+    {
+      EXPECT_LE(heuristic(vertex), context.getDistance(vertex)) << vertex << " -> " << goal;
+    }
+  }
+
+  const Vertex landmark = table.getLandmarks()[0];
+  dijkstra_shortest_paths(graph, landmark, context);
+  const landmark_distance_heuristic heuristic(table, landmark);
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    if (context.isReached(vertex))
+    {
+      EXPECT_EQ(heuristic(vertex), context.getDistance(vertex));
+    }
+  }
+}
+
+TEST(landmark_distance_heuristic, a_star_expands_fewer_states_and_finds_equally_short_paths)
+{
+  MapGraphLoader loader(getMapFilename("maze-128-128-1"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const auto& adjacencyListGraph = *loader.getGraph();
+  const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+  const LandmarkTable table(graph, 8);
+
+  size_t expansions = 0;
+  size_t landmarkExpansions = 0;
+  for (Vertex start = 5; start < numberOfVertices; start += numberOfVertices / 4)
+  {
+    for (Vertex target = 11; target < numberOfVertices; target += numberOfVertices / 5)
+    {
+      Path expected;
+      try
+      {
+        expected = a_star_shortest_path(graph, start, target);
+      } catch (const std::runtime_error&)
+      {
+        EXPECT_THROW(a_star_shortest_path(graph, start, target, table), std::runtime_error);
+        continue;
+      }
+      EXPECT_EQ(a_star_shortest_path(graph, start, target, table).size(), expected.size());
+      EXPECT_EQ(a_star_shortest_path(adjacencyListGraph, start, target, table).size(), expected.size());
+      expansions += countExpansions(graph, start, target, euclidean_distance_heuristic(graph, target));
+      landmarkExpansions += countExpansions(graph, start, target, landmark_distance_heuristic(table, target));
+    }
+  }
+  EXPECT_LT(landmarkExpansions * 2, expansions) << landmarkExpansions << " vs. " << expansions;
+
+  const ShortestPathCalculator calculator = a_star_calculator(table);
+  EXPECT_EQ(calculator(adjacencyListGraph, 0, 1), a_star_shortest_path(adjacencyListGraph, 0, 1, table));
+}
+
+TEST(landmark_distance_heuristic, guides_space_time_a_star)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const auto& adjacencyListGraph = *loader.getGraph();
+  const LandmarkTable table(graph, 4);
+  const Vertex start = 0;
+  const Path path = a_star_shortest_path(graph, start, static_cast<Vertex>(graph.getNumberOfVertices() - 1));
+  const Vertex target = path[path.size() / 2];
+
+  Constraints constraints(graph.getNumberOfVertices());
+  const Path spaceTimePath = space_time_a_star_shortest_path(graph, start, target, constraints, 0, table);
+  EXPECT_EQ(spaceTimePath.size(), path.size() / 2 + 1);
+  EXPECT_EQ(spaceTimePath.front(), start);
+  EXPECT_EQ(spaceTimePath.back(), target);
+
+  const MultiAgentShortestPathCalculator calculator = space_time_a_star_calculator(table);
+  EXPECT_EQ(calculator(adjacencyListGraph, start, target, constraints, 0), spaceTimePath);
+}
+
+TEST(LandmarkTable, is_written_and_loaded_again)
+{
+  const std::string mapFilename = getMapFilename("maze-32-32-2");
+  const std::string tableFilename = getTableFilename("maze-32-32-2");
+  MapGraphLoader loader(mapFilename);
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const uint64_t sourceHash = hash_file(mapFilename);
+
+  const LandmarkTable computed = LandmarkTable::loadOrCompute(tableFilename, sourceHash, graph, 4);
+  ASSERT_TRUE(std::filesystem::exists(tableFilename));
+  EXPECT_EQ(computed.getSourceHash(), sourceHash);
+
+  const LandmarkTable loaded(tableFilename);
+  EXPECT_EQ(loaded.getSourceHash(), sourceHash);
+  EXPECT_EQ(loaded.getSelection(), LandmarkSelection::Avoid);
+  expectSameTables(computed, loaded);
+  expectSameTables(computed, LandmarkTable::loadOrCompute(tableFilename, sourceHash, graph, 4));
+
+  // Another number of landmarks, or another map, computes the table again
+  EXPECT_EQ(LandmarkTable::loadOrCompute(tableFilename, sourceHash, graph, 2).getNumberOfLandmarks(), 2u);
+  EXPECT_EQ(LandmarkTable(tableFilename).getNumberOfLandmarks(), 2u);
+  LandmarkTable::loadOrCompute(tableFilename, sourceHash + 1, graph, 2);
+  EXPECT_EQ(LandmarkTable(tableFilename).getSourceHash(), sourceHash + 1);
+}
+
+TEST(LandmarkTable, throws_exception_on_invalid_file)
+{
+  const std::string tableFilename = getTableFilename("truncated");
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  LandmarkTable(loader.getCompressedGraph(), 2).write(tableFilename, 0);
+  std::filesystem::resize_file(tableFilename, std::filesystem::file_size(tableFilename) - 8);
+  EXPECT_THROW(LandmarkTable{tableFilename}, std::runtime_error);
+  EXPECT_THROW(LandmarkTable{"this-file-does-not-exist.landmarks"}, std::runtime_error);
+
+  // The landmarks are followed by both distance arrays, of two distances per vertex each
+  LandmarkTable table(loader.getCompressedGraph(), 2);
+  table.write(tableFilename, 0);
+  {
+    std::fstream file(tableFilename, std::ios::binary | std::ios::in | std::ios::out);
+    const auto distancesSize = static_cast<std::streamoff>(2 * 2 * table.getNumberOfVertices() * sizeof(Distance));
+    file.seekp(-distancesSize - static_cast<std::streamoff>(2 * sizeof(uint32_t)), std::ios::end);
+    const auto landmark = static_cast<uint32_t>(table.getNumberOfVertices());
+    file.write(reinterpret_cast<const char*>(&landmark), sizeof(landmark));
+  }
+  EXPECT_THROW(LandmarkTable{tableFilename}, std::runtime_error);
+}
+
+TEST(LandmarkTable, is_computed_when_it_cannot_be_written)
+{
+  const auto directory = std::filesystem::temp_directory_path() / "path-finding-missing-directory";
+  std::filesystem::remove_all(directory);
+  const std::string tableFilename = (directory / "maze-32-32-2.landmarks").string();
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const LandmarkTable table = LandmarkTable::loadOrCompute(tableFilename, 1, loader.getCompressedGraph(), 2);
+  EXPECT_EQ(table.getNumberOfLandmarks(), 2u);
+  EXPECT_FALSE(std::filesystem::exists(directory));
+}
@@ -19,7 +19,7 @@ std::string getVersion()
   return out.str();
 }
 
-void print_graph_statistics(/*const*/ WeightedDiGraph &graph)
+void print_graph_statistics(const WeightedDiGraph &graph)
 {
   std::cout << "Graph:" << std::endl;
   std::cout << " - vertices: " << graph.m_vertices.size() << std::endl;
@@ -60,13 +60,26 @@ const std::filesystem::path Warehouse_20_40_10_2_2_Even_1 =
 std::vector<Path> calculate_shortest_paths(
     const std::vector<JobRequest> &jobRequests, const WeightedDiGraph &graph, const unsigned numberOfRobots)
 {
-  std::vector<Path> paths;
+  // Jobs leaving from the same station are planned together, by one search settling all their targets
+  std::map<Vertex, std::vector<unsigned>> robotsByStart;
   for (unsigned robotIndex = 0; robotIndex < numberOfRobots; ++robotIndex)
   {
-    const auto &jobRequest = jobRequests[robotIndex];
-    Vertex start = vertex(jobRequest.startVertex, graph);
-    Vertex target = vertex(jobRequest.endVertex, graph);
-    paths.emplace_back(boost_dijkstra_shortest_path(graph, start, target));
+    robotsByStart[vertex(jobRequests[robotIndex].startVertex, graph)].push_back(robotIndex);
+  }
+
+  std::vector<Path> paths(numberOfRobots);
+  for (const auto &[start, robotIndices] : robotsByStart)
+  {
+    std::vector<Vertex> targets;
+    for (const unsigned robotIndex : robotIndices)
+    {
+      targets.push_back(vertex(jobRequests[robotIndex].endVertex, graph));
+    }
+    std::vector<Path> startPaths = multi_target_dijkstra_shortest_paths(graph, start, targets);
+    for (size_t index = 0; index < robotIndices.size(); ++index)
+    {
+      paths[robotIndices[index]] = std::move(startPaths[index]);
+    }
   }
   return paths;
 }
@@ -97,18 +110,21 @@ void run_scenario(const std::filesystem::path &scenarioFile)
   {
     std::cout << "Processing scenario " << scenarioFile << std::endl;
     FileScenarioLoader scenarioLoader(DataDirectory / scenarioFile);
-    const auto jobRequests = scenarioLoader.getjobRequests();
-    auto graph = scenarioLoader.getGraph();
-    print_graph_statistics(graph);
+    auto jobRequests = scenarioLoader.getjobRequests();
+    const SharedGraph graph = scenarioLoader.getGraph();
+    print_graph_statistics(*graph);
 
     const unsigned numberOfRobots =
-        std::min<unsigned>({3u, (unsigned)graph.m_vertices.size(), (unsigned)jobRequests.size()});
+        std::min<unsigned>({3u, (unsigned)graph->m_vertices.size(), (unsigned)jobRequests.size()});
     const unsigned timeout = (unsigned)1E+06;
-    Simulation simulation(jobRequests, graph, numberOfRobots, space_time_a_star_shortest_path);
+    // Distances to the goals are shared by all runners for the whole scenario
+    ReverseResumableSearchCache distancesToGoals{CompressedSparseRowGraph(*graph)};
+    Simulation simulation(
+        std::move(jobRequests), graph, numberOfRobots, space_time_a_star_calculator(distancesToGoals));
     simulation.advance();
     const auto scenarioDirectory = std::filesystem::path(scenarioFile).remove_filename();
     std::filesystem::create_directories(OutputDirectory / scenarioDirectory);
-    write_graph_to_dot_file(OutputDirectory / scenarioDirectory / "graph.dot", graph, simulation.getRunners());
+    write_graph_to_dot_file(OutputDirectory / scenarioDirectory / "graph.dot", *graph, simulation.getRunners());
 
     while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
     {
@@ -122,7 +138,7 @@ void run_scenario(const std::filesystem::path &scenarioFile)
 
     if (simulation.isDeadlock())
     {
-      write_graph_to_dot_file(OutputDirectory / scenarioDirectory / "deadlock.dot", graph, simulation.getRunners());
+      write_graph_to_dot_file(OutputDirectory / scenarioDirectory / "deadlock.dot", *graph, simulation.getRunners());
       std::cout << simulation.getTime() << " Deadlock. Runners wait for each other." << std::endl;
     }
 
@@ -0,0 +1,77 @@
+#include "map-reader.h"
+
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+
+#include "strings.h"
+
+MapReader::MapReader(const std::string& filename) : file(filename), position(0), width(0), height(0), row(0)
+{
+  readStaticHeaderLine("type octile");
+  height = readUnsignedValue("height");
+  width = readUnsignedValue("width");
+  readStaticHeaderLine("map");
+}
+
+unsigned MapReader::getWidth() const
+{
+  return width;
+}
+
+unsigned MapReader::getHeight() const
+{
+  return height;
+}
+
+std::string_view MapReader::readRow()
+{
+  const std::string_view line = getLine(std::string_view(file.data(), file.size()), position);
+  if (line.size() != width)
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << file.getFilename() << "': invalid format. Expected map row " << row
+            << " will have " << width << " characters, but got " << line.size();
+    throw std::invalid_argument(message.str());
+  }
+  ++row;
+  return line;
+}
+
+void MapReader::readStaticHeaderLine(std::string_view expectedLine)
+{
+  const std::string_view line = getLine(std::string_view(file.data(), file.size()), position);
+  if (line != expectedLine)
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << file.getFilename() << "': invalid format. Expected '" << expectedLine
+            << "', got '" << line << "'";
+    throw std::invalid_argument(message.str());
+  }
+}
+
+unsigned MapReader::readUnsignedValue(std::string_view expectedParameterTitle)
+{
+  const std::string_view line = getLine(std::string_view(file.data(), file.size()), position);
+  const size_t separator = line.find(' ');
+  const std::string_view label = line.substr(0, separator);
+  if (label != expectedParameterTitle)
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << file.getFilename() << "': invalid format. Expected '" << expectedParameterTitle
+            << "', got '" << label << "'";
+    throw std::invalid_argument(message.str());
+  }
+
+  const std::string_view stringValue = separator == std::string_view::npos ? "" : line.substr(separator + 1);
+  unsigned value = 0;
+  const auto [end, error] = std::from_chars(stringValue.data(), stringValue.data() + stringValue.size(), value);
+  if (error != std::errc() || end == stringValue.data())
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << file.getFilename() << "': invalid format. Expected " << expectedParameterTitle
+            << " to be a non-negative number, got '" << stringValue << "'";
+    throw std::invalid_argument(message.str());
+  }
+  return value;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "mapped-file.h"
+
+/// @brief Reads a `.map` file (format described at `MapGraphLoader::readFile`) straight from its memory mapping. The
+/// header is parsed on construction and `readRow` then returns the map rows one by one as views into the mapped file,
+/// so no row is ever copied.
+class MapReader
+{
+ public:
+  /// @throws std::runtime_error if the file can't be mapped, std::invalid_argument if its header is invalid.
+  explicit MapReader(const std::string& filename);
+
+  unsigned getWidth() const;
+  unsigned getHeight() const;
+
+  /// @brief Returns the next row of the map, `getWidth()` characters long. A trailing '\r' is not part of the row.
+  /// @throws std::invalid_argument if the row has another length.
+  std::string_view readRow();
+
+ private:
+  void readStaticHeaderLine(std::string_view expectedLine);
+  unsigned readUnsignedValue(std::string_view expectedParameterTitle);
+
+  MappedFile file;
+  size_t position;
+  unsigned width;
+  unsigned height;
+  unsigned row;
+};
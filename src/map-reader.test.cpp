@@ -0,0 +1,40 @@
+#include "map-reader.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+std::string writeMapFile(const std::string& name, const std::string& contents)
+{
+  const std::string filename = (std::filesystem::temp_directory_path() / ("path-finding-" + name + ".map")).string();
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file << contents;
+  return filename;
+}
+
+TEST(MapReader, returns_rows_without_line_endings)
+{
+  MapReader reader(writeMapFile("crlf", "type octile\r\nheight 2\r\nwidth 3\r\nmap\r\n.@.\r\nG.T"));
+  ASSERT_EQ(reader.getHeight(), 2u);
+  ASSERT_EQ(reader.getWidth(), 3u);
+  EXPECT_EQ(reader.readRow(), ".@.");
+  EXPECT_EQ(reader.readRow(), "G.T");
+}
+
+TEST(MapReader, throws_exception_on_invalid_format)
+{
+  EXPECT_THROW(MapReader(writeMapFile("type", "type tile\nheight 2\nwidth 3\nmap\n")), std::invalid_argument);
+  EXPECT_THROW(MapReader(writeMapFile("height", "type octile\nheight -2\nwidth 3\nmap\n")), std::invalid_argument);
+  EXPECT_THROW(MapReader(writeMapFile("label", "type octile\nwidth 3\nheight 2\nmap\n")), std::invalid_argument);
+
+  MapReader reader(writeMapFile("rows", "type octile\nheight 2\nwidth 3\nmap\n...\n..\n"));
+  EXPECT_EQ(reader.readRow(), "...");
+  EXPECT_THROW(reader.readRow(), std::invalid_argument);
+  EXPECT_THROW(reader.readRow(), std::invalid_argument);
+}
+
+TEST(MapReader, throws_exception_on_missing_file)
+{
+  EXPECT_THROW(MapReader("this-file-does-not-exist.map"), std::runtime_error);
+}
@@ -0,0 +1,119 @@
+#include "mapped-file.h"
+
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+void throwMappingError(const std::string& filename, const std::string& reason)
+{
+  std::ostringstream message;
+  message << "Failed to map '" << filename << "' from " << std::filesystem::current_path() << ": " << reason;
+  throw std::runtime_error(message.str());
+}
+}  // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filename)
+    : filename(filename), address(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+{
+  fileHandle = CreateFileA(
+      filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (fileHandle == INVALID_HANDLE_VALUE)
+  {
+    throwMappingError(filename, "can't open the file");
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(fileHandle, &fileSize))
+  {
+    CloseHandle(fileHandle);
+    throwMappingError(filename, "can't read the file size");
+  }
+  length = static_cast<size_t>(fileSize.QuadPart);
+  // Empty files can't be mapped, but have no data to map either
+  if (length > 0)
+  {
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+      if (mappingHandle) CloseHandle(mappingHandle);
+      CloseHandle(fileHandle);
+      throwMappingError(filename, "can't map the file");
+    }
+    address = static_cast<const char*>(view);
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (address) UnmapViewOfFile(address);
+  if (mappingHandle) CloseHandle(mappingHandle);
+  CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) : filename(filename), address(nullptr), length(0)
+{
+  const int descriptor = open(filename.c_str(), O_RDONLY);
+  if (descriptor < 0)
+  {
+    throwMappingError(filename, "can't open the file");
+  }
+  struct stat status;
+  if (fstat(descriptor, &status) != 0)
+  {
+    close(descriptor);
+    throwMappingError(filename, "can't read the file size");
+  }
+  length = static_cast<size_t>(status.st_size);
+  // Empty files can't be mapped, but have no data to map either
+  if (length > 0)
+  {
+    void* view = mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, 0);
+    if (view == MAP_FAILED)
+    {
+      close(descriptor);
+      throwMappingError(filename, "can't map the file");
+    }
+    address = static_cast<const char*>(view);
+  }
+  // The mapping stays valid after the descriptor is closed
+  close(descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+  if (address) munmap(const_cast<char*>(address), length);
+}
+
+#endif
+
+const std::string& MappedFile::getFilename() const
+{
+  return filename;
+}
+
+const char* MappedFile::data() const
+{
+  return address;
+}
+
+size_t MappedFile::size() const
+{
+  return length;
+}
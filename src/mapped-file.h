@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// @brief Read-only memory mapping of a whole file. Pages are read from disk on first access and shared with every
+/// other process mapping the same file.
+class MappedFile
+{
+ public:
+  /// @throws std::runtime_error if the file can't be opened or mapped.
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  MappedFile() = delete;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const std::string& getFilename() const;
+  const char* data() const;
+  size_t size() const;
+
+ private:
+  std::string filename;
+  const char* address;
+  size_t length;
+#ifdef _WIN32
+  void* fileHandle;
+  void* mappingHandle;
+#endif
+};
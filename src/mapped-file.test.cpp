@@ -0,0 +1,32 @@
+#include "mapped-file.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+TEST(MappedFile, maps_file_contents)
+{
+  const std::string filename = (std::filesystem::temp_directory_path() / "path-finding-mapped-file.txt").string();
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file << "type octile\nheight 4\n";
+  }
+
+  {
+    MappedFile mappedFile(filename);
+    ASSERT_EQ(mappedFile.size(), 21u);
+    EXPECT_EQ(std::string(mappedFile.data(), mappedFile.size()), "type octile\nheight 4\n");
+  }
+
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  }
+  MappedFile emptyFile(filename);
+  EXPECT_EQ(emptyFile.size(), 0u);
+}
+
+TEST(MappedFile, throws_exception_on_missing_file)
+{
+  EXPECT_THROW(MappedFile("this-file-does-not-exist.map"), std::runtime_error);
+}
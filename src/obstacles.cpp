@@ -0,0 +1,81 @@
+#include "obstacles.h"
+
+#include <algorithm>
+
+Obstacles::Obstacles(size_t numberOfVertices) : blockedVertices(numberOfVertices, false)
+{
+}
+
+bool Obstacles::blockVertex(Vertex vertex)
+{
+  if (blockedVertices[vertex])
+  {
+    return false;
+  }
+  blockedVertices[vertex] = true;
+  for (ObstacleListener* listener : listeners)
+  {
+    listener->onVertexBlocked(vertex);
+  }
+  return true;
+}
+
+bool Obstacles::unblockVertex(Vertex vertex)
+{
+  if (!blockedVertices[vertex])
+  {
+    return false;
+  }
+  blockedVertices[vertex] = false;
+  for (ObstacleListener* listener : listeners)
+  {
+    listener->onVertexUnblocked(vertex);
+  }
+  return true;
+}
+
+bool Obstacles::blockEdge(Vertex from, Vertex to)
+{
+  if (!blockedEdges.emplace(from, to).second)
+  {
+    return false;
+  }
+  for (ObstacleListener* listener : listeners)
+  {
+    listener->onEdgeBlocked(from, to);
+  }
+  return true;
+}
+
+bool Obstacles::unblockEdge(Vertex from, Vertex to)
+{
+  if (blockedEdges.erase(DirectedEdge(from, to)) == 0)
+  {
+    return false;
+  }
+  for (ObstacleListener* listener : listeners)
+  {
+    listener->onEdgeUnblocked(from, to);
+  }
+  return true;
+}
+
+bool Obstacles::isVertexBlocked(Vertex vertex) const
+{
+  return blockedVertices[vertex];
+}
+
+bool Obstacles::isEdgeBlocked(Vertex from, Vertex to) const
+{
+  return blockedEdges.count(DirectedEdge(from, to)) > 0;
+}
+
+void Obstacles::addListener(ObstacleListener& listener)
+{
+  listeners.push_back(&listener);
+}
+
+void Obstacles::removeListener(ObstacleListener& listener)
+{
+  listeners.erase(std::remove(listeners.begin(), listeners.end(), &listener), listeners.end());
+}
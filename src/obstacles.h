@@ -0,0 +1,55 @@
+#pragma once
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+
+/// @brief Told about every change of the `Obstacles` it is registered with, so that structures derived from the graph
+/// (constraints, planned paths) drop just the entries depending on the changed vertex or edge instead of being rebuilt.
+///
+/// Tables of distances on the graph without obstacles (`LandmarkTable`, `ReverseResumableSearchCache`) don't need to
+/// listen: obstacles only ever lengthen distances, so they stay consistent lower bounds. Tables of paths
+/// (`CompressedPathDatabase`, `ContractionHierarchy`) don't either, as their paths only reach the runners through
+/// `multi_agent_shortest_path_calculator_wrapper`, which replaces the paths crossing an obstacle.
+class ObstacleListener
+{
+ public:
+  virtual ~ObstacleListener() = default;
+
+  virtual void onVertexBlocked(Vertex vertex) = 0;
+  virtual void onVertexUnblocked(Vertex vertex) = 0;
+  virtual void onEdgeBlocked(Vertex from, Vertex to) = 0;
+  virtual void onEdgeUnblocked(Vertex from, Vertex to) = 0;
+};
+
+/// @brief Vertices and directed edges temporarily closed on an otherwise unchanged graph, e.g. cells covered by pallets
+/// or maintenance zones.
+class Obstacles
+{
+ public:
+  Obstacles() = delete;
+  explicit Obstacles(size_t numberOfVertices);
+
+  /// @brief Listeners are only notified about actual changes: blocking a blocked vertex returns false and does nothing.
+  bool blockVertex(Vertex vertex);
+  bool unblockVertex(Vertex vertex);
+  bool blockEdge(Vertex from, Vertex to);
+  bool unblockEdge(Vertex from, Vertex to);
+
+  bool isVertexBlocked(Vertex vertex) const;
+  bool isEdgeBlocked(Vertex from, Vertex to) const;
+
+  /// @brief Listeners are notified in the order they were added. They are not owned, so they have to be removed
+  /// before they are destroyed.
+  void addListener(ObstacleListener& listener);
+  void removeListener(ObstacleListener& listener);
+
+ private:
+  typedef std::pair<Vertex, Vertex> DirectedEdge;
+
+  std::vector<bool> blockedVertices;
+  std::set<DirectedEdge> blockedEdges;
+  std::vector<ObstacleListener*> listeners;
+};
@@ -0,0 +1,73 @@
+#include "obstacles.h"
+
+#include <gtest/gtest.h>
+
+class RecordingListener : public ObstacleListener
+{
+ public:
+  void onVertexBlocked(Vertex vertex) override
+  {
+    events.push_back("block " + std::to_string(vertex));
+  }
+  void onVertexUnblocked(Vertex vertex) override
+  {
+    events.push_back("unblock " + std::to_string(vertex));
+  }
+  void onEdgeBlocked(Vertex from, Vertex to) override
+  {
+    events.push_back("block " + std::to_string(from) + "->" + std::to_string(to));
+  }
+  void onEdgeUnblocked(Vertex from, Vertex to) override
+  {
+    events.push_back("unblock " + std::to_string(from) + "->" + std::to_string(to));
+  }
+
+  std::vector<std::string> events;
+};
+
+TEST(Obstacles, nothing_is_blocked_initially)
+{
+  Obstacles obstacles(4);
+  for (Vertex vertex = 0; vertex < 4; ++vertex)
+  {
+    EXPECT_FALSE(obstacles.isVertexBlocked(vertex));
+  }
+  EXPECT_FALSE(obstacles.isEdgeBlocked(0, 1));
+}
+
+TEST(Obstacles, blocks_and_unblocks_vertices_and_directed_edges)
+{
+  Obstacles obstacles(4);
+  EXPECT_TRUE(obstacles.blockVertex(2));
+  EXPECT_TRUE(obstacles.blockEdge(0, 1));
+  EXPECT_TRUE(obstacles.isVertexBlocked(2));
+  EXPECT_FALSE(obstacles.isVertexBlocked(1));
+  EXPECT_TRUE(obstacles.isEdgeBlocked(0, 1));
+  EXPECT_FALSE(obstacles.isEdgeBlocked(1, 0));
+
+  EXPECT_TRUE(obstacles.unblockVertex(2));
+  EXPECT_TRUE(obstacles.unblockEdge(0, 1));
+  EXPECT_FALSE(obstacles.isVertexBlocked(2));
+  EXPECT_FALSE(obstacles.isEdgeBlocked(0, 1));
+}
+
+TEST(Obstacles, notifies_listeners_about_changes_only)
+{
+  Obstacles obstacles(4);
+  RecordingListener listener;
+  obstacles.addListener(listener);
+
+  EXPECT_TRUE(obstacles.blockVertex(2));
+  EXPECT_FALSE(obstacles.blockVertex(2));
+  EXPECT_FALSE(obstacles.unblockVertex(3));
+  EXPECT_TRUE(obstacles.blockEdge(0, 1));
+  EXPECT_FALSE(obstacles.blockEdge(0, 1));
+  EXPECT_FALSE(obstacles.unblockEdge(1, 0));
+  EXPECT_TRUE(obstacles.unblockEdge(0, 1));
+  EXPECT_TRUE(obstacles.unblockVertex(2));
+  EXPECT_EQ(listener.events, (std::vector<std::string>{"block 2", "block 0->1", "unblock 0->1", "unblock 2"}));
+
+  obstacles.removeListener(listener);
+  obstacles.blockVertex(1);
+  EXPECT_EQ(listener.events.size(), 4u);
+}
@@ -0,0 +1,414 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+
+/// Open lists of `best_first_search`, besides `BinaryHeapOpenList`.
+///
+/// The bucketed lists and the radix heap are for integral (or fixed-point) costs. Priorities are converted to integral
+/// keys in multiples of a resolution, e.g. 1 for the unit-weight grids of `MapGraphLoader`. The order is exact if all
+/// edge weights are multiples of the resolution, and the returned paths stay shortest if additionally the heuristic is
+/// consistent: a goal taken from the list has a distance rounding to the minimum key, while every state on a shorter
+/// path would have a smaller key.
+///
+/// The lists are monotone: keys lower than the last taken key are raised to it, which never happens for Dijkstra and
+/// A* with a consistent heuristic.
+
+/// @brief Integral key of `priority` in multiples of `resolution`, rounded to absorb floating point errors of sums.
+inline uint64_t to_open_list_key(Distance priority, Distance resolution)
+{
+  return static_cast<uint64_t>(std::llround(priority / resolution));
+}
+
+/// @brief Bucketed queue (Dial's algorithm): one bucket per key in a circular array, which grows to the range of keys
+/// in the list. Pushing and taking a state are O(1), plus the scan over empty buckets. States of equal key are taken
+/// last in first out, which favours deeper states in A*.
+template <typename State>
+class BucketOpenList
+{
+ public:
+  explicit BucketOpenList(Distance resolution = 1.0f)
+      : resolution(resolution), buckets(16), size(0), minimumKey(0), maximumKey(0), lastKey(0)
+  {
+  }
+
+  bool empty() const
+  {
+    return size == 0;
+  }
+
+  void push(Distance priority, Distance /*distance*/, const State& state)
+  {
+    const uint64_t key = std::max(to_open_list_key(priority, resolution), lastKey);
+    if (size == 0)
+    {
+      minimumKey = key;
+      maximumKey = key;
+    }
+    reserve(std::min(key, minimumKey), std::max(key, maximumKey));
+    getBucket(key).push_back(state);
+    ++size;
+  }
+
+  State pop()
+  {
+    while (getBucket(minimumKey).empty())
+    {
+      ++minimumKey;
+    }
+    lastKey = minimumKey;
+    std::vector<State>& bucket = getBucket(minimumKey);
+    const State state = bucket.back();
+    bucket.pop_back();
+    --size;
+    return state;
+  }
+
+ private:
+  std::vector<State>& getBucket(uint64_t key)
+  {
+    return buckets[static_cast<size_t>(key & (buckets.size() - 1))];
+  }
+
+  // Grows the circular array, keeping its size a power of 2, until it holds the buckets from `lowKey` to `highKey`
+  void reserve(uint64_t lowKey, uint64_t highKey)
+  {
+    if (highKey - lowKey >= buckets.size())
+    {
+      size_t capacity = buckets.size();
+      while (highKey - lowKey >= capacity)
+      {
+        capacity *= 2;
+      }
+      std::vector<std::vector<State>> grown(capacity);
+      for (uint64_t key = minimumKey; key <= maximumKey; ++key)
+      {
+        grown[static_cast<size_t>(key & (capacity - 1))] = std::move(getBucket(key));
+      }
+      buckets = std::move(grown);
+    }
+    minimumKey = lowKey;
+    maximumKey = highKey;
+  }
+
+  Distance resolution;
+  std::vector<std::vector<State>> buckets;
+  size_t size;
+  /// Lower and upper bound of the keys in the list
+  uint64_t minimumKey;
+  uint64_t maximumKey;
+  uint64_t lastKey;
+};
+
+/// @brief Bucketed queue on two levels: the states of one priority key are bucketed again by the key of their
+/// distance, and the largest distance is taken first. Among states of equal priority (f), A* then prefers those
+/// closest to the goal (largest g), which expands fewer states on grids with many ties. An inner level holds a bucket
+/// per distance key, so it takes O(distance) memory, reused when the circular outer array wraps around.
+template <typename State>
+class TwoLevelBucketOpenList
+{
+ public:
+  explicit TwoLevelBucketOpenList(Distance resolution = 1.0f)
+      : resolution(resolution), buckets(16), size(0), minimumKey(0), maximumKey(0), lastKey(0)
+  {
+  }
+
+  bool empty() const
+  {
+    return size == 0;
+  }
+
+  void push(Distance priority, Distance distance, const State& state)
+  {
+    const uint64_t key = std::max(to_open_list_key(priority, resolution), lastKey);
+    if (size == 0)
+    {
+      minimumKey = key;
+      maximumKey = key;
+    }
+    reserve(std::min(key, minimumKey), std::max(key, maximumKey));
+
+    Bucket& bucket = getBucket(key);
+    const auto level = static_cast<size_t>(to_open_list_key(distance, resolution));
+    if (level >= bucket.levels.size())
+    {
+      bucket.levels.resize(level + 1);
+    }
+    bucket.levels[level].push_back(state);
+    bucket.top = std::max(bucket.top, level);
+    ++bucket.size;
+    ++size;
+  }
+
+  State pop()
+  {
+    while (getBucket(minimumKey).size == 0)
+    {
+      ++minimumKey;
+    }
+    lastKey = minimumKey;
+    Bucket& bucket = getBucket(minimumKey);
+    while (bucket.levels[bucket.top].empty())
+    {
+      --bucket.top;
+    }
+    std::vector<State>& level = bucket.levels[bucket.top];
+    const State state = level.back();
+    level.pop_back();
+    --bucket.size;
+    --size;
+    return state;
+  }
+
+ private:
+  struct Bucket {
+    std::vector<std::vector<State>> levels;
+    size_t size = 0;
+    /// Highest level which may hold states
+    size_t top = 0;
+  };
+
+  Bucket& getBucket(uint64_t key)
+  {
+    return buckets[static_cast<size_t>(key & (buckets.size() - 1))];
+  }
+
+  void reserve(uint64_t lowKey, uint64_t highKey)
+  {
+    if (highKey - lowKey >= buckets.size())
+    {
+      size_t capacity = buckets.size();
+      while (highKey - lowKey >= capacity)
+      {
+        capacity *= 2;
+      }
+      std::vector<Bucket> grown(capacity);
+      for (uint64_t key = minimumKey; key <= maximumKey; ++key)
+      {
+        grown[static_cast<size_t>(key & (capacity - 1))] = std::move(getBucket(key));
+      }
+      buckets = std::move(grown);
+    }
+    minimumKey = lowKey;
+    maximumKey = highKey;
+  }
+
+  Distance resolution;
+  std::vector<Bucket> buckets;
+  size_t size;
+  /// Lower and upper bound of the keys in the list
+  uint64_t minimumKey;
+  uint64_t maximumKey;
+  uint64_t lastKey;
+};
+
+/// @brief Radix heap: bucket `i` holds the keys whose highest bit differing from the last taken key is bit `i - 1`.
+/// When the lowest bucket runs empty, the next non-empty one is redistributed below its minimum, and every key moves
+/// down at most 64 times, so operations are amortized O(log C) for the largest edge cost C, with a fixed memory
+/// footprint whatever the range of keys.
+template <typename State>
+class RadixHeapOpenList
+{
+ public:
+  explicit RadixHeapOpenList(Distance resolution = 1.0f) : resolution(resolution), size(0), lastKey(0)
+  {
+  }
+
+  bool empty() const
+  {
+    return size == 0;
+  }
+
+  void push(Distance priority, Distance /*distance*/, const State& state)
+  {
+    const uint64_t key = std::max(to_open_list_key(priority, resolution), lastKey);
+    buckets[getBucketIndex(key)].emplace_back(key, state);
+    ++size;
+  }
+
+  State pop()
+  {
+    if (buckets[0].empty())
+    {
+      size_t index = 1;
+      while (buckets[index].empty())
+      {
+        ++index;
+      }
+      std::vector<Entry>& bucket = buckets[index];
+      lastKey = bucket.front().first;
+      for (const Entry& entry : bucket)
+      {
+        lastKey = std::min(lastKey, entry.first);
+      }
+      for (const Entry& entry : bucket)
+      {
+        buckets[getBucketIndex(entry.first)].push_back(entry);
+      }
+      bucket.clear();
+    }
+    const State state = buckets[0].back().second;
+    buckets[0].pop_back();
+    --size;
+    return state;
+  }
+
+ private:
+  typedef std::pair<uint64_t, State> Entry;
+
+  size_t getBucketIndex(uint64_t key) const
+  {
+    return static_cast<size_t>(std::bit_width(key ^ lastKey));
+  }
+
+  Distance resolution;
+  std::array<std::vector<Entry>, 65> buckets;
+  size_t size;
+  uint64_t lastKey;
+};
+
+/// @brief Indexed 4-ary heap with decrease-key: every state is at most once in the heap, and pushing a state already in
+/// it lowers its priority in place. The heap thus holds no stale duplicates and its size is bounded by the number of
+/// states, which must be indices below the number given to `reset`.
+///
+/// Nodes are 16 bytes, grouped by 4 siblings into cache lines: the root is the last node of the first line, so that
+/// the children of a node, compared against each other when sifting down, are read from a single line. States of equal
+/// priority are taken by descending distance, i.e. the ones closest to the goal first in A*.
+template <typename State>
+class IndexedHeapOpenList
+{
+ public:
+  explicit IndexedHeapOpenList(size_t numberOfStates = 0) : size(0)
+  {
+    reset(numberOfStates);
+  }
+
+  /// @brief Empties the heap for states below `numberOfStates`, in O(size of the heap) unless the states grow.
+  void reset(size_t numberOfStates)
+  {
+    for (size_t index = 0; index < size; ++index)
+    {
+      positions[static_cast<size_t>(getNode(index).state)] = absent;
+    }
+    size = 0;
+    if (positions.size() < numberOfStates)
+    {
+      positions.resize(numberOfStates, absent);
+    }
+  }
+
+  bool empty() const
+  {
+    return size == 0;
+  }
+
+  /// @brief Inserts the state, or lowers its priority if it is in the heap already. A higher priority is ignored.
+  void push(Distance priority, Distance distance, const State& state)
+  {
+    const Node node{priority, distance, state};
+    size_t& position = positions[static_cast<size_t>(state)];
+    if (position == absent)
+    {
+      if (firstPhysicalIndex + size >= groups.size() * groupSize)
+      {
+        groups.resize(std::max<size_t>(2 * groups.size(), 1));
+      }
+      siftUp(size++, node);
+    }
+    else if (isBefore(node, getNode(position)))
+    {
+      siftUp(position, node);
+    }
+  }
+
+  State pop()
+  {
+    const State state = getNode(0).state;
+    positions[static_cast<size_t>(state)] = absent;
+    --size;
+    if (size > 0)
+    {
+      siftDown(0, getNode(size));
+    }
+    return state;
+  }
+
+ private:
+  struct Node {
+    Distance priority;
+    Distance distance;
+    State state;
+  };
+
+  static constexpr size_t groupSize = 4;
+  static constexpr size_t firstPhysicalIndex = groupSize - 1;
+  static constexpr size_t absent = std::numeric_limits<size_t>::max();
+
+  struct alignas(64) Group {
+    Node nodes[groupSize];
+  };
+
+  Node& getNode(size_t index)
+  {
+    const size_t physicalIndex = index + firstPhysicalIndex;
+    return groups[physicalIndex / groupSize].nodes[physicalIndex % groupSize];
+  }
+
+  static bool isBefore(const Node& a, const Node& b)
+  {
+    return a.priority < b.priority || (a.priority == b.priority && a.distance > b.distance);
+  }
+
+  void place(size_t index, const Node& node)
+  {
+    getNode(index) = node;
+    positions[static_cast<size_t>(node.state)] = index;
+  }
+
+  // Moves `node` from the hole at `index` towards the root
+  void siftUp(size_t index, const Node& node)
+  {
+    while (index > 0)
+    {
+      const size_t parent = (index - 1) / groupSize;
+      if (!isBefore(node, getNode(parent))) break;
+      place(index, getNode(parent));
+      index = parent;
+    }
+    place(index, node);
+  }
+
+  // Moves `node` from the hole at `index` towards the leaves
+  void siftDown(size_t index, const Node& node)
+  {
+    while (true)
+    {
+      const size_t firstChild = groupSize * index + 1;
+      if (firstChild >= size) break;
+      const size_t lastChild = std::min(firstChild + groupSize, size);
+      size_t bestChild = firstChild;
+      for (size_t child = firstChild + 1; child < lastChild; ++child)
+      {
+        if (isBefore(getNode(child), getNode(bestChild))) bestChild = child;
+      }
+      if (!isBefore(getNode(bestChild), node)) break;
+      place(index, getNode(bestChild));
+      index = bestChild;
+    }
+    place(index, node);
+  }
+
+  std::vector<Group> groups;
+  size_t size;
+  /// Index of every state in the heap, `absent` for the others
+  std::vector<size_t> positions;
+};
@@ -0,0 +1,170 @@
+#include "open-lists.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "best-first-search.h"
+#include "path-finding.h"
+
+template <typename OpenList>
+std::vector<Vertex> popAll(OpenList& openList)
+{
+  std::vector<Vertex> states;
+  while (!openList.empty())
+  {
+    states.push_back(openList.pop());
+  }
+  return states;
+}
+
+template <typename OpenList>
+class MonotoneOpenListTest : public testing::Test
+{
+};
+
+typedef testing::Types<BucketOpenList<Vertex>, TwoLevelBucketOpenList<Vertex>, RadixHeapOpenList<Vertex>>
+    MonotoneOpenLists;
+TYPED_TEST_SUITE(MonotoneOpenListTest, MonotoneOpenLists);
+
+TYPED_TEST(MonotoneOpenListTest, takes_states_by_ascending_priority)
+{
+  TypeParam openList;
+  openList.push(5.0f, 0.0f, 5);
+  openList.push(2.0f, 0.0f, 2);
+  openList.push(7.0f, 0.0f, 7);
+  openList.push(3.0f, 0.0f, 3);
+  EXPECT_EQ(openList.pop(), 2u);
+  // Pushing while taking, as a search does
+  openList.push(4.0f, 0.0f, 4);
+  openList.push(2.0f, 0.0f, 1);
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{1, 3, 4, 5, 7}));
+}
+
+TYPED_TEST(MonotoneOpenListTest, spans_large_ranges_of_keys)
+{
+  TypeParam openList;
+  openList.push(10.0f, 0.0f, 0);
+  openList.push(100000.0f, 0.0f, 2);
+  openList.push(1000.0f, 0.0f, 1);
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{0, 1, 2}));
+  // Keys below the last taken one are raised to it
+  openList.push(3.0f, 0.0f, 3);
+  openList.push(100001.0f, 0.0f, 4);
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{3, 4}));
+}
+
+TYPED_TEST(MonotoneOpenListTest, rounds_priorities_to_the_resolution)
+{
+  TypeParam openList(0.5f);
+  openList.push(1.0f, 0.0f, 1);
+  openList.push(1.4999f, 0.0f, 2);
+  openList.push(0.5001f, 0.0f, 0);
+  EXPECT_EQ(openList.pop(), 0u);
+  EXPECT_EQ(openList.pop(), 1u);
+  EXPECT_EQ(openList.pop(), 2u);
+}
+
+TEST(TwoLevelBucketOpenList, takes_largest_distance_among_equal_priorities)
+{
+  TwoLevelBucketOpenList<Vertex> openList;
+  openList.push(4.0f, 1.0f, 1);
+  openList.push(4.0f, 3.0f, 3);
+  openList.push(4.0f, 2.0f, 2);
+  openList.push(3.0f, 0.0f, 0);
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{0, 3, 2, 1}));
+}
+
+TEST(IndexedHeapOpenList, takes_states_by_ascending_priority)
+{
+  IndexedHeapOpenList<Vertex> openList(16);
+  for (Vertex state : {9, 3, 12, 0, 7, 15, 1, 4, 10})
+  {
+    openList.push(static_cast<Distance>(state), 0.0f, state);
+  }
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{0, 1, 3, 4, 7, 9, 10, 12, 15}));
+}
+
+TEST(IndexedHeapOpenList, lowers_the_priority_of_a_state_in_place)
+{
+  IndexedHeapOpenList<Vertex> openList(4);
+  openList.push(5.0f, 0.0f, 1);
+  openList.push(3.0f, 0.0f, 2);
+  openList.push(1.0f, 0.0f, 1);
+  // A higher priority is ignored
+  openList.push(4.0f, 0.0f, 2);
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{1, 2}));
+
+  // A taken state can be pushed again
+  openList.push(2.0f, 0.0f, 1);
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{1}));
+}
+
+TEST(IndexedHeapOpenList, takes_largest_distance_among_equal_priorities)
+{
+  IndexedHeapOpenList<Vertex> openList(4);
+  openList.push(4.0f, 1.0f, 1);
+  openList.push(4.0f, 3.0f, 3);
+  openList.push(4.0f, 2.0f, 2);
+  openList.push(3.0f, 0.0f, 0);
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{0, 3, 2, 1}));
+}
+
+TEST(IndexedHeapOpenList, reset_forgets_the_states_left)
+{
+  IndexedHeapOpenList<Vertex> openList(2);
+  openList.push(1.0f, 0.0f, 0);
+  openList.push(2.0f, 0.0f, 1);
+  openList.reset(3);
+  EXPECT_TRUE(openList.empty());
+  openList.push(3.0f, 0.0f, 1);
+  openList.push(2.0f, 0.0f, 2);
+  EXPECT_EQ(popAll(openList), (std::vector<Vertex>{2, 1}));
+}
+
+struct ExaminedStatesCounter {
+  size_t examinedStates = 0;
+
+  void examineState(Vertex)
+  {
+    ++examinedStates;
+  }
+
+  void generateState(Vertex)
+  {
+  }
+};
+
+TEST(IndexedHeapOpenList, holds_no_duplicate_states)
+{
+  // Vertex 2 improves from 3 to 2 while open, which a binary heap holds twice
+  const auto graph = DefaultGraphLoader().getGraph();
+  VertexSearchSpace<WeightedDiGraph> space(*graph, 0);
+  IndexedHeapOpenList<Vertex> openList(num_vertices(*graph));
+  ExaminedStatesCounter visitor;
+  best_first_search(space, Vertex(0), ZeroHeuristic(), openList, visitor);
+  EXPECT_EQ(visitor.examinedStates, 4u);
+  EXPECT_EQ(space.getContext().getDistance(2), 2.0f);
+}
+
+TEST(OpenListType, planners_find_paths_as_short_as_with_a_binary_heap)
+{
+  MapGraphLoader loader(
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/maze-128-128-1/maze-128-128-1.map")
+          .make_preferred()
+          .string());
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const auto target = static_cast<Vertex>(graph.getNumberOfVertices() - 1);
+  const size_t length = a_star_shortest_path(graph, 0, target).size();
+
+  const std::vector<OpenListType> openListTypes{
+      OpenListType::Buckets, OpenListType::TwoLevelBuckets, OpenListType::RadixHeap, OpenListType::IndexedHeap};
+  SearchContext context;
+  for (const OpenListType openListType : openListTypes)
+  {
+    EXPECT_EQ(a_star_shortest_path(graph, 0, target, context, openListType).size(), length);
+    EXPECT_EQ(dijkstra_shortest_path(graph, 0, target, context, openListType).size(), length);
+    const std::vector<Vertex> predecessors = dijkstra_shortest_paths(graph, 0, context, openListType);
+    EXPECT_EQ(extract_path(predecessors, target, 0).size(), length);
+  }
+}
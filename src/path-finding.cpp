@@ -5,10 +5,16 @@
 #include <boost/graph/astar_search.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/graph_traits.hpp>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <queue>
+#include <sstream>
+#include <stdexcept>
 
+#include "best-first-search.h"
 #include "graph.h"
+#include "open-lists.h"
 
 std::vector<Vertex> boost_dijkstra_shortest_paths(const WeightedDiGraph& graph, const Vertex& start)
 {
@@ -18,46 +24,103 @@ std::vector<Vertex> boost_dijkstra_shortest_paths(const WeightedDiGraph& graph,
   return predecessor;
 }
 
-std::vector<Vertex> dijkstra_shortest_paths(const WeightedDiGraph& graph, const Vertex& start)
+// Calls `search` with an empty open list of the given type, for states below `numberOfStates`
+template <typename Search>
+void with_open_list(OpenListType openListType, size_t numberOfStates, Search&& search)
 {
-  size_t numberOfVertices = boost::num_vertices(graph);
-  std::vector<Vertex> predecessor(numberOfVertices);
-  for (Vertex i = 0; i < numberOfVertices; ++i)
+  switch (openListType)
   {
-    predecessor[i] = i;
+    case OpenListType::BinaryHeap: {
+      BinaryHeapOpenList<Vertex> openList;
+      search(openList);
+      break;
+    }
+    case OpenListType::Buckets: {
+      BucketOpenList<Vertex> openList;
+      search(openList);
+      break;
+    }
+    case OpenListType::TwoLevelBuckets: {
+      TwoLevelBucketOpenList<Vertex> openList;
+      search(openList);
+      break;
+    }
+    case OpenListType::RadixHeap: {
+      RadixHeapOpenList<Vertex> openList;
+      search(openList);
+      break;
+    }
+    case OpenListType::IndexedHeap: {
+      // Kept like the `SearchContext` of the thread, as its positions take O(V) memory to initialize
+      thread_local IndexedHeapOpenList<Vertex> openList;
+      openList.reset(numberOfStates);
+      search(openList);
+      break;
+    }
   }
-  std::vector<Distance> distances(numberOfVertices, std::numeric_limits<Distance>::max());
-  distances[start] = 0.0;
+}
 
-  typedef std::pair<Distance, Vertex> Pair;  // (distance, vertex)
-  std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> priorityQueue;
-  priorityQueue.push(std::make_pair(0.0f, start));
+template <typename Graph>
+std::vector<Vertex> dijkstra_search(
+    const Graph& graph, const Vertex& start, SearchContext& context, OpenListType openListType)
+{
+  VertexSearchSpace<Graph> space(graph, start, std::nullopt, context);
+  NullSearchVisitor visitor;
+  with_open_list(
+      openListType,
+      num_vertices(graph),
+      [&](auto& openList) { best_first_search(space, start, ZeroHeuristic(), openList, visitor); });
 
-  while (!priorityQueue.empty())
+  std::vector<Vertex> predecessors(num_vertices(graph));
+  for (Vertex vertex = 0; vertex < predecessors.size(); ++vertex)
   {
-    Vertex bestExploredVertex = priorityQueue.top().second;
-    Distance distanceToBestExploredVertex = priorityQueue.top().first;
-    priorityQueue.pop();
+    predecessors[vertex] = context.getPredecessor(vertex);
+  }
+  return predecessors;
+}
 
-    if (distanceToBestExploredVertex > distances[bestExploredVertex]) continue;
+std::vector<Vertex> dijkstra_shortest_paths(const WeightedDiGraph& graph, const Vertex& start)
+{
+  return dijkstra_search(graph, start, SearchContext::getThreadContext(), OpenListType::BinaryHeap);
+}
 
-    boost::graph_traits<WeightedDiGraph>::out_edge_iterator edgeIterator, edgeIteratorEnd;
-    for (tie(edgeIterator, edgeIteratorEnd) = boost::out_edges(bestExploredVertex, graph);
-         edgeIterator != edgeIteratorEnd;
-         ++edgeIterator)
-    {
-      size_t newExploredVertex = target(*edgeIterator, graph);
-      Distance weight = boost::get(boost::edge_weight_t(), graph, *edgeIterator);
-      if (distances[bestExploredVertex] + weight < distances[newExploredVertex])
-      {
-        distances[newExploredVertex] = distances[bestExploredVertex] + weight;
-        predecessor[newExploredVertex] = bestExploredVertex;
-        priorityQueue.push(std::make_pair(distances[newExploredVertex], newExploredVertex));
-      }
-    }
-  }
+std::vector<Vertex> dijkstra_shortest_paths(const CompressedSparseRowGraph& graph, const Vertex& start)
+{
+  return dijkstra_search(graph, start, SearchContext::getThreadContext(), OpenListType::BinaryHeap);
+}
 
-  return predecessor;
+std::vector<Vertex> dijkstra_shortest_paths(const GridGraph& graph, const Vertex& start)
+{
+  return dijkstra_search(graph, start, SearchContext::getThreadContext(), OpenListType::BinaryHeap);
+}
+
+std::vector<Vertex> dijkstra_shortest_paths(const TiledGridGraph& graph, const Vertex& start)
+{
+  return dijkstra_search(graph, start, SearchContext::getThreadContext(), OpenListType::BinaryHeap);
+}
+
+std::vector<Vertex> dijkstra_shortest_paths(
+    const WeightedDiGraph& graph, const Vertex& start, SearchContext& context, OpenListType openListType)
+{
+  return dijkstra_search(graph, start, context, openListType);
+}
+
+std::vector<Vertex> dijkstra_shortest_paths(
+    const CompressedSparseRowGraph& graph, const Vertex& start, SearchContext& context, OpenListType openListType)
+{
+  return dijkstra_search(graph, start, context, openListType);
+}
+
+std::vector<Vertex> dijkstra_shortest_paths(
+    const GridGraph& graph, const Vertex& start, SearchContext& context, OpenListType openListType)
+{
+  return dijkstra_search(graph, start, context, openListType);
+}
+
+std::vector<Vertex> dijkstra_shortest_paths(
+    const TiledGridGraph& graph, const Vertex& start, SearchContext& context, OpenListType openListType)
+{
+  return dijkstra_search(graph, start, context, openListType);
 }
 
 Path boost_dijkstra_shortest_path(const WeightedDiGraph& graph, const Vertex& start, const Vertex& target)
@@ -67,38 +130,101 @@ Path boost_dijkstra_shortest_path(const WeightedDiGraph& graph, const Vertex& st
   return std::vector<Vertex>(path.rbegin(), path.rend());
 }
 
+// Path to `goal` from the predecessors of the search that reached it
+Path extract_path(const SearchContext& context, const Vertex& start, const Vertex& goal)
+{
+  if (!context.isReached(goal))
+  {
+    std::ostringstream message;
+    message << "Unable to find path from " << start << " to " << goal << std::endl;
+    throw std::runtime_error(message.str());
+  }
+
+  Path path;
+  for (Vertex vertex = goal; vertex != start; vertex = context.getPredecessor(vertex))
+  {
+    path.push_back(vertex);
+  }
+  path.push_back(start);
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+template <typename Graph>
+Path dijkstra_point_to_point_search(
+    const Graph& graph, const Vertex& start, const Vertex& target, SearchContext& context, OpenListType openListType)
+{
+  VertexSearchSpace<Graph> space(graph, start, target, context);
+  NullSearchVisitor visitor;
+  with_open_list(
+      openListType,
+      num_vertices(graph),
+      [&](auto& openList) { best_first_search(space, start, ZeroHeuristic(), openList, visitor); });
+  return extract_path(context, start, target);
+}
+
 Path dijkstra_shortest_path(const WeightedDiGraph& graph, const Vertex& start, const Vertex& target)
 {
-  std::vector<Vertex> predecessor = dijkstra_shortest_paths(graph, start);
-  auto path = extract_path(predecessor, target, start);
-  return std::vector<Vertex>(path.rbegin(), path.rend());
+  return dijkstra_point_to_point_search(
+      graph, start, target, SearchContext::getThreadContext(), OpenListType::BinaryHeap);
+}
+
+Path dijkstra_shortest_path(const CompressedSparseRowGraph& graph, const Vertex& start, const Vertex& target)
+{
+  return dijkstra_point_to_point_search(
+      graph, start, target, SearchContext::getThreadContext(), OpenListType::BinaryHeap);
+}
+
+Path dijkstra_shortest_path(const GridGraph& graph, const Vertex& start, const Vertex& target)
+{
+  return dijkstra_point_to_point_search(
+      graph, start, target, SearchContext::getThreadContext(), OpenListType::BinaryHeap);
+}
+
+Path dijkstra_shortest_path(const TiledGridGraph& graph, const Vertex& start, const Vertex& target)
+{
+  return dijkstra_point_to_point_search(
+      graph, start, target, SearchContext::getThreadContext(), OpenListType::BinaryHeap);
 }
 
-// Define heuristic function
-manhattan_distance_heuristic::manhattan_distance_heuristic(WeightedDiGraph graph, Vertex goal)
-    : m_graph(graph), m_goal(goal)
+Path dijkstra_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType)
 {
+  return dijkstra_point_to_point_search(graph, start, target, context, openListType);
 }
 
-Distance manhattan_distance_heuristic::operator()(Vertex v)
+Path dijkstra_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType)
 {
-  // Example heuristic: Manhattan distance between v and the goal
-  Distance dx = std::abs(m_graph[m_goal].position.x - m_graph[v].position.x);
-  Distance dy = std::abs(m_graph[m_goal].position.y - m_graph[v].position.y);
-  return dx + dy;
+  return dijkstra_point_to_point_search(graph, start, target, context, openListType);
 }
 
-// euclidean distance heuristic
-euclidean_distance_heuristic::euclidean_distance_heuristic(WeightedDiGraph graph, Vertex goal)
-    : m_graph(graph), m_goal(goal)
+Path dijkstra_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType)
 {
+  return dijkstra_point_to_point_search(graph, start, target, context, openListType);
 }
 
-Distance euclidean_distance_heuristic::operator()(Vertex v)
+Path dijkstra_shortest_path(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType)
 {
-  Distance dx = m_graph[m_goal].position.x - m_graph[v].position.x;
-  Distance dy = m_graph[m_goal].position.y - m_graph[v].position.y;
-  return ::sqrt(dx * dx + dy * dy);
+  return dijkstra_point_to_point_search(graph, start, target, context, openListType);
 }
 
 struct found_goal {
@@ -129,7 +255,7 @@ Path boost_a_star_shortest_path(const WeightedDiGraph& graph, const Vertex& star
 
   // Run A* search
   // manhattan_distance_heuristic heuristic(graph, target);
-  euclidean_distance_heuristic heuristic(graph, target);
+  euclidean_distance_heuristic<WeightedDiGraph> heuristic(graph, target);
   try
   {
     // call astar named parameter interface
@@ -151,194 +277,643 @@ Path boost_a_star_shortest_path(const WeightedDiGraph& graph, const Vertex& star
   throw std::runtime_error(message.str());
 }
 
+template <typename Graph, typename Heuristic>
+Path a_star_search(
+    const Graph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Heuristic& heuristic,
+    SearchContext& context,
+    OpenListType openListType)
+{
+  VertexSearchSpace<Graph> space(graph, start, goal, context);
+  NullSearchVisitor visitor;
+  with_open_list(
+      openListType,
+      num_vertices(graph),
+      [&](auto& openList) { best_first_search(space, start, heuristic, openList, visitor); });
+  return extract_path(context, start, goal);
+}
+
 Path a_star_shortest_path(
     const WeightedDiGraph& graph,
     const Vertex& start,
     const Vertex& goal /*, std::function<Distance(Vertex)> heuristic*/)
 {
-  auto heuristic = euclidean_distance_heuristic(graph, goal);
+  return a_star_search(
+      graph,
+      start,
+      goal,
+      euclidean_distance_heuristic(graph, goal),
+      SearchContext::getThreadContext(),
+      OpenListType::BinaryHeap);
+}
 
-  // Property maps for predecessors and distances
-  std::vector<Vertex> predecessors(num_vertices(graph));
-  std::vector<Distance> distances(num_vertices(graph), std::numeric_limits<Distance>::max());
+Path a_star_shortest_path(const CompressedSparseRowGraph& graph, const Vertex& start, const Vertex& goal)
+{
+  return a_star_search(
+      graph,
+      start,
+      goal,
+      euclidean_distance_heuristic(graph, goal),
+      SearchContext::getThreadContext(),
+      OpenListType::BinaryHeap);
+}
 
-  // Priority queue for open list
-  typedef std::pair<Distance, Vertex> Pair;
-  std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> priorityQueue;
+Path a_star_shortest_path(const GridGraph& graph, const Vertex& start, const Vertex& goal)
+{
+  return a_star_search(
+      graph,
+      start,
+      goal,
+      euclidean_distance_heuristic(graph, goal),
+      SearchContext::getThreadContext(),
+      OpenListType::BinaryHeap);
+}
+
+Path a_star_shortest_path(const TiledGridGraph& graph, const Vertex& start, const Vertex& goal)
+{
+  return a_star_search(
+      graph,
+      start,
+      goal,
+      euclidean_distance_heuristic(graph, goal),
+      SearchContext::getThreadContext(),
+      OpenListType::BinaryHeap);
+}
 
-  // Initialize start vertex
-  priorityQueue.push(std::make_pair(0.0f, start));
-  distances[start] = 0;
+Path a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    SearchContext& context,
+    OpenListType openListType)
+{
+  return a_star_search(graph, start, goal, euclidean_distance_heuristic(graph, goal), context, openListType);
+}
 
-  while (!priorityQueue.empty())
-  {
-    Vertex current_vertex = priorityQueue.top().second;
-    priorityQueue.pop();
+Path a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    SearchContext& context,
+    OpenListType openListType)
+{
+  return a_star_search(graph, start, goal, euclidean_distance_heuristic(graph, goal), context, openListType);
+}
 
-    if (current_vertex == goal) break;
+Path a_star_shortest_path(
+    const GridGraph& graph, const Vertex& start, const Vertex& goal, SearchContext& context, OpenListType openListType)
+{
+  return a_star_search(graph, start, goal, euclidean_distance_heuristic(graph, goal), context, openListType);
+}
 
-    boost::graph_traits<WeightedDiGraph>::out_edge_iterator ei, ei_end;
-    for (tie(ei, ei_end) = out_edges(current_vertex, graph); ei != ei_end; ++ei)
-    {
-      Vertex next_vertex = target(*ei, graph);
-      Distance weight = boost::get(boost::edge_weight_t(), graph, *ei);
-      Distance tentative_distance = distances[current_vertex] + weight;
+Path a_star_shortest_path(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    SearchContext& context,
+    OpenListType openListType)
+{
+  return a_star_search(graph, start, goal, euclidean_distance_heuristic(graph, goal), context, openListType);
+}
 
-      if (tentative_distance < distances[next_vertex])
-      {
-        distances[next_vertex] = tentative_distance;
-        predecessors[next_vertex] = current_vertex;
-        Distance priority = tentative_distance + heuristic(next_vertex);
-        priorityQueue.push(std::make_pair(priority, next_vertex));
-      }
-    }
-  }
+Path a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const LandmarkTable& landmarks,
+    SearchContext& context,
+    OpenListType openListType)
+{
+  return a_star_search(graph, start, goal, landmark_distance_heuristic(landmarks, goal), context, openListType);
+}
 
-  // Reconstruct the shortest path
-  std::vector<Vertex> path;
-  for (Vertex v = goal; v != start; v = predecessors[v])
+Path a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const LandmarkTable& landmarks,
+    SearchContext& context,
+    OpenListType openListType)
+{
+  return a_star_search(graph, start, goal, landmark_distance_heuristic(landmarks, goal), context, openListType);
+}
+
+Path a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const LandmarkTable& landmarks,
+    SearchContext& context,
+    OpenListType openListType)
+{
+  return a_star_search(graph, start, goal, landmark_distance_heuristic(landmarks, goal), context, openListType);
+}
+
+Path a_star_shortest_path(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const LandmarkTable& landmarks,
+    SearchContext& context,
+    OpenListType openListType)
+{
+  return a_star_search(graph, start, goal, landmark_distance_heuristic(landmarks, goal), context, openListType);
+}
+
+void check_calculator_graph(const WeightedDiGraph& graph, size_t numberOfVertices, const char* planner)
+{
+  if (num_vertices(graph) != numberOfVertices)
   {
-    path.push_back(v);
+    std::ostringstream message;
+    message << planner << " of " << numberOfVertices << " vertices asked for a path in a graph of "
+            << num_vertices(graph) << " vertices";
+    throw std::invalid_argument(message.str());
   }
-  path.push_back(start);
-  std::reverse(path.begin(), path.end());
-
-  return path;
 }
 
-struct PositionAtTime {
-  Vertex vertex;
-  unsigned time;
+ShortestPathCalculator a_star_calculator(const LandmarkTable& landmarks)
+{
+  return [&landmarks](const WeightedDiGraph& graph, const Vertex& start, const Vertex& target)
+  { return a_star_shortest_path(graph, start, target, landmarks); };
+}
 
-  PositionAtTime(Vertex vertex, unsigned time) : vertex(vertex), time(time)
+namespace
+{
+// Euclidean distance to the bounding box of a set of targets, which is at most the distance to the closest of them
+template <typename Graph>
+class bounding_box_distance_heuristic
+{
+ public:
+  bounding_box_distance_heuristic(const Graph& graph, const std::vector<Vertex>& targets)
+      : m_graph(graph)
+      , m_minimum{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()}
+      , m_maximum{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()}
   {
+    for (const Vertex target : targets)
+    {
+      const Point2D position = vertex_position(graph, target);
+      m_minimum = {std::min(m_minimum.x, position.x), std::min(m_minimum.y, position.y)};
+      m_maximum = {std::max(m_maximum.x, position.x), std::max(m_maximum.y, position.y)};
+    }
   }
 
-  // Compare two states
-  bool operator<(const PositionAtTime& other) const
+  void operator()(const Vertex* vertices, size_t count, Distance* distances) const
   {
-    if (vertex != other.vertex) return vertex < other.vertex;
-    return time < other.time;
+    for (size_t index = 0; index < count; ++index)
+    {
+      const Point2D position = vertex_position(m_graph, vertices[index]);
+      const float dx = std::max({m_minimum.x - position.x, 0.0f, position.x - m_maximum.x});
+      const float dy = std::max({m_minimum.y - position.y, 0.0f, position.y - m_maximum.y});
+      distances[index] = std::sqrt(dx * dx + dy * dy);
+    }
   }
+
+ private:
+  const Graph& m_graph;
+  Point2D m_minimum;
+  Point2D m_maximum;
 };
+}  // namespace
 
-MultiAgentShortestPathCalculator multi_agent_shortest_path_calculator_wrapper(const ShortestPathCalculator& calculator)
+template <typename Graph, typename Heuristic>
+std::vector<Path> multi_target_search(
+    const Graph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    const Heuristic& heuristic,
+    SearchContext& context)
 {
-  return [calculator](
-             const WeightedDiGraph& graph,
-             const Vertex& start,
-             const Vertex& target,
-             const Constraints& /*constraints*/,
-             RunnerId /*runnerId*/) { return calculator(graph, start, target); };
+  TargetSetSearchSpace<Graph> space(graph, start, targets, context);
+  BinaryHeapOpenList<Vertex> openList;
+  NullSearchVisitor visitor;
+  best_first_search(space, start, heuristic, openList, visitor);
+
+  std::vector<Path> paths;
+  paths.reserve(targets.size());
+  for (const Vertex target : targets)
+  {
+    paths.push_back(context.isReached(target) ? extract_path(context, start, target) : Path());
+  }
+  return paths;
 }
 
-/// See [./doc/coop-path-AIWisdom.pdf](Cooperative Pathinding)
-Path space_time_a_star_shortest_path(
-    const WeightedDiGraph& graph,
+std::vector<Path> multi_target_dijkstra_shortest_paths(
+    const WeightedDiGraph& graph, const Vertex& start, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return multi_target_search(graph, start, targets, ZeroHeuristic(), context);
+}
+
+std::vector<Path> multi_target_dijkstra_shortest_paths(
+    const CompressedSparseRowGraph& graph,
     const Vertex& start,
-    const Vertex& goal,
-    const Constraints& constraints,
-    RunnerId runnerId)
+    const std::vector<Vertex>& targets,
+    SearchContext& context)
 {
-  auto heuristic = euclidean_distance_heuristic(graph, goal);
+  return multi_target_search(graph, start, targets, ZeroHeuristic(), context);
+}
 
-  // Property maps for predecessors and distances
-  std::map<PositionAtTime, Vertex> predecessors;
-  std::map<PositionAtTime, Distance> distances;
-  std::map<PositionAtTime, unsigned> arrival_times;
+std::vector<Path> multi_target_dijkstra_shortest_paths(
+    const GridGraph& graph, const Vertex& start, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return multi_target_search(graph, start, targets, ZeroHeuristic(), context);
+}
 
-  // Priority queue for open list
-  typedef std::pair<Distance, PositionAtTime> Pair;
-  std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> priorityQueue;  // openList
+std::vector<Path> multi_target_dijkstra_shortest_paths(
+    const TiledGridGraph& graph, const Vertex& start, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return multi_target_search(graph, start, targets, ZeroHeuristic(), context);
+}
 
-  // Initialize start vertex
-  PositionAtTime start_state(start, 0u);
-  priorityQueue.push(std::make_pair(0.0f, start_state));
-  predecessors[start_state] = start;
-  distances[start_state] = 0;
-  arrival_times[start_state] = 0;
+std::vector<Path> multi_target_a_star_shortest_paths(
+    const WeightedDiGraph& graph, const Vertex& start, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return multi_target_search(graph, start, targets, bounding_box_distance_heuristic(graph, targets), context);
+}
 
-  while (!priorityQueue.empty())
-  {
-    PositionAtTime current_state = priorityQueue.top().second;
-    priorityQueue.pop();
-    Vertex current_vertex = current_state.vertex;
-    unsigned current_time = current_state.time;
-    unsigned arrival_time = current_time + 1;
+std::vector<Path> multi_target_a_star_shortest_paths(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context)
+{
+  return multi_target_search(graph, start, targets, bounding_box_distance_heuristic(graph, targets), context);
+}
+
+std::vector<Path> multi_target_a_star_shortest_paths(
+    const GridGraph& graph, const Vertex& start, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return multi_target_search(graph, start, targets, bounding_box_distance_heuristic(graph, targets), context);
+}
 
-    if (current_vertex == goal) break;
+std::vector<Path> multi_target_a_star_shortest_paths(
+    const TiledGridGraph& graph, const Vertex& start, const std::vector<Vertex>& targets, SearchContext& context)
+{
+  return multi_target_search(graph, start, targets, bounding_box_distance_heuristic(graph, targets), context);
+}
 
-    if (current_time > 10 * graph.m_vertices.size())
+// Best-first search over the junctions of a corridor graph. It starts from the exits of `start`, and stops as soon as
+// no open junction can lead to a shorter path into `target` than the best one found through its entries. With
+// `useHeuristic`, the estimate of a junction is its Euclidean distance to the closest entry plus the rest of the walk.
+template <bool useHeuristic>
+Path corridor_search(const CorridorGraph& graph, const Vertex& start, const Vertex& target)
+{
+  typedef CorridorGraph::EdgeIndex EdgeIndex;
+  const EdgeIndex noEdge = std::numeric_limits<EdgeIndex>::max();
+  const CompressedSparseRowGraph& reducedGraph = graph.getReducedGraph();
+  const EdgeIndex* offsets = reducedGraph.getOffsets();
+  const CompressedSparseRowGraph::VertexIndex* targets = reducedGraph.getTargets();
+  const Distance* weights = reducedGraph.getWeights();
+
+  const auto exits = graph.getExits(start);
+  const auto entries = graph.getEntries(target);
+  std::vector<euclidean_distance_heuristic<CompressedSparseRowGraph>> heuristics;
+  for (const auto& entry : entries)
+  {
+    heuristics.emplace_back(reducedGraph, entry.junction);
+  }
+  std::vector<Distance> estimates;
+  std::vector<Distance> entryEstimates;
+  auto estimate = [&](const Vertex* junctions, size_t count)
+  {
+    estimates.assign(count, useHeuristic ? std::numeric_limits<Distance>::max() : 0.0f);
+    if (!useHeuristic) return;
+    entryEstimates.resize(count);
+    for (size_t entry = 0; entry < entries.size(); ++entry)
     {
-      std::cout << "Unable to find path: Time exceeded number of Vertices."
-                << "current_time=" << current_time << ", number_of_vertices=" << graph.m_vertices.size() << std::endl;
-      continue;
+      heuristics[entry](junctions, count, entryEstimates.data());
+      for (size_t index = 0; index < count; ++index)
+      {
+        estimates[index] = std::min(estimates[index], entryEstimates[index] + entries[entry].distance);
+      }
     }
+  };
+
+  Distance bestDistance = std::numeric_limits<Distance>::max();
+  const CorridorGraph::CorridorWalk* bestEntry = nullptr;
+  const auto directWalk = graph.getWalkWithinCorridor(start, target);
+  if (directWalk) bestDistance = directWalk->first;
+
+  const size_t numberOfJunctions = graph.getNumberOfJunctions();
+  std::vector<Distance> distances(numberOfJunctions, std::numeric_limits<Distance>::max());
+  std::vector<Vertex> predecessors(numberOfJunctions);
+  std::vector<EdgeIndex> predecessorEdges(numberOfJunctions, noEdge);
+  std::vector<bool> settled(numberOfJunctions, false);
+  typedef std::pair<Distance, Vertex> Pair;
+  std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> priorityQueue;
+  std::vector<Vertex> successors;
 
-    boost::graph_traits<WeightedDiGraph>::out_edge_iterator ei, ei_end;
-    for (tie(ei, ei_end) = out_edges(current_vertex, graph); ei != ei_end; ++ei)
+  for (const auto& exit : exits)
+  {
+    if (exit.distance < distances[exit.junction])
     {
-      Vertex next_vertex = target(*ei, graph);
-      Distance weight = boost::get(boost::edge_weight_t(), graph, *ei);
-      Distance tentative_distance = distances[current_state] + weight;
+      distances[exit.junction] = exit.distance;
+      successors.push_back(exit.junction);
+    }
+  }
+  estimate(successors.data(), successors.size());
+  for (size_t index = 0; index < successors.size(); ++index)
+  {
+    priorityQueue.push(std::make_pair(distances[successors[index]] + estimates[index], successors[index]));
+  }
 
-      PositionAtTime next_state(next_vertex, arrival_time);
+  while (!priorityQueue.empty() && priorityQueue.top().first < bestDistance)
+  {
+    const Vertex junction = priorityQueue.top().second;
+    priorityQueue.pop();
+    if (settled[junction]) continue;
+    settled[junction] = true;
 
-      if (/*tentative_distance < distances[next_state]
-          &&*/
-          constraints.isVertexFreeForRunner(next_vertex, runnerId, arrival_time, arrival_time + 1) &&
-          constraints.isEdgeFreeForRunner(current_vertex, next_vertex, runnerId, current_time, arrival_time))
+    for (const auto& entry : entries)
+    {
+      if (entry.junction == junction && distances[junction] + entry.distance < bestDistance)
       {
-        distances[next_state] = tentative_distance;
-        predecessors[next_state] = current_vertex;
-        arrival_times[next_state] = arrival_time;
-        Distance priority = tentative_distance + heuristic(next_vertex);
-        priorityQueue.push(std::make_pair(priority, next_state));
+        bestDistance = distances[junction] + entry.distance;
+        bestEntry = &entry;
       }
     }
 
-    // Allow to pause at the current vertex
-    PositionAtTime paused_state(current_vertex, current_time + 1);
-    if (constraints.isVertexFreeForRunner(current_vertex, runnerId, arrival_time, arrival_time + 1))
+    successors.clear();
+    for (EdgeIndex edge = offsets[junction]; edge < offsets[junction + 1]; ++edge)
     {
-      distances[paused_state] = distances[current_state];
-      predecessors[paused_state] = current_vertex;
-      arrival_times[paused_state] = current_time + 1;
-      /// Add current_time as penalty for staying at the same place.
-      Distance priority = distances[current_state] + heuristic(current_vertex) + current_time;
-      priorityQueue.push(std::make_pair(priority, paused_state));
+      const Vertex next = targets[edge];
+      if (!settled[next] && distances[junction] + weights[edge] < distances[next])
+      {
+        distances[next] = distances[junction] + weights[edge];
+        predecessors[next] = junction;
+        predecessorEdges[next] = edge;
+        successors.push_back(next);
+      }
+    }
+    estimate(successors.data(), successors.size());
+    for (size_t index = 0; index < successors.size(); ++index)
+    {
+      priorityQueue.push(std::make_pair(distances[successors[index]] + estimates[index], successors[index]));
     }
   }
 
-  // Reconstruct the shortest path
-  std::vector<Vertex> path;
-  PositionAtTime goal_state(goal, 0);
-  unsigned min_time = std::numeric_limits<unsigned>::max();
-  for (const auto& entry : arrival_times)
+  Path path{start};
+  if (bestEntry == nullptr)
   {
-    if (entry.first.vertex == goal && entry.second < min_time)
+    if (!directWalk)
     {
-      goal_state = entry.first;
-      min_time = entry.second;
+      std::ostringstream message;
+      message << "Unable to find path from " << start << " to " << target << std::endl;
+      throw std::runtime_error(message.str());
     }
+    path.insert(path.end(), directWalk->second.begin(), directWalk->second.end());
+    return path;
   }
 
-  if (min_time == std::numeric_limits<unsigned>::max())
+  std::vector<EdgeIndex> edges;
+  Vertex junction = bestEntry->junction;
+  for (; predecessorEdges[junction] != noEdge; junction = predecessors[junction])
   {
-    // No path to the goal was found given the current constraints (e.g. every remaining route is
-    // blocked by another runner's reservation). Returning here also avoids reconstructing from a
-    // `goal_state` that was never actually reached: `predecessors`/`arrival_times` have no entry
-    // for it, so `std::map::operator[]` would default-construct one, and the loop below would
-    // underflow `v.time` (unsigned) below zero and never terminate.
-    return path;
+    edges.push_back(predecessorEdges[junction]);
+  }
+  // The search was seeded through the shortest exit into the first junction
+  const CorridorGraph::CorridorWalk* bestExit = nullptr;
+  for (const auto& exit : exits)
+  {
+    if (exit.junction == junction && (bestExit == nullptr || exit.distance < bestExit->distance)) bestExit = &exit;
+  }
+  path.insert(path.end(), bestExit->vertices.begin(), bestExit->vertices.end());
+  for (auto edge = edges.rbegin(); edge != edges.rend(); ++edge)
+  {
+    graph.appendEdgeExpansion(*edge, path);
   }
+  path.insert(path.end(), bestEntry->vertices.begin(), bestEntry->vertices.end());
+  return path;
+}
 
-  for (PositionAtTime v = goal_state; v.vertex != start || v.time > 0; v = PositionAtTime(predecessors[v], v.time - 1))
+Path dijkstra_shortest_path(const CorridorGraph& graph, const Vertex& start, const Vertex& target)
+{
+  return corridor_search<false>(graph, start, target);
+}
+
+Path a_star_shortest_path(const CorridorGraph& graph, const Vertex& start, const Vertex& target)
+{
+  return corridor_search<true>(graph, start, target);
+}
+
+namespace
+{
+// View of a graph without the vertices and edges closed by obstacles, searched when a path has to avoid them
+struct unblocked_graph {
+  const WeightedDiGraph& graph;
+  const Constraints& constraints;
+};
+
+size_t num_vertices(const unblocked_graph& view)
+{
+  return boost::num_vertices(view.graph);
+}
+
+const Point2D& vertex_position(const unblocked_graph& view, Vertex vertex)
+{
+  return ::vertex_position(view.graph, vertex);
+}
+
+template <typename Visitor>
+void for_each_out_edge(const unblocked_graph& view, Vertex vertex, Visitor&& visitor)
+{
+  ::for_each_out_edge(
+      view.graph,
+      vertex,
+      [&](Vertex next, Distance weight)
+      {
+        if (!view.constraints.isVertexBlocked(next) && !view.constraints.isEdgeBlocked(vertex, next))
+        {
+          visitor(next, weight);
+        }
+      });
+}
+
+bool crosses_obstacle(const Path& path, const Constraints& constraints)
+{
+  for (size_t index = 0; index < path.size(); ++index)
   {
-    path.push_back(v.vertex);
+    if (constraints.isVertexBlocked(path[index])
+        || (index > 0 && constraints.isEdgeBlocked(path[index - 1], path[index])))
+    {
+      return true;
+    }
   }
-  path.push_back(start);
-  std::reverse(path.begin(), path.end());
+  return false;
+}
+}  // namespace
 
-  return path;
+MultiAgentShortestPathCalculator multi_agent_shortest_path_calculator_wrapper(const ShortestPathCalculator& calculator)
+{
+  return [calculator](
+             const WeightedDiGraph& graph,
+             const Vertex& start,
+             const Vertex& target,
+             const Constraints& constraints,
+             RunnerId /*runnerId*/)
+  {
+    Path path = calculator(graph, start, target);
+    if (!crosses_obstacle(path, constraints))
+    {
+      return path;
+    }
+    // The wrapped planner knows nothing about obstacles, so route around them with A* on the unblocked graph. The
+    // runner may stand on a blocked vertex already, which it is still allowed to leave.
+    if (constraints.isVertexBlocked(target))
+    {
+      return Path();
+    }
+    const unblocked_graph view{graph, constraints};
+    SearchContext& context = SearchContext::getThreadContext();
+    VertexSearchSpace<unblocked_graph> space(view, start, target, context);
+    BinaryHeapOpenList<Vertex> openList;
+    NullSearchVisitor visitor;
+    best_first_search(space, start, euclidean_distance_heuristic(view, target), openList, visitor);
+    if (!context.isReached(target))
+    {
+      return Path();
+    }
+    return extract_path(context, start, target);
+  };
+}
+
+template <typename Graph, typename Heuristic>
+Path space_time_a_star_search(
+    const Graph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    const Heuristic& heuristic)
+{
+  SpaceTimeSearchSpace<Graph> space(graph, start, goal, constraints, runnerId);
+  BinaryHeapOpenList<PositionAtTime> openList;
+  NullSearchVisitor visitor;
+  best_first_search(space, PositionAtTime(start, 0u), heuristic, openList, visitor);
+  return space.getPath();
+}
+
+Path space_time_a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId)
+{
+  return space_time_a_star_search(
+      graph, start, goal, constraints, runnerId, euclidean_distance_heuristic(graph, goal));
+}
+
+Path space_time_a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId)
+{
+  return space_time_a_star_search(
+      graph, start, goal, constraints, runnerId, euclidean_distance_heuristic(graph, goal));
+}
+
+Path space_time_a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId)
+{
+  return space_time_a_star_search(
+      graph, start, goal, constraints, runnerId, euclidean_distance_heuristic(graph, goal));
+}
+
+Path space_time_a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    const LandmarkTable& landmarks)
+{
+  return space_time_a_star_search(
+      graph, start, goal, constraints, runnerId, landmark_distance_heuristic(landmarks, goal));
+}
+
+Path space_time_a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    const LandmarkTable& landmarks)
+{
+  return space_time_a_star_search(
+      graph, start, goal, constraints, runnerId, landmark_distance_heuristic(landmarks, goal));
+}
+
+Path space_time_a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    const LandmarkTable& landmarks)
+{
+  return space_time_a_star_search(
+      graph, start, goal, constraints, runnerId, landmark_distance_heuristic(landmarks, goal));
+}
+
+MultiAgentShortestPathCalculator space_time_a_star_calculator(const LandmarkTable& landmarks)
+{
+  return [&landmarks](
+             const WeightedDiGraph& graph,
+             const Vertex& start,
+             const Vertex& target,
+             const Constraints& constraints,
+             RunnerId runnerId)
+  { return space_time_a_star_shortest_path(graph, start, target, constraints, runnerId, landmarks); };
+}
+
+Path space_time_a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    ReverseResumableSearch& distances)
+{
+  return space_time_a_star_search(graph, start, goal, constraints, runnerId, reverse_resumable_heuristic(distances));
+}
+
+Path space_time_a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    ReverseResumableSearch& distances)
+{
+  return space_time_a_star_search(graph, start, goal, constraints, runnerId, reverse_resumable_heuristic(distances));
+}
+
+Path space_time_a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& goal,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    ReverseResumableSearch& distances)
+{
+  return space_time_a_star_search(graph, start, goal, constraints, runnerId, reverse_resumable_heuristic(distances));
+}
+
+MultiAgentShortestPathCalculator space_time_a_star_calculator(ReverseResumableSearchCache& cache)
+{
+  return [&cache](
+             const WeightedDiGraph& graph,
+             const Vertex& start,
+             const Vertex& target,
+             const Constraints& constraints,
+             RunnerId runnerId)
+  { return space_time_a_star_shortest_path(graph, start, target, constraints, runnerId, cache.getSearch(target)); };
 }
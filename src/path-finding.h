@@ -5,42 +5,203 @@
 #include <functional>
 
 #include "constraints.h"
+#include "corridor-graph.h"
+#include "csr-graph.h"
 #include "graph.h"
-
-class manhattan_distance_heuristic : public boost::astar_heuristic<WeightedDiGraph, Distance>
-{
- public:
-  manhattan_distance_heuristic(WeightedDiGraph graph, Vertex goal);
-  Distance operator()(Vertex v);
-
- private:
-  WeightedDiGraph m_graph;
-  Vertex m_goal;
-};
-
-// euclidean distance heuristic
-class euclidean_distance_heuristic : public boost::astar_heuristic<WeightedDiGraph, Distance>
-{
- public:
-  euclidean_distance_heuristic(WeightedDiGraph graph, Vertex goal);
-  Distance operator()(Vertex v);
-
- private:
-  WeightedDiGraph m_graph;
-  Vertex m_goal;
-};
+#include "grid-graph.h"
+#include "heuristics.h"
+#include "landmarks.h"
+#include "reverse-resumable-search.h"
+#include "search-context.h"
+#include "tiled-grid-graph.h"
 
 typedef std::function<std::vector<Vertex>(const WeightedDiGraph& graph, const Vertex& start)> ShortestPathsCalculator;
 std::vector<Vertex> boost_dijkstra_shortest_paths(const WeightedDiGraph& graph, const Vertex& start);
 std::vector<Vertex> dijkstra_shortest_paths(const WeightedDiGraph& graph, const Vertex& start);
+std::vector<Vertex> dijkstra_shortest_paths(const CompressedSparseRowGraph& graph, const Vertex& start);
+std::vector<Vertex> dijkstra_shortest_paths(const GridGraph& graph, const Vertex& start);
+std::vector<Vertex> dijkstra_shortest_paths(const TiledGridGraph& graph, const Vertex& start);
+
+/// @brief Priority queue holding the open states of a planner (see `open-lists.h`). The bucketed queues order integral
+/// priorities only, and suit graphs whose edge weights are integral, like the unit-weight grids of map files. The
+/// indexed heap updates open states in place instead of holding a duplicate for every improved distance.
+enum class OpenListType { BinaryHeap, Buckets, TwoLevelBuckets, RadixHeap, IndexedHeap };
+
+/// The planners taking a `SearchContext` keep their per-vertex arrays in it, so that repeated queries on the same
+/// graph don't allocate and clear O(V) memory each. The others use the context of the calling thread and a binary heap.
+std::vector<Vertex> dijkstra_shortest_paths(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+std::vector<Vertex> dijkstra_shortest_paths(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+std::vector<Vertex> dijkstra_shortest_paths(
+    const GridGraph& graph,
+    const Vertex& start,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+std::vector<Vertex> dijkstra_shortest_paths(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
 
 typedef std::function<Path(const WeightedDiGraph& graph, const Vertex& start, const Vertex& target)>
     ShortestPathCalculator;
 
+/// @brief Checks that the graph a `ShortestPathCalculator` is called with matches the `numberOfVertices` of the graph
+/// its `planner` (named in the error) was built for, as such planners search their own graph and ignore the given one.
+/// @throws std::invalid_argument if the numbers of vertices differ.
+void check_calculator_graph(const WeightedDiGraph& graph, size_t numberOfVertices, const char* planner);
+
 Path boost_dijkstra_shortest_path(const WeightedDiGraph& graph, const Vertex& start, const Vertex& target);
 Path dijkstra_shortest_path(const WeightedDiGraph& graph, const Vertex& start, const Vertex& target);
+Path dijkstra_shortest_path(const CompressedSparseRowGraph& graph, const Vertex& start, const Vertex& target);
+Path dijkstra_shortest_path(const GridGraph& graph, const Vertex& start, const Vertex& target);
+Path dijkstra_shortest_path(const TiledGridGraph& graph, const Vertex& start, const Vertex& target);
 Path boost_a_star_shortest_path(const WeightedDiGraph& graph, const Vertex& start, const Vertex& target);
 Path a_star_shortest_path(const WeightedDiGraph& graph, const Vertex& start, const Vertex& target);
+Path a_star_shortest_path(const CompressedSparseRowGraph& graph, const Vertex& start, const Vertex& target);
+Path a_star_shortest_path(const GridGraph& graph, const Vertex& start, const Vertex& target);
+Path a_star_shortest_path(const TiledGridGraph& graph, const Vertex& start, const Vertex& target);
+Path dijkstra_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path dijkstra_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path dijkstra_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path dijkstra_shortest_path(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path a_star_shortest_path(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    SearchContext& context,
+    OpenListType openListType = OpenListType::BinaryHeap);
+/// A* guided by the lower bounds of `landmarks`, which must have been computed on a graph whose vertices are numbered
+/// like those of `graph`, e.g. the compressed graph of the same `MapGraphLoader`.
+Path a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const LandmarkTable& landmarks,
+    SearchContext& context = SearchContext::getThreadContext(),
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const LandmarkTable& landmarks,
+    SearchContext& context = SearchContext::getThreadContext(),
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const LandmarkTable& landmarks,
+    SearchContext& context = SearchContext::getThreadContext(),
+    OpenListType openListType = OpenListType::BinaryHeap);
+Path a_star_shortest_path(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const LandmarkTable& landmarks,
+    SearchContext& context = SearchContext::getThreadContext(),
+    OpenListType openListType = OpenListType::BinaryHeap);
+/// Search the reduced graph of junctions and unpack the result, `start` and `target` being original vertices.
+Path dijkstra_shortest_path(const CorridorGraph& graph, const Vertex& start, const Vertex& target);
+Path a_star_shortest_path(const CorridorGraph& graph, const Vertex& start, const Vertex& target);
+
+/// @brief Shortest paths from `start` to each of `targets`, from a single Dijkstra search that ends once the last of
+/// them is settled, instead of a search per target. The path to a target that can't be reached is empty.
+std::vector<Path> multi_target_dijkstra_shortest_paths(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+std::vector<Path> multi_target_dijkstra_shortest_paths(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+std::vector<Path> multi_target_dijkstra_shortest_paths(
+    const GridGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+std::vector<Path> multi_target_dijkstra_shortest_paths(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+/// @brief Like `multi_target_dijkstra_shortest_paths`, guided by the Euclidean distance to the bounding box of the
+/// targets. It saves most when the targets lie close together, like the drop-off stations of one area, away from
+/// `start`. The Euclidean distance must be consistent with the edge weights, as for `a_star_shortest_path`.
+std::vector<Path> multi_target_a_star_shortest_paths(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+std::vector<Path> multi_target_a_star_shortest_paths(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+std::vector<Path> multi_target_a_star_shortest_paths(
+    const GridGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+std::vector<Path> multi_target_a_star_shortest_paths(
+    const TiledGridGraph& graph,
+    const Vertex& start,
+    const std::vector<Vertex>& targets,
+    SearchContext& context = SearchContext::getThreadContext());
+
+/// The planners above are overloaded on the graph type. Cast to this type to pick the `WeightedDiGraph` overload when
+/// binding one of them to a `ShortestPathCalculator`.
+typedef Path (*ShortestPathFunction)(const WeightedDiGraph& graph, const Vertex& start, const Vertex& target);
+
+/// @brief Binds A* with the bounds of `landmarks` to a `ShortestPathCalculator`. The table must outlive it.
+ShortestPathCalculator a_star_calculator(const LandmarkTable& landmarks);
 
 typedef std::function<Path(
     const WeightedDiGraph& graph,
@@ -50,6 +211,16 @@ typedef std::function<Path(
     RunnerId runnerId)>
     MultiAgentShortestPathCalculator;
 
+typedef Path (*MultiAgentShortestPathFunction)(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId);
+
+/// @brief Adapts a single-agent planner, which ignores the runner locks. A path of the planner crossing a blocked
+/// vertex or edge is replaced by one of A* on the graph without the blocked vertices and edges, or by an empty path if
+/// the obstacles cut the target off.
 MultiAgentShortestPathCalculator multi_agent_shortest_path_calculator_wrapper(const ShortestPathCalculator& calculator);
 
 Path space_time_a_star_shortest_path(
@@ -58,3 +229,68 @@ Path space_time_a_star_shortest_path(
     const Vertex& target,
     const Constraints& constraints,
     RunnerId runnerId);
+Path space_time_a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId);
+Path space_time_a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId);
+/// Space-Time A* guided by the lower bounds of `landmarks`. Waiting only adds to the distance, so the bounds of the
+/// graph hold in space-time as well.
+Path space_time_a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    const LandmarkTable& landmarks);
+Path space_time_a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    const LandmarkTable& landmarks);
+Path space_time_a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    const LandmarkTable& landmarks);
+/// @brief Binds Space-Time A* with the bounds of `landmarks` to a `MultiAgentShortestPathCalculator`. The table must
+/// outlive it.
+MultiAgentShortestPathCalculator space_time_a_star_calculator(const LandmarkTable& landmarks);
+/// Space-Time A* guided by the exact distances of `distances`, a search backwards from `target` on a graph with the
+/// same vertices as `graph`, which is resumed as far as this query needs.
+Path space_time_a_star_shortest_path(
+    const WeightedDiGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    ReverseResumableSearch& distances);
+Path space_time_a_star_shortest_path(
+    const CompressedSparseRowGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    ReverseResumableSearch& distances);
+Path space_time_a_star_shortest_path(
+    const GridGraph& graph,
+    const Vertex& start,
+    const Vertex& target,
+    const Constraints& constraints,
+    RunnerId runnerId,
+    ReverseResumableSearch& distances);
+/// @brief Binds Space-Time A* guided by the reverse resumable searches of `cache` to a
+/// `MultiAgentShortestPathCalculator`, e.g. the one of a `Simulation`, so that all its runners and replans share the
+/// searches towards their goals. The cache must outlive the calculator.
+MultiAgentShortestPathCalculator space_time_a_star_calculator(ReverseResumableSearchCache& cache);
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+
 #include "sequence.h"
 
 TEST(shortest_paths, boost_dijkstra_shortest_paths)
@@ -116,7 +118,7 @@ TEST(manhattan_distance_heuristic, distance)
 {
   DefaultGraphLoader loader;
   const auto graph = loader.getGraph();
-  manhattan_distance_heuristic heuristic(graph, 3);
+  manhattan_distance_heuristic heuristic(*graph, 3);
   EXPECT_EQ(heuristic(0), 8);  // [0,1] - [3, -4]
 }
 
@@ -124,7 +126,7 @@ TEST(euclidean_distance_heuristic, distance)
 {
   DefaultGraphLoader loader;
   const auto graph = loader.getGraph();
-  euclidean_distance_heuristic heuristic(graph, 3);
+  euclidean_distance_heuristic heuristic(*graph, 3);
   EXPECT_NEAR(heuristic(0), 5.8309f, 1E-03);  // [0,1] - [3, -4]
 }
 
@@ -288,3 +290,136 @@ TEST(shortest_path, space_time_a_star_shortest_path_returns_empty_path_if_swappi
 
   EXPECT_TRUE(path.empty());
 }
+
+TEST(shortest_path, multi_agent_wrapper_routes_single_agent_planner_around_obstacles)
+{
+  // 3x3 grid of unit edges, numbered row by row
+  WeightedDiGraph graph(9);
+  for (Vertex vertex = 0; vertex < 9; ++vertex)
+  {
+    graph[vertex].position = {float(vertex % 3), float(vertex / 3)};
+    if (vertex % 3 < 2)
+    {
+      add_edge(vertex, vertex + 1, 1.0f, graph);
+      add_edge(vertex + 1, vertex, 1.0f, graph);
+    }
+    if (vertex < 6)
+    {
+      add_edge(vertex, vertex + 3, 1.0f, graph);
+      add_edge(vertex + 3, vertex, 1.0f, graph);
+    }
+  }
+  const MultiAgentShortestPathCalculator calculator =
+      multi_agent_shortest_path_calculator_wrapper(ShortestPathFunction(a_star_shortest_path));
+  Constraints constraints(graph);
+  EXPECT_EQ(calculator(graph, 0, 2, constraints, 0), (Path{0, 1, 2}));
+
+  constraints.onVertexBlocked(1);
+  EXPECT_EQ(calculator(graph, 0, 2, constraints, 0), (Path{0, 3, 4, 5, 2}));
+  constraints.onEdgeBlocked(4, 5);
+  EXPECT_EQ(calculator(graph, 0, 2, constraints, 0), (Path{0, 3, 4, 7, 8, 5, 2}));
+  constraints.onVertexBlocked(7);
+  EXPECT_TRUE(calculator(graph, 0, 2, constraints, 0).empty());
+}
+
+TEST(shortest_path, planners_return_equally_long_paths_on_compressed_sparse_row_graph)
+{
+  MapGraphLoader loader(
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/maze-32-32-2/maze-32-32-2.map")
+          .make_preferred()
+          .string());
+  const auto& graph = *loader.getGraph();
+  const auto compressedGraph = loader.getCompressedGraph();
+  const Vertex start = 0;
+  const Vertex target = static_cast<Vertex>(boost::num_vertices(graph) - 1);
+
+  EXPECT_EQ(dijkstra_shortest_paths(compressedGraph, start), dijkstra_shortest_paths(graph, start));
+
+  const Path path = dijkstra_shortest_path(graph, start, target);
+  EXPECT_EQ(dijkstra_shortest_path(compressedGraph, start, target), path);
+  EXPECT_EQ(a_star_shortest_path(compressedGraph, start, target), a_star_shortest_path(graph, start, target));
+  EXPECT_EQ(a_star_shortest_path(compressedGraph, start, target).size(), path.size());
+
+  // Space-Time A* floods the time-expanded graph on long maze routes, so keep its query short.
+  const Vertex nearbyTarget = path[4];
+  Constraints constraints(compressedGraph.getNumberOfVertices());
+  const Path spaceTimePath = space_time_a_star_shortest_path(compressedGraph, start, nearbyTarget, constraints, 0);
+  EXPECT_EQ(spaceTimePath, space_time_a_star_shortest_path(graph, start, nearbyTarget, constraints, 0));
+  EXPECT_EQ(spaceTimePath.front(), start);
+  EXPECT_EQ(spaceTimePath.back(), nearbyTarget);
+}
+
+TEST(shortest_path, planners_return_the_same_paths_on_grid_graph)
+{
+  const std::string filename =
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/warehouse-10-20-10-2-1/warehouse-10-20-10-2-1.map")
+          .make_preferred()
+          .string();
+  MapGraphLoader mapLoader(filename);
+  GridGraphLoader gridLoader(filename);
+  const auto& graph = *mapLoader.getGraph();
+  const auto& gridGraph = gridLoader.getGraph();
+  const Vertex start = 0;
+  const Vertex target = static_cast<Vertex>(boost::num_vertices(graph) - 1);
+
+  EXPECT_EQ(dijkstra_shortest_paths(gridGraph, start), dijkstra_shortest_paths(graph, start));
+  EXPECT_EQ(dijkstra_shortest_path(gridGraph, start, target), dijkstra_shortest_path(graph, start, target));
+  EXPECT_EQ(a_star_shortest_path(gridGraph, start, target), a_star_shortest_path(graph, start, target));
+
+  const Vertex nearbyTarget = a_star_shortest_path(graph, start, target)[4];
+  Constraints constraints(gridGraph.getNumberOfVertices());
+  EXPECT_EQ(
+      space_time_a_star_shortest_path(gridGraph, start, nearbyTarget, constraints, 0),
+      space_time_a_star_shortest_path(graph, start, nearbyTarget, constraints, 0));
+}
+
+TEST(shortest_path, multi_target_shortest_paths_settle_every_target_in_one_search)
+{
+  const auto graph = DefaultGraphLoader().getGraph();
+  EXPECT_EQ(multi_target_dijkstra_shortest_paths(*graph, 0, {2, 3, 0}), (std::vector<Path>{{0, 3, 2}, {0, 3}, {0}}));
+  EXPECT_EQ(multi_target_dijkstra_shortest_paths(*graph, 2, {0, 2}), (std::vector<Path>{{}, {2}}));
+  EXPECT_TRUE(multi_target_dijkstra_shortest_paths(*graph, 1, {}).empty());
+}
+
+TEST(shortest_path, multi_target_a_star_explores_less_for_clustered_targets)
+{
+  MapGraphLoader loader(
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/warehouse-10-20-10-2-1/warehouse-10-20-10-2-1.map")
+          .make_preferred()
+          .string());
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const size_t numberOfVertices = graph.getNumberOfVertices();
+  const Vertex start = 0;
+  // Stations along the middle of a route across the map, one of them twice
+  const Path route = dijkstra_shortest_path(graph, start, static_cast<Vertex>(numberOfVertices - 1));
+  const auto middle = route.begin() + static_cast<std::ptrdiff_t>(route.size() / 2);
+  const std::vector<Vertex> targets(middle - 3, middle + 3);
+  std::vector<Vertex> stations(targets.rbegin(), targets.rend());
+  stations.push_back(targets.front());
+
+  auto countExpandedVertices = [numberOfVertices](const SearchContext& context)
+  {
+    size_t count = 0;
+    for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+    {
+      if (context.isExpanded(vertex)) ++count;
+    }
+    return count;
+  };
+  SearchContext context;
+  const std::vector<Path> dijkstraPaths = multi_target_dijkstra_shortest_paths(graph, start, stations, context);
+  const size_t dijkstraExpansions = countExpandedVertices(context);
+  const std::vector<Path> aStarPaths = multi_target_a_star_shortest_paths(graph, start, stations, context);
+  const size_t aStarExpansions = countExpandedVertices(context);
+
+  ASSERT_EQ(dijkstraPaths.size(), stations.size());
+  ASSERT_EQ(aStarPaths.size(), stations.size());
+  for (size_t index = 0; index < stations.size(); ++index)
+  {
+    const size_t length = dijkstra_shortest_path(graph, start, stations[index]).size();
+    EXPECT_EQ(dijkstraPaths[index].size(), length) << index;
+    EXPECT_EQ(aStarPaths[index].size(), length) << index;
+    EXPECT_EQ(aStarPaths[index].back(), stations[index]);
+  }
+  EXPECT_LT(aStarExpansions * 2, dijkstraExpansions) << aStarExpansions << " vs. " << dijkstraExpansions;
+}
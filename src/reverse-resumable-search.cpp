@@ -0,0 +1,115 @@
+#include "reverse-resumable-search.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "heuristics.h"
+
+ReverseResumableSearch::ReverseResumableSearch(
+    std::shared_ptr<const CompressedSparseRowGraph> reverseGraph, Vertex goal)
+    : reverseGraph(std::move(reverseGraph))
+    , goal(goal)
+    , distances(this->reverseGraph->getNumberOfVertices(), std::numeric_limits<Distance>::max())
+    , expanded(this->reverseGraph->getNumberOfVertices(), false)
+    , numberOfExpandedVertices(0)
+{
+  distances[goal] = 0.0f;
+}
+
+Vertex ReverseResumableSearch::getGoal() const
+{
+  return goal;
+}
+
+size_t ReverseResumableSearch::getNumberOfExpandedVertices() const
+{
+  return numberOfExpandedVertices;
+}
+
+Distance ReverseResumableSearch::getDistance(Vertex vertex)
+{
+  if (expanded[vertex]) return distances[vertex];
+
+  const float* x = reverseGraph->getX();
+  const float* y = reverseGraph->getY();
+  auto estimate = [this, x, y](Vertex next)
+  {
+    Distance distance;
+    euclidean_distances(x + next, y + next, 1, *origin, &distance);
+    return distance;
+  };
+  if (!origin)
+  {
+    origin = reverseGraph->getPosition(vertex);
+    openList.emplace(estimate(goal), goal);
+  }
+
+  while (!openList.empty())
+  {
+    const Vertex current = openList.top().second;
+    openList.pop();
+    if (expanded[current]) continue;
+    expanded[current] = true;
+    ++numberOfExpandedVertices;
+    // In-edges of the original graph, as the search runs from the goal backwards
+    for_each_out_edge(
+        *reverseGraph,
+        current,
+        [&](Vertex previous, Distance weight)
+        {
+          if (!expanded[previous] && distances[current] + weight < distances[previous])
+          {
+            distances[previous] = distances[current] + weight;
+            openList.emplace(distances[previous] + estimate(previous), previous);
+          }
+        });
+    if (current == vertex) return distances[vertex];
+  }
+  // The search is exhausted, so every vertex not expanded yet can't reach the goal
+  return std::numeric_limits<Distance>::max();
+}
+
+ReverseResumableSearchCache::ReverseResumableSearchCache(const CompressedSparseRowGraph& graph, size_t capacity)
+    : reverseGraph(std::make_shared<const CompressedSparseRowGraph>(reverse_graph(graph)))
+    , capacity(capacity)
+{
+  if (capacity == 0)
+  {
+    throw std::invalid_argument("Reverse resumable search cache needs a capacity of at least 1 goal.");
+  }
+}
+
+ReverseResumableSearch& ReverseResumableSearchCache::getSearch(Vertex goal)
+{
+  const auto found = searchesByGoal.find(goal);
+  if (found != searchesByGoal.end())
+  {
+    searches.splice(searches.begin(), searches, found->second);
+    return searches.front();
+  }
+
+  if (searches.size() == capacity)
+  {
+    searchesByGoal.erase(searches.back().getGoal());
+    searches.pop_back();
+  }
+  searches.emplace_front(reverseGraph, goal);
+  searchesByGoal.emplace(goal, searches.begin());
+  return searches.front();
+}
+
+size_t ReverseResumableSearchCache::getNumberOfSearches() const
+{
+  return searches.size();
+}
+
+size_t ReverseResumableSearchCache::getCapacity() const
+{
+  return capacity;
+}
+
+void ReverseResumableSearchCache::clear()
+{
+  searchesByGoal.clear();
+  searches.clear();
+}
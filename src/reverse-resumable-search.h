@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "csr-graph.h"
+#include "geometry.h"
+#include "graph.h"
+
+/// @brief Reverse Resumable A* (RRA*, see [./doc/coop-path-AIWisdom.pdf](Cooperative Pathfinding)): the exact distance
+/// of any vertex to a goal, ignoring other runners, from an A* search backwards from the goal. The search runs only as
+/// far as the queried vertices need: it is guided towards the first of them, and resumed for every later query of a
+/// vertex it hasn't expanded yet. The Euclidean distance guiding it must be consistent, as for `a_star_shortest_path`.
+///
+/// As the heuristic of Space-Time A*, the exact distances lead the search straight to the goal, and it only expands
+/// states off the shortest route where other runners are in the way.
+class ReverseResumableSearch
+{
+ public:
+  /// @param reverseGraph Graph with every edge reversed, see `reverse_graph`.
+  ReverseResumableSearch(std::shared_ptr<const CompressedSparseRowGraph> reverseGraph, Vertex goal);
+
+  Vertex getGoal() const;
+  /// @brief Number of vertices expanded so far, over all queries.
+  size_t getNumberOfExpandedVertices() const;
+
+  /// @brief Distance from `vertex` to the goal, or the maximum distance if the goal can't be reached from it.
+  Distance getDistance(Vertex vertex);
+
+ private:
+  typedef std::pair<Distance, Vertex> Entry;
+
+  std::shared_ptr<const CompressedSparseRowGraph> reverseGraph;
+  Vertex goal;
+  /// Position of the first queried vertex, towards which the search is guided
+  std::optional<Point2D> origin;
+  std::vector<Distance> distances;
+  std::vector<bool> expanded;
+  size_t numberOfExpandedVertices;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> openList;
+};
+
+/// @brief Heuristic of Space-Time A* from a `ReverseResumableSearch` towards its goal, resuming the search for the
+/// scored vertices it hasn't expanded yet.
+class reverse_resumable_heuristic
+{
+ public:
+  explicit reverse_resumable_heuristic(ReverseResumableSearch& search) : m_search(search)
+  {
+  }
+
+  Distance operator()(Vertex v) const
+  {
+    return m_search.getDistance(v);
+  }
+
+  void operator()(const Vertex* vertices, size_t count, Distance* distances) const
+  {
+    for (size_t index = 0; index < count; ++index)
+    {
+      distances[index] = m_search.getDistance(vertices[index]);
+    }
+  }
+
+ private:
+  ReverseResumableSearch& m_search;
+};
+
+/// @brief Reverse resumable searches of a graph by goal, so that runners heading to the same goal, or replanning
+/// towards it later on, resume the search where the previous queries left it. The searches ignore `Obstacles`, and are
+/// kept when they change: the distances around obstacles are only longer, so the cached ones are still consistent
+/// estimates.
+///
+/// Every search holds arrays over all vertices, so at most `capacity` goals are kept, the least recently used search
+/// being dropped for a new goal: memory stays within `capacity` times the size of the graph, however many distinct
+/// goals a lifelong scenario has.
+class ReverseResumableSearchCache
+{
+ public:
+  static constexpr size_t DefaultCapacity = 16;
+
+  /// @param capacity Number of goals whose searches are kept, at least 1.
+  /// @throws std::invalid_argument if `capacity` is 0.
+  explicit ReverseResumableSearchCache(const CompressedSparseRowGraph& graph, size_t capacity = DefaultCapacity);
+
+  /// @brief Search towards `goal`, started on first use. The search stays valid until a later call drops it.
+  ReverseResumableSearch& getSearch(Vertex goal);
+  size_t getNumberOfSearches() const;
+  size_t getCapacity() const;
+  void clear();
+
+ private:
+  std::shared_ptr<const CompressedSparseRowGraph> reverseGraph;
+  size_t capacity;
+  /// Most recently used search first
+  std::list<ReverseResumableSearch> searches;
+  std::unordered_map<Vertex, std::list<ReverseResumableSearch>::iterator> searchesByGoal;
+};
@@ -0,0 +1,151 @@
+#include "reverse-resumable-search.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "best-first-search.h"
+#include "path-finding.h"
+#include "simulation.h"
+#include "test-data.h"
+
+namespace
+{
+struct ExpansionCounter {
+  size_t examinedStates = 0;
+
+  void examineState(const PositionAtTime&)
+  {
+    ++examinedStates;
+  }
+
+  void generateState(const PositionAtTime&)
+  {
+  }
+};
+
+template <typename Heuristic>
+size_t countSpaceTimeExpansions(
+    const CompressedSparseRowGraph& graph, Vertex start, Vertex goal, const Heuristic& heuristic)
+{
+  Constraints constraints(graph.getNumberOfVertices());
+  SpaceTimeSearchSpace<CompressedSparseRowGraph> space(graph, start, goal, constraints, 0);
+  BinaryHeapOpenList<PositionAtTime> openList;
+  ExpansionCounter counter;
+  best_first_search(space, PositionAtTime(start, 0u), heuristic, openList, counter);
+  return counter.examinedStates;
+}
+}  // namespace
+
+TEST(ReverseResumableSearch, returns_distances_to_the_goal_on_directed_graph)
+{
+  DefaultGraphLoader loader;
+  const CompressedSparseRowGraph graph(*loader.getGraph());
+  ReverseResumableSearch search(std::make_shared<const CompressedSparseRowGraph>(reverse_graph(graph)), 2);
+
+  EXPECT_EQ(search.getGoal(), 2u);
+  EXPECT_EQ(search.getDistance(1), 1.0f);
+  EXPECT_EQ(search.getDistance(3), 1.0f);
+  EXPECT_EQ(search.getDistance(2), 0.0f);
+
+  ReverseResumableSearch searchToStart(std::make_shared<const CompressedSparseRowGraph>(reverse_graph(graph)), 0);
+  EXPECT_EQ(searchToStart.getDistance(3), std::numeric_limits<Distance>::max());
+}
+
+TEST(ReverseResumableSearch, resumes_only_as_far_as_the_queries_need)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+  const Vertex goal = numberOfVertices / 2;
+  ReverseResumableSearchCache cache(graph);
+  ReverseResumableSearch& search = cache.getSearch(goal);
+
+  const Path path = dijkstra_shortest_path(graph, goal, 0);
+  // Distances to the goal are distances from it, as the edges of the map graph go both ways
+  EXPECT_EQ(search.getDistance(path[1]), 1.0f);
+  const size_t expandedVertices = search.getNumberOfExpandedVertices();
+  EXPECT_LT(expandedVertices, size_t(numberOfVertices));
+  EXPECT_EQ(search.getDistance(goal), 0.0f);
+  EXPECT_EQ(search.getNumberOfExpandedVertices(), expandedVertices);
+
+  SearchContext context;
+  dijkstra_shortest_paths(graph, goal, context);
+  for (Vertex vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    EXPECT_EQ(search.getDistance(vertex), context.getDistance(vertex)) << vertex;
+  }
+  EXPECT_EQ(&cache.getSearch(goal), &search);
+  EXPECT_EQ(cache.getNumberOfSearches(), 1u);
+}
+
+TEST(ReverseResumableSearch, space_time_a_star_expands_fewer_states_than_with_euclidean_distances)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const Vertex start = 0;
+  const Path path = a_star_shortest_path(graph, start, static_cast<Vertex>(graph.getNumberOfVertices() - 1));
+  const Vertex goal = path[std::min<size_t>(path.size() - 1, 24)];
+  ReverseResumableSearchCache cache(graph);
+
+  const size_t expansions = countSpaceTimeExpansions(graph, start, goal, euclidean_distance_heuristic(graph, goal));
+  const size_t resumableExpansions =
+      countSpaceTimeExpansions(graph, start, goal, reverse_resumable_heuristic(cache.getSearch(goal)));
+  EXPECT_LT(resumableExpansions * 2, expansions) << resumableExpansions << " vs. " << expansions;
+
+  Constraints constraints(graph.getNumberOfVertices());
+  const Path spaceTimePath =
+      space_time_a_star_shortest_path(graph, start, goal, constraints, 0, cache.getSearch(goal));
+  EXPECT_EQ(spaceTimePath.size(), std::min<size_t>(path.size(), 25));
+  EXPECT_EQ(spaceTimePath.back(), goal);
+}
+
+TEST(ReverseResumableSearchCache, keeps_at_most_capacity_searches)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  ReverseResumableSearchCache cache(graph, 2);
+  EXPECT_EQ(cache.getCapacity(), 2u);
+  EXPECT_THROW(ReverseResumableSearchCache(graph, 0), std::invalid_argument);
+
+  for (Vertex goal = 0; goal < 10; ++goal)
+  {
+    EXPECT_EQ(cache.getSearch(goal).getGoal(), goal);
+    EXPECT_LE(cache.getNumberOfSearches(), 2u);
+  }
+  // Goal 8 becomes the most recently used, so goal 9 is dropped for goal 0
+  ReverseResumableSearch& search = cache.getSearch(8);
+  search.getDistance(1);
+  cache.getSearch(0);
+  EXPECT_EQ(&cache.getSearch(8), &search);
+  EXPECT_GT(search.getNumberOfExpandedVertices(), 0u);
+  EXPECT_EQ(cache.getNumberOfSearches(), 2u);
+  cache.getSearch(9);
+  EXPECT_EQ(cache.getSearch(9).getNumberOfExpandedVertices(), 0u);
+
+  cache.clear();
+  EXPECT_EQ(cache.getNumberOfSearches(), 0u);
+}
+
+class ReverseResumableSearchSimulationTest : public RunnerIdsRestoringTest
+{
+};
+
+TEST_F(ReverseResumableSearchSimulationTest, is_shared_by_the_runners_of_a_simulation)
+{
+  MapGraphLoader loader(getMapFilename("maze-32-32-2"));
+  ReverseResumableSearchCache cache(loader.getCompressedGraph());
+  const auto last = static_cast<Vertex>(loader.getCompressedGraph().getNumberOfVertices() - 1);
+  std::vector<JobRequest> jobRequests{JobRequest(0, last), JobRequest(last / 2, last), JobRequest(3, last / 2)};
+  Simulation simulation(jobRequests, loader.getGraph(), 2, space_time_a_star_calculator(cache));
+
+  const unsigned timeout = 1000;
+  while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
+  {
+    simulation.advance();
+  }
+  EXPECT_TRUE(simulation.isFinished());
+  EXPECT_EQ(simulation.getFinishedJobRequests().size(), 3u);
+  // Both runners heading to the last vertex resume the same search
+  EXPECT_EQ(cache.getNumberOfSearches(), 2u);
+}
@@ -2,14 +2,14 @@
 
 RunnerId lastRunnerId = static_cast<RunnerId>(0);
 
-Runner::Runner(WeightedDiGraph graph, Vertex initialPosition)
+Runner::Runner(SharedGraph graph, Vertex initialPosition)
     : id(lastRunnerId++)
     , graph(graph)
     , lastVisitedVertex(initialPosition)
     , destinationVertex(initialPosition)
     , indexOfLastVisitedPathVertex(0)
 {
-  position = graph.m_vertices[initialPosition].m_property.position;
+  position = (*graph)[initialPosition].position;
 }
 
 RunnerId Runner::getId() const
@@ -81,14 +81,14 @@ void Runner::travel(const Path& trajectory, bool allowTeleport)
       if (allowTeleport)
       {
         lastVisitedVertex = path[0];
-        position = graph[lastVisitedVertex].position;
+        position = (*graph)[lastVisitedVertex].position;
       }
       else
       {
         std::ostringstream message;
         message << "Runner '" << getId() << "' rejects the path, because it does not start at the current position '"
                 << lastVisitedVertex << "', " << position << ", but starts at '" << path[0] << "', "
-                << graph.m_vertices[path[0]].m_property.position << ", full path: " << path;
+                << (*graph)[path[0]].position << ", full path: " << path;
         throw std::runtime_error(message.str());
       }
     }
@@ -102,6 +102,6 @@ void Runner::advance()
   {
     ++indexOfLastVisitedPathVertex;
     lastVisitedVertex = path[indexOfLastVisitedPathVertex];
-    position = graph.m_vertices[lastVisitedVertex].m_property.position;
+    position = (*graph)[lastVisitedVertex].position;
   }
 }
@@ -8,7 +8,7 @@ class Runner
 {
  public:
   Runner() = delete;
-  Runner(WeightedDiGraph graph, Vertex initialPosition);
+  Runner(SharedGraph graph, Vertex initialPosition);
 
   RunnerId getId() const;
   const Path& getPath() const;
@@ -29,7 +29,7 @@ class Runner
 
  private:
   RunnerId id;
-  WeightedDiGraph graph;
+  SharedGraph graph;
   Path path;
   unsigned indexOfLastVisitedPathVertex;
   Point2D position;
@@ -28,7 +28,7 @@ TEST(Runner, assigns_initial_position)
   Runner runner(graph, initialVertex);
   ASSERT_EQ(runner.getLastVisitedVertex(), initialVertex);
   ASSERT_EQ(runner.getDestinationVertex(), initialVertex);
-  ASSERT_EQ(runner.getPosition(), graph.m_vertices[initialVertex].m_property.position);
+  ASSERT_EQ(runner.getPosition(), (*graph)[initialVertex].position);
   ASSERT_EQ(runner.getPath(), Path());
   ASSERT_FALSE(runner.isTraveling());
   ASSERT_TRUE(runner.isInDestination());
@@ -44,7 +44,7 @@ TEST(Runner, assignment_of_trajectory_updates_destination_vertex)
   runner.travel({0, 1, 2, 3});
   ASSERT_EQ(runner.getLastVisitedVertex(), initialVertex);
   ASSERT_EQ(runner.getDestinationVertex(), 3);
-  ASSERT_EQ(runner.getPosition(), graph.m_vertices[initialVertex].m_property.position);
+  ASSERT_EQ(runner.getPosition(), (*graph)[initialVertex].position);
   ASSERT_EQ(runner.getPath(), Path({0, 1, 2, 3}));
   ASSERT_TRUE(runner.isTraveling());
   ASSERT_FALSE(runner.isInDestination());
@@ -76,8 +76,8 @@ TEST(
   runner.travel({2, 3}, true);
   EXPECT_EQ(runner.getLastVisitedVertex(), 2);
   EXPECT_EQ(runner.getDestinationVertex(), 3);
-  EXPECT_NEAR(runner.getPosition().x, graph.m_vertices[2].m_property.position.x, 1E-03);
-  EXPECT_NEAR(runner.getPosition().y, graph.m_vertices[2].m_property.position.y, 1E-03);
+  EXPECT_NEAR(runner.getPosition().x, (*graph)[2].position.x, 1E-03);
+  EXPECT_NEAR(runner.getPosition().y, (*graph)[2].position.y, 1E-03);
   EXPECT_EQ(runner.getPath(), Path({2, 3}));
   EXPECT_TRUE(runner.isTraveling());
   EXPECT_FALSE(runner.isInDestination());
@@ -96,7 +96,7 @@ TEST(Runner, advances_position_of_the_runer_to_next_vertex)
   runner.advance();
   ASSERT_EQ(runner.getLastVisitedVertex(), 1);
   ASSERT_EQ(runner.getDestinationVertex(), 3);
-  ASSERT_EQ(runner.getPosition(), graph.m_vertices[1].m_property.position);
+  ASSERT_EQ(runner.getPosition(), (*graph)[1].position);
   ASSERT_EQ(runner.getPath(), Path({0, 1, 2, 3}));
   ASSERT_EQ(runner.getRemainingPath(), Path({1, 2, 3}));
   ASSERT_TRUE(runner.isTraveling());
@@ -114,7 +114,7 @@ TEST(Runner, finishes_traveling_when_reached_destination)
   runner.advance();
   ASSERT_EQ(runner.getLastVisitedVertex(), 1);
   ASSERT_EQ(runner.getDestinationVertex(), 1);
-  ASSERT_EQ(runner.getPosition(), graph.m_vertices[1].m_property.position);
+  ASSERT_EQ(runner.getPosition(), (*graph)[1].position);
   ASSERT_EQ(runner.getPath(), Path({0, 1}));
   ASSERT_FALSE(runner.isTraveling());
   ASSERT_TRUE(runner.isInDestination());
@@ -131,7 +131,7 @@ TEST(Runner, advance_does_not_change_state_of_runner_if_already_reached_the_dest
   runner.advance();
   ASSERT_EQ(runner.getLastVisitedVertex(), 1);
   ASSERT_EQ(runner.getDestinationVertex(), 1);
-  ASSERT_EQ(runner.getPosition(), graph.m_vertices[1].m_property.position);
+  ASSERT_EQ(runner.getPosition(), (*graph)[1].position);
   ASSERT_EQ(runner.getPath(), Path({0, 1}));
   ASSERT_FALSE(runner.isTraveling());
   ASSERT_TRUE(runner.isInDestination());
@@ -139,7 +139,7 @@ TEST(Runner, advance_does_not_change_state_of_runner_if_already_reached_the_dest
   runner.advance();
   ASSERT_EQ(runner.getLastVisitedVertex(), 1);
   ASSERT_EQ(runner.getDestinationVertex(), 1);
-  ASSERT_EQ(runner.getPosition(), graph.m_vertices[1].m_property.position);
+  ASSERT_EQ(runner.getPosition(), (*graph)[1].position);
   ASSERT_EQ(runner.getPath(), Path({0, 1}));
   ASSERT_FALSE(runner.isTraveling());
   ASSERT_TRUE(runner.isInDestination());
@@ -1,16 +1,18 @@
 #include "scenario.h"
 
+#include <charconv>
 #include <filesystem>
-#include <fstream>
 #include <sstream>
+#include <string_view>
 
+#include "mapped-file.h"
 #include "strings.h"
 
 JobRequest::JobRequest(Vertex start, Vertex end) : startVertex(start), endVertex(end)
 {
 }
 
-WeightedDiGraph DefaultScenarioLoader::getGraph() const
+SharedGraph DefaultScenarioLoader::getGraph() const
 {
   DefaultGraphLoader graphLoader;
   return graphLoader.getGraph();
@@ -21,60 +23,128 @@ std::vector<JobRequest> DefaultScenarioLoader::getjobRequests() const
   return {JobRequest(0, 2)};
 }
 
-std::string readVersion(
-    std::ifstream& file, const std::string expectedParameterTitle, const std::filesystem::path& filename)
+/// @brief File name part of a path, which may use either kind of directory separator.
+std::string_view filenameOf(std::string_view path)
 {
-  std::string line;
-  getLine(file, line);
-  std::string label;
-  std::string stringValue;
-  std::istringstream lineStream(line);
-  std::getline(lineStream, label, ' ');
+  const size_t separator = path.find_last_of("/\\");
+  return separator == std::string_view::npos ? path : path.substr(separator + 1);
+}
+
+std::string_view readVersion(
+    std::string_view buffer, size_t& position, std::string_view expectedParameterTitle, const std::string& filename)
+{
+  std::string_view line = getLine(buffer, position);
+  const std::string_view label = nextField(line);
   if (label != expectedParameterTitle)
   {
     std::ostringstream message;
-    message << "Failed to open '" << filename << "': invalid format. Expected 'type octile', got '" << label << "'";
+    message << "Failed to open '" << filename << "': invalid format. Expected '" << expectedParameterTitle
+            << "', got '" << label << "'";
     throw std::invalid_argument(message.str());
   }
-  std::getline(lineStream, stringValue, ' ');
-  return stringValue;
+  return nextField(line);
+}
+
+/// @brief Skips empty lines, so that `position` is at the next job line or at the end of `buffer`.
+void skipEmptyLines(std::string_view buffer, size_t& position)
+{
+  while (position < buffer.size())
+  {
+    size_t next = position;
+    if (!getLine(buffer, next).empty())
+    {
+      return;
+    }
+    position = next;
+  }
 }
 
-JobRequest FileScenarioLoader::parseJobRequest(const std::string& line, const std::filesystem::path& filename)
+JobRequestIterator::JobRequestIterator() : position(0)
 {
-  const std::vector<std::string> lineParts = split(line, {' ', '\t'});
+}
 
-  std::string_view mapFilename = lineParts[1];
-  if (!graphLoader)
+JobRequestIterator::JobRequestIterator(
+    std::shared_ptr<const MappedFile> file,
+    size_t position,
+    std::shared_ptr<const MapGraphLoader> graphLoader,
+    std::string mapName)
+    : file(std::move(file)), position(position), graphLoader(std::move(graphLoader)), mapName(std::move(mapName))
+{
+  parseNextJobRequest();
+}
+
+JobRequestIterator::reference JobRequestIterator::operator*() const
+{
+  return *jobRequest;
+}
+
+JobRequestIterator::pointer JobRequestIterator::operator->() const
+{
+  return &*jobRequest;
+}
+
+JobRequestIterator& JobRequestIterator::operator++()
+{
+  parseNextJobRequest();
+  return *this;
+}
+
+JobRequestIterator JobRequestIterator::operator++(int)
+{
+  JobRequestIterator previous = *this;
+  parseNextJobRequest();
+  return previous;
+}
+
+bool JobRequestIterator::operator==(const JobRequestIterator& other) const
+{
+  if (!jobRequest || !other.jobRequest)
   {
-    const auto graphFilenamePath = std::filesystem::path(mapFilename);
-    const std::string graphFilename = std::filesystem::path(filename)
-                                          .replace_filename(graphFilenamePath.filename())
-                                          .replace_extension(graphFilenamePath.extension())
-                                          .string();
-    graphLoader = std::make_unique<MapGraphLoader>(graphFilename);
+    return !jobRequest && !other.jobRequest;
   }
-  else
+  return file == other.file && position == other.position;
+}
+
+// Scenario Format (https://movingai.com/benchmarks/formats.html)
+//
+// version 1
+// Bucket  map  map width  map height  start x  start y  goal x  goal y  optimal length
+void JobRequestIterator::parseNextJobRequest()
+{
+  const std::string_view buffer(file ? file->data() : nullptr, file ? file->size() : 0);
+  skipEmptyLines(buffer, position);
+  if (position >= buffer.size())
   {
-    if (std::filesystem::path(mapFilename).filename() != std::filesystem::path(graphLoader->getFilename()).filename())
+    jobRequest.reset();
+    return;
+  }
+
+  const std::string& filename = file->getFilename();
+  std::string_view line = getLine(buffer, position);
+  nextField(line);  // bucket
+  if (filenameOf(nextField(line)) != mapName)
+  {
+    std::ostringstream message;
+    message << "Failed to open '" << filename << "': Scenario files with multiple maps not supported.";
+    throw std::invalid_argument(message.str());
+  }
+  nextField(line);  // map width
+  nextField(line);  // map height
+
+  int coordinates[4];
+  for (int& coordinate : coordinates)
+  {
+    const std::string_view field = nextField(line);
+    const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), coordinate);
+    if (error != std::errc() || end != field.data() + field.size())
     {
       std::ostringstream message;
-      message << "Failed to open '" << filename << "': Scenario files with multiple maps not supported.";
+      message << "Failed to open '" << filename << "': invalid format. Expected a map coordinate, got '" << field
+              << "'.";
       throw std::invalid_argument(message.str());
     }
   }
-
-  std::string startXString = std::string(lineParts[4]);
-  int startX = std::stoi(startXString);
-
-  std::string startYString = std::string(lineParts[5]);
-  int startY = std::stoi(startYString);
-
-  std::string endXString = std::string(lineParts[6]);
-  int endX = std::stoi(endXString);
-
-  std::string endYString = std::string(lineParts[7]);
-  int endY = std::stoi(endYString);
+  const auto [startX, startY, endX, endY] = coordinates;
 
   const auto startVertex = graphLoader->convertMapPositionToVertexIndex(startY, startX);
   if (!startVertex)
@@ -92,44 +162,71 @@ JobRequest FileScenarioLoader::parseJobRequest(const std::string& line, const st
             << "', '" << endY << "'] to vertex index.";
     throw std::invalid_argument(message.str());
   }
+  jobRequest.emplace(*startVertex, *endVertex);
+}
 
-  return JobRequest(*startVertex, *endVertex);
+JobRequestIterator JobRequestRange::begin() const
+{
+  return first;
 }
 
-FileScenarioLoader::FileScenarioLoader(const std::filesystem::path& filename)
+JobRequestIterator JobRequestRange::end() const
 {
-  std::ifstream file(filename);
-  if (!file.is_open())
-  {
-    std::ostringstream message;
-    message << "Failed to open '" << filename << "' from " << std::filesystem::current_path();
-    throw std::runtime_error(message.str());
-  }
+  return JobRequestIterator();
+}
 
-  /*std::string version =*/readVersion(file, "version", filename);
-  // if(version != "1.0") {
+FileScenarioLoader::FileScenarioLoader(
+    const std::filesystem::path& filename, VertexOrdering ordering, JobRequestLoading loading)
+    : ordering(ordering), loading(loading), file(std::make_shared<const MappedFile>(filename.string()))
+{
+  const std::string_view buffer(file->data(), file->size());
+  firstJobPosition = 0;
+  /*std::string_view version =*/readVersion(buffer, firstJobPosition, "version", file->getFilename());
+  // if(version != "1") {
   //     std::ostringstream message;
-  //     message << "Failed to open '" << filename << "': invalid format. Expected 'version 1.0', got '" << version <<
+  //     message << "Failed to open '" << filename << "': invalid format. Expected 'version 1', got '" << version <<
   //     "'"; throw std::invalid_argument(message.str());
   // }
 
-  std::string line;
-  while (file && !file.eof())
+  // The map is named by every job line, the first one tells which graph to load
+  skipEmptyLines(buffer, firstJobPosition);
+  if (firstJobPosition < buffer.size())
   {
-    getLine(file, line);
-    if (!line.empty())
-    {
-      jobRequests.emplace_back(parseJobRequest(line, filename));
-    }
+    size_t position = firstJobPosition;
+    std::string_view line = getLine(buffer, position);
+    nextField(line);  // bucket
+    mapName = std::string(filenameOf(nextField(line)));
+    const std::string graphFilename = std::filesystem::path(filename).replace_filename(mapName).string();
+    graphLoader = std::make_shared<const MapGraphLoader>(graphFilename, ordering);
+  }
+
+  if (loading == JobRequestLoading::Eager)
+  {
+    const JobRequestRange range = streamJobRequests();
+    jobRequests.assign(range.begin(), range.end());
   }
 }
 
 std::vector<JobRequest> FileScenarioLoader::getjobRequests() const
 {
-  return jobRequests;
+  if (loading == JobRequestLoading::Eager)
+  {
+    return jobRequests;
+  }
+  const JobRequestRange range = streamJobRequests();
+  return std::vector<JobRequest>(range.begin(), range.end());
+}
+
+JobRequestRange FileScenarioLoader::streamJobRequests() const
+{
+  if (!graphLoader)
+  {
+    return {JobRequestIterator()};
+  }
+  return {JobRequestIterator(file, firstJobPosition, graphLoader, mapName)};
 }
 
-WeightedDiGraph FileScenarioLoader::getGraph() const
+SharedGraph FileScenarioLoader::getGraph() const
 {
   return graphLoader->getGraph();
 }
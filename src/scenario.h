@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "graph.h"
 
+class MappedFile;
+
 class JobRequest
 {
  public:
@@ -19,28 +25,91 @@ class JobRequest
 class ScenarioLoader
 {
  public:
-  virtual WeightedDiGraph getGraph() const = 0;
+  virtual SharedGraph getGraph() const = 0;
   virtual std::vector<JobRequest> getjobRequests() const = 0;
 };
 
 class DefaultScenarioLoader : public ScenarioLoader
 {
  public:
-  WeightedDiGraph getGraph() const override;
+  SharedGraph getGraph() const override;
   std::vector<JobRequest> getjobRequests() const override;
 };
 
+/// @brief Parses the job lines of a memory-mapped `.scen` file one at a time, as it is advanced. Fields are read in
+/// place with `std::from_chars`, so no line or field is ever copied. Shares the file and the graph loader, so it stays
+/// valid after the `FileScenarioLoader` it came from is gone.
+class JobRequestIterator
+{
+ public:
+  typedef std::input_iterator_tag iterator_category;
+  typedef JobRequest value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const JobRequest* pointer;
+  typedef const JobRequest& reference;
+
+  /// @brief End of every scenario.
+  JobRequestIterator();
+  /// @param position Offset of the first job line in `file`.
+  JobRequestIterator(
+      std::shared_ptr<const MappedFile> file,
+      size_t position,
+      std::shared_ptr<const MapGraphLoader> graphLoader,
+      std::string mapName);
+
+  reference operator*() const;
+  pointer operator->() const;
+  JobRequestIterator& operator++();
+  JobRequestIterator operator++(int);
+  bool operator==(const JobRequestIterator& other) const;
+
+ private:
+  void parseNextJobRequest();
+
+  std::shared_ptr<const MappedFile> file;
+  size_t position;
+  std::shared_ptr<const MapGraphLoader> graphLoader;
+  std::string mapName;
+  std::optional<JobRequest> jobRequest;
+};
+
+class JobRequestRange
+{
+ public:
+  JobRequestIterator begin() const;
+  JobRequestIterator end() const;
+
+  JobRequestIterator first;
+};
+
+/// @brief Whether `FileScenarioLoader` parses every job request up front, or only when they are iterated.
+enum class JobRequestLoading
+{
+  Eager,
+  Lazy
+};
+
 class FileScenarioLoader : public ScenarioLoader
 {
  public:
-  FileScenarioLoader(const std::filesystem::path& filename);
+  /// @param loading With `Lazy`, job lines are only parsed while iterating `streamJobRequests()` (or by
+  /// `getjobRequests()`), so invalid lines are reported there instead of by the constructor.
+  FileScenarioLoader(
+      const std::filesystem::path& filename,
+      VertexOrdering ordering = VertexOrdering::RowMajor,
+      JobRequestLoading loading = JobRequestLoading::Eager);
 
-  WeightedDiGraph getGraph() const override;
+  SharedGraph getGraph() const override;
   std::vector<JobRequest> getjobRequests() const override;
+  /// @brief Job requests parsed straight from the mapped file, in file order.
+  JobRequestRange streamJobRequests() const;
 
  private:
-  JobRequest parseJobRequest(const std::string& line, const std::filesystem::path& filename);
-
+  VertexOrdering ordering;
+  JobRequestLoading loading;
+  std::shared_ptr<const MappedFile> file;
+  size_t firstJobPosition;
+  std::string mapName;
   std::vector<JobRequest> jobRequests;
-  std::unique_ptr<MapGraphLoader> graphLoader;
+  std::shared_ptr<const MapGraphLoader> graphLoader;
 };
@@ -0,0 +1,98 @@
+#include "scenario.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+std::filesystem::path getScenarioFilename(const std::string& directory, const std::string& name)
+{
+  return std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/" + directory + "/" + name).make_preferred();
+}
+
+std::filesystem::path writeScenarioFile(const std::string& name, const std::string& contents)
+{
+  const auto directory = std::filesystem::temp_directory_path() / "path-finding-scenarios";
+  std::filesystem::create_directories(directory);
+  std::filesystem::copy_file(
+      getScenarioFilename("sample_test", "test.map"),
+      directory / "test.map",
+      std::filesystem::copy_options::overwrite_existing);
+  const auto filename = directory / name;
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file << contents;
+  return filename;
+}
+
+TEST(FileScenarioLoader, loads_job_requests_and_their_map)
+{
+  FileScenarioLoader loader(getScenarioFilename("sample_test", "test.scen"));
+  EXPECT_EQ(boost::num_vertices(*loader.getGraph()), 3u);
+  const std::vector<JobRequest> jobRequests = loader.getjobRequests();
+  ASSERT_EQ(jobRequests.size(), 1u);
+  EXPECT_EQ(jobRequests[0].startVertex, 1u);  // [1, 0]
+  EXPECT_EQ(jobRequests[0].endVertex, 0u);    // [0, 1]
+}
+
+TEST(FileScenarioLoader, streams_the_same_job_requests_as_it_loads)
+{
+  const auto filename = getScenarioFilename("maze-128-128-2", "maze-128-128-2-random-1.scen");
+  FileScenarioLoader eagerLoader(filename);
+  FileScenarioLoader lazyLoader(filename, VertexOrdering::RowMajor, JobRequestLoading::Lazy);
+
+  const std::vector<JobRequest> expectedJobRequests = eagerLoader.getjobRequests();
+  ASSERT_EQ(expectedJobRequests.size(), 1000u);
+  size_t index = 0;
+  for (const JobRequest& jobRequest : lazyLoader.streamJobRequests())
+  {
+    ASSERT_LT(index, expectedJobRequests.size());
+    EXPECT_EQ(jobRequest.startVertex, expectedJobRequests[index].startVertex);
+    EXPECT_EQ(jobRequest.endVertex, expectedJobRequests[index].endVertex);
+    ++index;
+  }
+  EXPECT_EQ(index, expectedJobRequests.size());
+  EXPECT_EQ(lazyLoader.getjobRequests().size(), expectedJobRequests.size());
+}
+
+TEST(FileScenarioLoader, streamed_job_requests_outlive_the_loader)
+{
+  const auto filename = getScenarioFilename("maze-128-128-2", "maze-128-128-2-random-1.scen");
+  const std::vector<JobRequest> expectedJobRequests = FileScenarioLoader(filename).getjobRequests();
+  std::optional<JobRequestRange> range;
+  {
+    FileScenarioLoader loader(filename, VertexOrdering::RowMajor, JobRequestLoading::Lazy);
+    range = loader.streamJobRequests();
+  }
+  const std::vector<JobRequest> jobRequests(range->begin(), range->end());
+  ASSERT_EQ(jobRequests.size(), expectedJobRequests.size());
+  EXPECT_EQ(jobRequests.back().startVertex, expectedJobRequests.back().startVertex);
+  EXPECT_EQ(jobRequests.back().endVertex, expectedJobRequests.back().endVertex);
+}
+
+TEST(FileScenarioLoader, reads_windows_line_endings_and_skips_empty_lines)
+{
+  const auto filename = writeScenarioFile(
+      "crlf.scen",
+      "version 1\r\n\r\n"
+      "0\ttest.map\t2\t2\t0\t1\t1\t0\t2\r\n"
+      "0\ttest.map\t2\t2\t1\t1\t1\t0\t1\r\n");
+  const std::vector<JobRequest> jobRequests = FileScenarioLoader(filename).getjobRequests();
+  ASSERT_EQ(jobRequests.size(), 2u);
+  EXPECT_EQ(jobRequests[1].startVertex, 2u);
+  EXPECT_EQ(jobRequests[1].endVertex, 0u);
+}
+
+TEST(FileScenarioLoader, throws_exception_on_invalid_job_requests)
+{
+  const auto blocked = writeScenarioFile("blocked.scen", "version 1\n0\ttest.map\t2\t2\t0\t0\t1\t0\t2\n");
+  EXPECT_THROW(FileScenarioLoader{blocked}, std::invalid_argument);
+
+  const auto multipleMaps = writeScenarioFile(
+      "multiple-maps.scen", "version 1\n0\ttest.map\t2\t2\t0\t1\t1\t0\t2\n0\tother.map\t2\t2\t0\t1\t1\t0\t2\n");
+  EXPECT_THROW(FileScenarioLoader{multipleMaps}, std::invalid_argument);
+
+  // Lazily loaded scenarios report invalid lines when they are reached
+  const auto number = writeScenarioFile("number.scen", "version 1\n0\ttest.map\t2\t2\t0\t1\t1\tx\t2\n");
+  FileScenarioLoader lazyLoader(number, VertexOrdering::RowMajor, JobRequestLoading::Lazy);
+  EXPECT_THROW(lazyLoader.streamJobRequests().begin(), std::invalid_argument);
+}
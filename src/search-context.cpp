@@ -0,0 +1,39 @@
+#include "search-context.h"
+
+#include <algorithm>
+
+SearchContext::SearchContext() : generation(0), numberOfVertices(0)
+{
+}
+
+void SearchContext::startSearch(size_t numberOfVertices)
+{
+  this->numberOfVertices = numberOfVertices;
+  if (reachedGenerations.size() < numberOfVertices)
+  {
+    reachedGenerations.resize(numberOfVertices, 0);
+    expandedGenerations.resize(numberOfVertices, 0);
+    distances.resize(numberOfVertices);
+    predecessors.resize(numberOfVertices);
+  }
+
+  ++generation;
+  if (generation == 0)
+  {
+    // After 2^32 - 1 searches, stamps of old searches would match again
+    std::fill(reachedGenerations.begin(), reachedGenerations.end(), 0);
+    std::fill(expandedGenerations.begin(), expandedGenerations.end(), 0);
+    generation = 1;
+  }
+}
+
+size_t SearchContext::getNumberOfVertices() const
+{
+  return numberOfVertices;
+}
+
+SearchContext& SearchContext::getThreadContext()
+{
+  thread_local SearchContext context;
+  return context;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "graph.h"
+
+/// @brief Per-vertex distances, predecessors and expansion flags of a search, kept across searches.
+///
+/// Instead of clearing the arrays (O(V)) before every search, every entry is stamped with the generation of the
+/// search that wrote it, and entries of older generations read as unreached. Starting a search only increments the
+/// generation, so short queries on large graphs cost what they explore, not what the graph holds.
+///
+/// A context serves one search at a time; `getThreadContext` gives every thread its own.
+class SearchContext
+{
+ public:
+  SearchContext();
+
+  /// @brief Forgets the previous search: every vertex is unreached and unexpanded again.
+  void startSearch(size_t numberOfVertices);
+
+  size_t getNumberOfVertices() const;
+
+  bool isReached(Vertex vertex) const
+  {
+    return reachedGenerations[vertex] == generation;
+  }
+
+  /// @brief Distance of the vertex found so far, infinite if it wasn't reached.
+  Distance getDistance(Vertex vertex) const
+  {
+    return isReached(vertex) ? distances[vertex] : std::numeric_limits<Distance>::max();
+  }
+
+  /// @brief Predecessor of the vertex on the path found so far, the vertex itself if it wasn't reached.
+  Vertex getPredecessor(Vertex vertex) const
+  {
+    return isReached(vertex) ? predecessors[vertex] : vertex;
+  }
+
+  /// @brief Records a (shorter) path to the vertex, which makes it unexpanded again.
+  void reach(Vertex vertex, Distance distance, Vertex predecessor)
+  {
+    reachedGenerations[vertex] = generation;
+    expandedGenerations[vertex] = 0;
+    distances[vertex] = distance;
+    predecessors[vertex] = predecessor;
+  }
+
+  bool isExpanded(Vertex vertex) const
+  {
+    return expandedGenerations[vertex] == generation;
+  }
+
+  void setExpanded(Vertex vertex)
+  {
+    expandedGenerations[vertex] = generation;
+  }
+
+  /// @brief Context of the calling thread, used by the planners not given one.
+  static SearchContext& getThreadContext();
+
+ private:
+  /// @brief Generation of the current search, never 0, which marks entries written by no search.
+  uint32_t generation;
+  size_t numberOfVertices;
+  std::vector<uint32_t> reachedGenerations;
+  std::vector<uint32_t> expandedGenerations;
+  std::vector<Distance> distances;
+  std::vector<Vertex> predecessors;
+};
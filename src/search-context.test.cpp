@@ -0,0 +1,72 @@
+#include "search-context.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <limits>
+
+#include "path-finding.h"
+
+TEST(SearchContext, starting_a_search_forgets_the_previous_one)
+{
+  SearchContext context;
+  context.startSearch(4);
+  context.reach(1, 2.0f, 0);
+  context.setExpanded(1);
+  EXPECT_TRUE(context.isReached(1));
+  EXPECT_TRUE(context.isExpanded(1));
+  EXPECT_EQ(context.getDistance(1), 2.0f);
+  EXPECT_EQ(context.getPredecessor(1), 0u);
+  EXPECT_FALSE(context.isReached(2));
+  EXPECT_EQ(context.getDistance(2), std::numeric_limits<Distance>::max());
+  EXPECT_EQ(context.getPredecessor(2), 2u);
+
+  context.startSearch(4);
+  EXPECT_FALSE(context.isReached(1));
+  EXPECT_FALSE(context.isExpanded(1));
+  EXPECT_EQ(context.getDistance(1), std::numeric_limits<Distance>::max());
+  EXPECT_EQ(context.getPredecessor(1), 1u);
+}
+
+TEST(SearchContext, reaching_an_expanded_vertex_makes_it_unexpanded)
+{
+  SearchContext context;
+  context.startSearch(2);
+  context.reach(1, 3.0f, 0);
+  context.setExpanded(1);
+  context.reach(1, 2.0f, 0);
+  EXPECT_FALSE(context.isExpanded(1));
+  EXPECT_EQ(context.getDistance(1), 2.0f);
+}
+
+TEST(SearchContext, grows_with_the_graph)
+{
+  SearchContext context;
+  context.startSearch(2);
+  EXPECT_EQ(context.getNumberOfVertices(), 2u);
+  context.startSearch(8);
+  EXPECT_EQ(context.getNumberOfVertices(), 8u);
+  context.reach(7, 1.0f, 0);
+  EXPECT_TRUE(context.isReached(7));
+}
+
+TEST(SearchContext, repeated_queries_find_the_paths_of_fresh_searches)
+{
+  MapGraphLoader loader(
+      std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/maze-128-128-1/maze-128-128-1.map")
+          .make_preferred()
+          .string());
+  const CompressedSparseRowGraph graph = loader.getCompressedGraph();
+  const auto numberOfVertices = static_cast<Vertex>(graph.getNumberOfVertices());
+
+  SearchContext context;
+  for (Vertex target = 1; target < numberOfVertices; target += numberOfVertices / 7)
+  {
+    EXPECT_EQ(a_star_shortest_path(graph, 0, target, context), a_star_shortest_path(graph, 0, target));
+    EXPECT_EQ(dijkstra_shortest_path(graph, target, 0, context).back(), 0u);
+    SearchContext freshContext;
+    dijkstra_shortest_path(graph, target, 0, freshContext);
+    EXPECT_EQ(context.getDistance(0), freshContext.getDistance(0));
+  }
+  EXPECT_EQ(dijkstra_shortest_paths(graph, 0, context), dijkstra_shortest_paths(graph, 0));
+}
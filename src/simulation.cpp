@@ -1,22 +1,28 @@
 #include "simulation.h"
 
+#include <algorithm>
 #include <iostream>
 #include <optional>
 
 Simulation::Simulation(
-    const std::vector<JobRequest>& jobRequests,
-    const WeightedDiGraph& graph,
+    std::vector<JobRequest> jobRequests,
+    SharedGraph graph,
     unsigned numberOfRunners,
     MultiAgentShortestPathCalculator shortestPathStrategy)
-    : newJobRequests(
-        jobRequests.rbegin(), jobRequests.rend())  // Revert the list, so that we can quickly pop first job from back
+    : newJobRequests(std::move(jobRequests))
+    , nextJobRequest(0)
     , jobAssignments(numberOfRunners, std::nullopt)
     , graph(graph)
     , time(0)
-    , constraints(graph)
+    , constraints(*graph)
+    , obstacles(graph->m_vertices.size())
     , someRunnerMovedInLastStep(true)
     , shortestPathStrategy(shortestPathStrategy)
 {
+  // Constraints are updated first, so that runners are replanned around the new obstacles
+  obstacles.addListener(constraints);
+  obstacles.addListener(*this);
+
   // Create empty runners at initial position
   for (unsigned i = 0; i < numberOfRunners; ++i)
   {
@@ -24,6 +30,12 @@ Simulation::Simulation(
   }
 }
 
+Simulation::~Simulation()
+{
+  obstacles.removeListener(*this);
+  obstacles.removeListener(constraints);
+}
+
 void Simulation::assignNewJobsToRunners()
 {
   for (unsigned runnerIndex = 0; runnerIndex < runners.size(); ++runnerIndex)
@@ -49,12 +61,12 @@ void Simulation::assignNextJobToRunner(unsigned runnerId)
     throw std::runtime_error(message.str());
   }
 
-  if (!newJobRequests.empty())
+  if (nextJobRequest < newJobRequests.size())
   {
-    auto jobRequest = newJobRequests.back();
-    newJobRequests.pop_back();
+    auto jobRequest = newJobRequests[nextJobRequest++];
     jobAssignments[runnerId] = jobRequest;
-    const auto& path = shortestPathStrategy(graph, jobRequest.startVertex, jobRequest.endVertex, constraints, runnerId);
+    const auto& path =
+        shortestPathStrategy(*graph, jobRequest.startVertex, jobRequest.endVertex, constraints, runnerId);
     constraints.unlockVertex(runners[runnerId].getLastVisitedVertex(), runnerId, time /* +1 */);
     runners[runnerId].travel(path, true);
     lockPathForRunner(runnerId, path);
@@ -96,8 +108,8 @@ void Simulation::assignNextJobToRunner(unsigned runnerId)
     //   throw std::runtime_error(message.str());
     // }
     std::cout << time << " - Runner " << runnerId << " - assigned new job " << jobRequest.startVertex << " "
-              << graph[jobRequest.startVertex].position << " > " << jobRequest.endVertex << " "
-              << graph[jobRequest.endVertex].position << ", path=[" << path << "]" << std::endl;
+              << (*graph)[jobRequest.startVertex].position << " > " << jobRequest.endVertex << " "
+              << (*graph)[jobRequest.endVertex].position << ", path=[" << path << "]" << std::endl;
   }
 }
 
@@ -114,8 +126,8 @@ void Simulation::finishRunnerJob(unsigned runnerId)
   jobAssignments[runnerId] = std::nullopt;
   finishedJobRequests.push_back(*jobRequest);
   std::cout << time << " - Runner " << runnerId << " - finished job " << jobRequest->startVertex << " "
-            << graph[jobRequest->startVertex].position << " > " << jobRequest->endVertex << " "
-            << graph[jobRequest->endVertex].position << std::endl;
+            << (*graph)[jobRequest->startVertex].position << " > " << jobRequest->endVertex << " "
+            << (*graph)[jobRequest->endVertex].position << std::endl;
 }
 
 void Simulation::finishRunnerJobs()
@@ -136,7 +148,7 @@ void Simulation::finishRunnerJobs()
 
 void Simulation::moveRunners()
 {
-  for (auto i = 0; i < graph.m_vertices.size(); ++i)
+  for (auto i = 0; i < graph->m_vertices.size(); ++i)
   {
     auto lock = constraints.getVertexLock(i, time);
     if (lock)
@@ -176,13 +188,13 @@ void Simulation::moveRunners()
       if (previousVertex != runner.getLastVisitedVertex())
       {
         std::cout << time << " - Runner " << runnerId << " moved from vertex " << previousVertex << " "
-                  << graph[previousVertex].position << " to vertex " << runner.getLastVisitedVertex() << " "
+                  << (*graph)[previousVertex].position << " to vertex " << runner.getLastVisitedVertex() << " "
                   << runner.getPosition() << std::endl;
       }
       else
       {
         std::cout << time << " - Runner " << runnerId << " waits at vertex " << previousVertex << " "
-                  << graph[previousVertex].position << std::endl;
+                  << (*graph)[previousVertex].position << std::endl;
       }
     }
     else
@@ -203,62 +215,173 @@ void Simulation::moveRunners()
   }
 }
 
-void Simulation::lockPathForRunner(RunnerId runnerId, const Path& path)
+bool Simulation::isPathFreeForRunner(RunnerId runnerId, const Path& path) const
 {
   unsigned time_since_start = 0;
-  bool isPathFree = true;
   std::optional<Vertex> previousVertex;
   for (auto vertex : path)
   {
     const auto startTime = time + time_since_start;
     const auto endTime = time + time_since_start + 1;
-    const bool isVertexFree = constraints.isVertexFreeForRunner(vertex, runnerId, startTime, endTime);
-    isPathFree &= isVertexFree;
+    // The runner may stand on a vertex blocked since it got there, which it is still allowed to leave
+    const bool isVertexFree = time_since_start == 0
+        ? constraints.isVertexUnlockedForRunner(vertex, runnerId, startTime, endTime)
+        : constraints.isVertexFreeForRunner(vertex, runnerId, startTime, endTime);
     if (!isVertexFree)
     {
-      std::ostringstream message;
-      message << "Failed to assign new job to runner '" << runnerId << "': Vertex "
-              << runners[runnerId].getLastVisitedVertex() << " is already locked to runner "
-              << *constraints.getVertexLock(runners[runnerId].getLastVisitedVertex(), time);
+      return false;
     }
     // The edge from the previous vertex to this one is traversed during the previous vertex's own
     // occupancy window, i.e. [startTime - 1, startTime).
+    if (previousVertex && *previousVertex != vertex
+        && !constraints.isEdgeFreeForRunner(*previousVertex, vertex, runnerId, startTime - 1, startTime))
+    {
+      return false;
+    }
+    previousVertex = vertex;
+    ++time_since_start;
+  }
+  return true;
+}
+
+void Simulation::lockPathForRunner(RunnerId runnerId, const Path& path)
+{
+  if (!isPathFreeForRunner(runnerId, path))
+  {
+    std::ostringstream message;
+    message << "Unable to lock path for runner #" << runnerId << ". Some vertices are locked.";
+    throw std::runtime_error(message.str());
+  }
+
+  unsigned time_since_start = 0;
+  std::optional<Vertex> previousVertex;
+  for (auto vertex : path)
+  {
+    const auto startTime = time + time_since_start;
+    const auto endTime = time + time_since_start + 1;
+    constraints.lockVertex(vertex, runnerId, startTime, endTime);
+    std::cout << "Locking vertex " << vertex << " to runner " << runnerId << " since " << startTime << " till "
+              << endTime << std::endl;
     if (previousVertex && *previousVertex != vertex)
     {
-      const bool isEdgeFree =
-          constraints.isEdgeFreeForRunner(*previousVertex, vertex, runnerId, startTime - 1, startTime);
-      isPathFree &= isEdgeFree;
+      constraints.lockEdge(*previousVertex, vertex, runnerId, startTime - 1, startTime);
+      std::cout << "Locking edge " << *previousVertex << "->" << vertex << " to runner " << runnerId << " since "
+                << (startTime - 1) << " till " << startTime << std::endl;
     }
     previousVertex = vertex;
     ++time_since_start;
   }
-  if (isPathFree)
+}
+
+void Simulation::unlockPathForRunner(RunnerId runnerId, const Path& path)
+{
+  std::optional<Vertex> previousVertex;
+  for (auto vertex : path)
   {
-    time_since_start = 0;
-    previousVertex = std::nullopt;
-    for (auto vertex : path)
+    constraints.unlockVertex(vertex, runnerId, time);
+    if (previousVertex && *previousVertex != vertex)
     {
-      const auto startTime = time + time_since_start;
-      const auto endTime = time + time_since_start + 1;
-      constraints.lockVertex(vertex, runnerId, startTime, endTime);
-      std::cout << "Locking vertex " << vertex << " to runner " << runnerId << " since " << startTime << " till "
-                << endTime << std::endl;
-      if (previousVertex && *previousVertex != vertex)
-      {
-        constraints.lockEdge(*previousVertex, vertex, runnerId, startTime - 1, startTime);
-        std::cout << "Locking edge " << *previousVertex << "->" << vertex << " to runner " << runnerId << " since "
-                  << (startTime - 1) << " till " << startTime << std::endl;
-      }
-      previousVertex = vertex;
-      ++time_since_start;
+      constraints.unlockEdge(*previousVertex, vertex, runnerId, time);
     }
+    previousVertex = vertex;
   }
-  else
+}
+
+void Simulation::replanRunner(RunnerId runnerId)
+{
+  auto& runner = runners[runnerId];
+  unlockPathForRunner(runnerId, runner.getRemainingPath());
+
+  const Vertex destination = jobAssignments[runnerId]->endVertex;
+  Path path;
+  if (!obstacles.isVertexBlocked(destination))
   {
-    std::ostringstream message;
-    message << "Unable to lock path for runner #" << runnerId << ". Some vertices are locked.";
-    throw std::runtime_error(message.str());
+    path = shortestPathStrategy(*graph, runner.getLastVisitedVertex(), destination, constraints, runnerId);
+  }
+  // Replanning runs inside the obstacle listeners, so a path colliding with the locks of other runners (planned by a
+  // strategy ignoring them) strands the runner like no path at all instead of throwing, until the next unblock.
+  if (!isPathFreeForRunner(runnerId, path))
+  {
+    path.clear();
   }
+  runner.travel(path);
+  lockPathForRunner(runnerId, path);
+  if (!path.empty())
+  {
+    // A runner with a fresh path is no longer stuck, even if nobody moved in the last step
+    someRunnerMovedInLastStep = true;
+  }
+  std::cout << time << " - Runner " << runnerId << " - replanned to " << destination << ", path=[" << path << "]"
+            << std::endl;
+}
+
+void Simulation::replanStrandedRunners()
+{
+  for (unsigned runnerId = 0; runnerId < runners.size(); ++runnerId)
+  {
+    if (isJobAssignedToRunner(runnerId) && runners[runnerId].getPath().empty())
+    {
+      replanRunner(runnerId);
+    }
+  }
+}
+
+void Simulation::onVertexBlocked(Vertex vertex)
+{
+  for (unsigned runnerId = 0; runnerId < runners.size(); ++runnerId)
+  {
+    if (!isJobAssignedToRunner(runnerId))
+    {
+      continue;
+    }
+    // The runner's current vertex (first of the remaining path) is already behind it
+    const Path remainingPath = runners[runnerId].getRemainingPath();
+    if (remainingPath.size() > 1
+        && std::find(remainingPath.begin() + 1, remainingPath.end(), vertex) != remainingPath.end())
+    {
+      replanRunner(runnerId);
+    }
+  }
+}
+
+void Simulation::onVertexUnblocked(Vertex /*vertex*/)
+{
+  replanStrandedRunners();
+}
+
+void Simulation::onEdgeBlocked(Vertex from, Vertex to)
+{
+  for (unsigned runnerId = 0; runnerId < runners.size(); ++runnerId)
+  {
+    if (!isJobAssignedToRunner(runnerId))
+    {
+      continue;
+    }
+    const Path remainingPath = runners[runnerId].getRemainingPath();
+    for (size_t index = 1; index < remainingPath.size(); ++index)
+    {
+      if (remainingPath[index - 1] == from && remainingPath[index] == to)
+      {
+        replanRunner(runnerId);
+        break;
+      }
+    }
+  }
+}
+
+void Simulation::onEdgeUnblocked(Vertex /*from*/, Vertex /*to*/)
+{
+  replanStrandedRunners();
+}
+
+Obstacles& Simulation::getObstacles()
+{
+  return obstacles;
+}
+
+const Obstacles& Simulation::getObstacles() const
+{
+  return obstacles;
 }
 
 void Simulation::advance()
@@ -282,7 +405,7 @@ bool Simulation::areAllRunnersFinished() const
 
 bool Simulation::isFinished() const
 {
-  return (newJobRequests.empty() && areAllRunnersFinished()) /*|| !someRunnerMovedInLastStep*/;
+  return (getNewJobRequests().empty() && areAllRunnersFinished()) /*|| !someRunnerMovedInLastStep*/;
 }
 
 bool Simulation::isDeadlock() const
@@ -295,9 +418,9 @@ unsigned Simulation::getTime() const
   return time;
 }
 
-const std::vector<JobRequest>& Simulation::getNewJobRequests() const
+std::span<const JobRequest> Simulation::getNewJobRequests() const
 {
-  return newJobRequests;
+  return std::span<const JobRequest>(newJobRequests).subspan(nextJobRequest);
 }
 
 const std::vector<std::optional<JobRequest>>& Simulation::getJobAssignments() const
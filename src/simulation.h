@@ -1,29 +1,48 @@
 #pragma once
 
+#include <span>
+
 #include "constraints.h"
 #include "graph.h"
+#include "obstacles.h"
 #include "path-finding.h"
 #include "runner.h"
 #include "scenario.h"
 
-class Simulation
+class Simulation : public ObstacleListener
 {
  public:
   Simulation() = delete;
+  Simulation(const Simulation &) = delete;
+  Simulation &operator=(const Simulation &) = delete;
   Simulation(
-      const std::vector<JobRequest> &jobRequests,
-      const WeightedDiGraph &graph,
+      std::vector<JobRequest> jobRequests,
+      SharedGraph graph,
       unsigned numberOfRunners = 0,
       MultiAgentShortestPathCalculator shortestPathStrategy =
-          multi_agent_shortest_path_calculator_wrapper(a_star_shortest_path));
+          multi_agent_shortest_path_calculator_wrapper(ShortestPathFunction(a_star_shortest_path)));
+
+  ~Simulation() override;
 
   void advance();
 
+  /// @brief Obstacles on the graph. Blocking a vertex or an edge replans only the runners whose remaining path
+  /// crosses it; unblocking one replans the runners left without a path. Further listeners (e.g. caches derived from
+  /// the graph) can be registered here.
+  Obstacles &getObstacles();
+  const Obstacles &getObstacles() const;
+
+  void onVertexBlocked(Vertex vertex) override;
+  void onVertexUnblocked(Vertex vertex) override;
+  void onEdgeBlocked(Vertex from, Vertex to) override;
+  void onEdgeUnblocked(Vertex from, Vertex to) override;
+
   bool isFinished() const;
   bool isDeadlock() const;
   unsigned getTime() const;
 
-  const std::vector<JobRequest> &getNewJobRequests() const;
+  /// @brief Job requests not assigned to any runner yet, in the order they will be assigned.
+  std::span<const JobRequest> getNewJobRequests() const;
   const std::vector<std::optional<JobRequest>> &getJobAssignments() const;
   const std::vector<JobRequest> &getFinishedJobRequests() const;
   const std::vector<Runner> &getRunners() const;
@@ -39,15 +58,25 @@ class Simulation
 
   bool areAllRunnersFinished() const;
 
+  /// @brief Whether the runner can follow `path` from now on without colliding with the locks of other runners.
+  bool isPathFreeForRunner(RunnerId runnerId, const Path &path) const;
   void lockPathForRunner(RunnerId runnerId, const Path &path);
+  void unlockPathForRunner(RunnerId runnerId, const Path &path);
+  /// @brief Plans a new path for the runner from its current vertex to the destination of its job. Leaves the runner
+  /// without a path if there is none it can lock, without throwing, as it is called by the obstacle listeners.
+  void replanRunner(RunnerId runnerId);
+  void replanStrandedRunners();
 
   Constraints constraints;
+  Obstacles obstacles;
 
  private:
   std::vector<Runner> runners;
-  WeightedDiGraph graph;
+  SharedGraph graph;
 
   std::vector<JobRequest> newJobRequests;
+  /// @brief Index of the next job request to assign. Earlier requests are assigned already.
+  size_t nextJobRequest;
   std::vector<std::optional<JobRequest>> jobAssignments;
   std::vector<JobRequest> finishedJobRequests;
 
@@ -6,13 +6,13 @@
 
 const unsigned defaultNumberOfVertices = 9;
 
-WeightedDiGraph createGraph(unsigned numberOfVertices = defaultNumberOfVertices)
+SharedGraph createGraph(unsigned numberOfVertices = defaultNumberOfVertices)
 {
-  WeightedDiGraph graph(numberOfVertices);
+  auto graph = std::make_shared<WeightedDiGraph>(numberOfVertices);
   for (unsigned i = 0; i < numberOfVertices; ++i)
   {
-    add_edge(i, i + 1, 1.0f, graph);
-    add_edge(i + 1, i, 1.0f, graph);
+    add_edge(i, i + 1, 1.0f, *graph);
+    add_edge(i + 1, i, 1.0f, *graph);
   }
   return graph;
 }
@@ -22,7 +22,7 @@ class SimulationStub : public Simulation
  public:
   friend class SimulationTest;
   SimulationStub() = delete;
-  SimulationStub(const std::vector<JobRequest>& jobRequests, const WeightedDiGraph& graph, unsigned numberOfRunners = 0)
+  SimulationStub(const std::vector<JobRequest>& jobRequests, SharedGraph graph, unsigned numberOfRunners = 0)
       : Simulation(jobRequests, graph, numberOfRunners)
   {
   }
@@ -65,7 +65,7 @@ class SimulationStub : public Simulation
 
 TEST(SimulationTest, creates_no_runners)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   std::vector<JobRequest> jobRequests{JobRequest{0, 1}};
   const unsigned numberOfRunners = 0;
   SimulationStub simulation(jobRequests, graph, numberOfRunners);
@@ -74,7 +74,7 @@ TEST(SimulationTest, creates_no_runners)
 
 TEST(SimulationTest, creates_requested_number_of_runners)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   std::vector<JobRequest> jobRequests{JobRequest{0, 1}};
   const unsigned numberOfRunners = 3;
   SimulationStub simulation(jobRequests, graph, numberOfRunners);
@@ -83,7 +83,7 @@ TEST(SimulationTest, creates_requested_number_of_runners)
 
 TEST(SimulationTest, is_not_finished_when_initialized_with_some_job_requests)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   std::vector<JobRequest> jobRequests{JobRequest{0, 1}};
   const unsigned numberOfRunners = 1;
   SimulationStub simulation(jobRequests, graph, numberOfRunners);
@@ -92,7 +92,7 @@ TEST(SimulationTest, is_not_finished_when_initialized_with_some_job_requests)
 
 TEST(SimulationTest, is_finished_when_initialized_without_job_requests)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   std::vector<JobRequest> jobRequests{};
   const unsigned numberOfRunners = 1;
   SimulationStub simulation(jobRequests, graph, numberOfRunners);
@@ -101,7 +101,7 @@ TEST(SimulationTest, is_finished_when_initialized_without_job_requests)
 
 TEST(SimulationTest, time_is_zero_before_start)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   std::vector<JobRequest> jobRequests{JobRequest{0, 1}};
   const unsigned numberOfRunners = 1;
   SimulationStub simulation(jobRequests, graph, numberOfRunners);
@@ -110,7 +110,7 @@ TEST(SimulationTest, time_is_zero_before_start)
 
 TEST(SimulationTest, increments_time_after_step)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   std::vector<JobRequest> jobRequests{JobRequest{0, 1}};
   const unsigned numberOfRunners = 1;
   SimulationStub simulation(jobRequests, graph, numberOfRunners);
@@ -120,7 +120,7 @@ TEST(SimulationTest, increments_time_after_step)
 
 TEST(SimulationTest, initial_job_assignments)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   std::vector<JobRequest> jobRequests{JobRequest{1, 2}};
   const unsigned numberOfRunners = 2;
 
@@ -138,7 +138,7 @@ TEST(SimulationTest, initial_job_assignments)
 
 TEST(SimulationTest, assigns_job_to_runner)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   JobRequest jobRequest{1, 2};
   std::vector<JobRequest> jobRequests{jobRequest};
   const unsigned numberOfRunners = 2;
@@ -161,7 +161,7 @@ TEST(SimulationTest, assigns_job_to_runner)
 
 TEST(SimulationTest, moveRunners)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   JobRequest jobRequest{1, 2};
   std::vector<JobRequest> jobRequests{jobRequest};
   const unsigned numberOfRunners = 2;
@@ -186,7 +186,7 @@ TEST(SimulationTest, moveRunners)
 
 TEST(SimulationTest, finishRunnerJob)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   JobRequest jobRequest{1, 2};
   std::vector<JobRequest> jobRequests{jobRequest};
   const unsigned numberOfRunners = 2;
@@ -210,13 +210,13 @@ TEST(SimulationTest, finishRunnerJob)
 
 TEST(SimulationTest, no_lock_on_vertices_initialy)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   JobRequest jobRequest{1, 2};
   std::vector<JobRequest> jobRequests{jobRequest};
   const unsigned numberOfRunners = 2;
 
   SimulationStub simulation(jobRequests, graph, numberOfRunners);
-  for (unsigned vertex = 0; vertex < graph.m_vertices.size(); ++vertex)
+  for (unsigned vertex = 0; vertex < graph->m_vertices.size(); ++vertex)
   {
     EXPECT_TRUE(simulation.isVertexFreeForRunner(vertex, 0));
     EXPECT_TRUE(simulation.isVertexFreeForRunner(vertex, 1));
@@ -225,7 +225,7 @@ TEST(SimulationTest, no_lock_on_vertices_initialy)
 
 TEST(SimulationTest, locks_vertex_for_runner)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   JobRequest jobRequest{1, 2};
   std::vector<JobRequest> jobRequests{jobRequest};
   const unsigned numberOfRunners = 2;
@@ -234,7 +234,7 @@ TEST(SimulationTest, locks_vertex_for_runner)
   simulation.lockVertex(0, 1);
   EXPECT_FALSE(simulation.isVertexFreeForRunner(0, 0));
   EXPECT_TRUE(simulation.isVertexFreeForRunner(0, 1));
-  for (unsigned vertex = 1; vertex < graph.m_vertices.size(); ++vertex)
+  for (unsigned vertex = 1; vertex < graph->m_vertices.size(); ++vertex)
   {
     EXPECT_TRUE(simulation.isVertexFreeForRunner(vertex, 0));
     EXPECT_TRUE(simulation.isVertexFreeForRunner(vertex, 1));
@@ -243,7 +243,7 @@ TEST(SimulationTest, locks_vertex_for_runner)
 
 TEST(SimulationTest, does_not_lock_vertex_already_locked_for_other_runner)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   JobRequest jobRequest{1, 2};
   std::vector<JobRequest> jobRequests{jobRequest};
   const unsigned numberOfRunners = 2;
@@ -255,7 +255,7 @@ TEST(SimulationTest, does_not_lock_vertex_already_locked_for_other_runner)
 
 TEST(SimulationTest, does_not_throw_if_trying_to_lock_vertex_locked_for_same_runner)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   JobRequest jobRequest{1, 2};
   std::vector<JobRequest> jobRequests{jobRequest};
   const unsigned numberOfRunners = 2;
@@ -267,7 +267,7 @@ TEST(SimulationTest, does_not_throw_if_trying_to_lock_vertex_locked_for_same_run
 
 TEST(SimulationTest, unlocks_vertex)
 {
-  WeightedDiGraph graph = createGraph();
+  SharedGraph graph = createGraph();
   JobRequest jobRequest{1, 2};
   std::vector<JobRequest> jobRequests{jobRequest};
   const unsigned numberOfRunners = 2;
@@ -275,7 +275,7 @@ TEST(SimulationTest, unlocks_vertex)
   SimulationStub simulation(jobRequests, graph, numberOfRunners);
   simulation.lockVertex(0, 1);
   simulation.unlockVertex(0, 1);
-  for (unsigned vertex = 0; vertex < graph.m_vertices.size(); ++vertex)
+  for (unsigned vertex = 0; vertex < graph->m_vertices.size(); ++vertex)
   {
     EXPECT_TRUE(simulation.isVertexFreeForRunner(vertex, 0));
     EXPECT_TRUE(simulation.isVertexFreeForRunner(vertex, 1));
@@ -297,7 +297,11 @@ TEST(SimulationTest, swapping_runners_reach_their_destination_when_a_safe_path_e
   add_edge(3, 2, 1.0f, graph);
 
   std::vector<JobRequest> jobRequests{JobRequest(0, 2), JobRequest(3, 0)};
-  Simulation simulation(jobRequests, graph, 2, space_time_a_star_shortest_path);
+  Simulation simulation(
+      jobRequests,
+      std::make_shared<const WeightedDiGraph>(graph),
+      2,
+      MultiAgentShortestPathFunction(space_time_a_star_shortest_path));
 
   const unsigned timeout = 100;
   while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
@@ -326,7 +330,11 @@ TEST(SimulationTest, swapping_runners_report_a_deadlock_instead_of_colliding_whe
   add_edge(2, 1, 1.0f, graph);
 
   std::vector<JobRequest> jobRequests{JobRequest(0, 2), JobRequest(2, 0)};
-  Simulation simulation(jobRequests, graph, 2, space_time_a_star_shortest_path);
+  Simulation simulation(
+      jobRequests,
+      std::make_shared<const WeightedDiGraph>(graph),
+      2,
+      MultiAgentShortestPathFunction(space_time_a_star_shortest_path));
 
   const unsigned timeout = 100;
   while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
@@ -341,3 +349,130 @@ TEST(SimulationTest, swapping_runners_report_a_deadlock_instead_of_colliding_whe
   // genuinely-impossible job is left unfinished.
   EXPECT_EQ(simulation.getFinishedJobRequests().size(), 1u);
 }
+
+/// @brief 3x3 grid, vertex `row * 3 + column`.
+SharedGraph createGridGraph()
+{
+  auto graph = std::make_shared<WeightedDiGraph>(9);
+  for (unsigned row = 0; row < 3; ++row)
+  {
+    for (unsigned column = 0; column < 3; ++column)
+    {
+      const unsigned vertex = row * 3 + column;
+      (*graph)[vertex].position = {float(row), float(column)};
+      if (column > 0)
+      {
+        add_edge(vertex, vertex - 1, 1.0f, *graph);
+        add_edge(vertex - 1, vertex, 1.0f, *graph);
+      }
+      if (row > 0)
+      {
+        add_edge(vertex, vertex - 3, 1.0f, *graph);
+        add_edge(vertex - 3, vertex, 1.0f, *graph);
+      }
+    }
+  }
+  return graph;
+}
+
+TEST(SimulationTest, replans_only_runners_whose_path_crosses_a_blocked_vertex)
+{
+  std::vector<JobRequest> jobRequests{JobRequest(0, 8), JobRequest(6, 7)};
+  Simulation simulation(
+      jobRequests, createGridGraph(), 2, MultiAgentShortestPathFunction(space_time_a_star_shortest_path));
+  simulation.advance();
+
+  const Path remainingPath = simulation.getRunners()[0].getRemainingPath();
+  const Path otherRemainingPath = simulation.getRunners()[1].getRemainingPath();
+  ASSERT_GE(remainingPath.size(), 3u);
+  const Vertex blockedVertex = remainingPath[1];
+  ASSERT_EQ(std::find(otherRemainingPath.begin(), otherRemainingPath.end(), blockedVertex), otherRemainingPath.end());
+
+  EXPECT_TRUE(simulation.getObstacles().blockVertex(blockedVertex));
+  const Path replannedPath = simulation.getRunners()[0].getRemainingPath();
+  EXPECT_EQ(replannedPath.front(), remainingPath.front());
+  EXPECT_EQ(replannedPath.back(), 8u);
+  EXPECT_EQ(std::find(replannedPath.begin(), replannedPath.end(), blockedVertex), replannedPath.end());
+  EXPECT_EQ(simulation.getRunners()[1].getRemainingPath(), otherRemainingPath);
+
+  const unsigned timeout = 100;
+  while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
+  {
+    simulation.advance();
+  }
+  EXPECT_TRUE(simulation.isFinished());
+  EXPECT_EQ(simulation.getFinishedJobRequests().size(), 2u);
+}
+
+TEST(SimulationTest, replans_runner_standing_on_a_blocked_vertex)
+{
+  std::vector<JobRequest> jobRequests{JobRequest(0, 8)};
+  Simulation simulation(
+      jobRequests, createGridGraph(), 1, MultiAgentShortestPathFunction(space_time_a_star_shortest_path));
+  simulation.advance();
+
+  const Path remainingPath = simulation.getRunners()[0].getRemainingPath();
+  ASSERT_GE(remainingPath.size(), 3u);
+  const Vertex currentVertex = remainingPath.front();
+  EXPECT_TRUE(simulation.getObstacles().blockVertex(currentVertex));
+  EXPECT_EQ(simulation.getRunners()[0].getRemainingPath(), remainingPath);
+
+  // The runner may still leave the vertex it stands on when it replans around the next obstacle
+  EXPECT_TRUE(simulation.getObstacles().blockVertex(remainingPath[1]));
+  const Path replannedPath = simulation.getRunners()[0].getRemainingPath();
+  ASSERT_FALSE(replannedPath.empty());
+  EXPECT_EQ(replannedPath.front(), currentVertex);
+  EXPECT_EQ(replannedPath.back(), 8u);
+  EXPECT_EQ(std::find(replannedPath.begin(), replannedPath.end(), remainingPath[1]), replannedPath.end());
+
+  const unsigned timeout = 100;
+  while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
+  {
+    simulation.advance();
+  }
+  EXPECT_TRUE(simulation.isFinished());
+}
+
+TEST(SimulationTest, strands_runner_instead_of_throwing_when_its_replanned_path_is_locked)
+{
+  // The default strategy ignores the locks: runner 0 detours from 1 through 4 at time 2, when runner 1 arrives there
+  std::vector<JobRequest> jobRequests{JobRequest(0, 2), JobRequest(8, 4)};
+  Simulation simulation(jobRequests, createGridGraph(), 2);
+  simulation.advance();
+  ASSERT_EQ(simulation.getRunners()[0].getRemainingPath(), (Path{1, 2}));
+  ASSERT_EQ(simulation.getRunners()[1].getRemainingPath().back(), 4u);
+
+  EXPECT_NO_THROW(simulation.getObstacles().blockEdge(1, 2));
+  EXPECT_TRUE(simulation.getRunners()[0].getPath().empty());
+  EXPECT_EQ(simulation.getRunners()[0].getLastVisitedVertex(), 1u);
+}
+
+TEST(SimulationTest, resumes_runners_stranded_by_a_blocked_destination_when_it_is_unblocked)
+{
+  std::vector<JobRequest> jobRequests{JobRequest(0, 2)};
+  Simulation simulation(
+      jobRequests, createGridGraph(), 1, MultiAgentShortestPathFunction(space_time_a_star_shortest_path));
+  simulation.advance();
+
+  simulation.getObstacles().blockVertex(2);
+  EXPECT_TRUE(simulation.getRunners()[0].getPath().empty());
+  simulation.advance();
+  EXPECT_FALSE(simulation.isFinished());
+
+  simulation.getObstacles().blockEdge(1, 2);
+  simulation.getObstacles().unblockVertex(2);
+  const Path path = simulation.getRunners()[0].getPath();
+  ASSERT_FALSE(path.empty());
+  for (size_t index = 1; index < path.size(); ++index)
+  {
+    EXPECT_FALSE(path[index - 1] == 1 && path[index] == 2) << "path crosses the blocked edge";
+  }
+
+  const unsigned timeout = 100;
+  while (!simulation.isFinished() && !simulation.isDeadlock() && simulation.getTime() < timeout)
+  {
+    simulation.advance();
+  }
+  EXPECT_TRUE(simulation.isFinished());
+  EXPECT_EQ(simulation.getRunners()[0].getLastVisitedVertex(), 2u);
+}
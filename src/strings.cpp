@@ -10,6 +10,35 @@ std::istream& getLine(std::istream& input, std::string& line)
   return input;
 }
 
+std::string_view getLine(std::string_view buffer, size_t& position)
+{
+  const size_t begin = position;
+  const size_t newline = buffer.find('\n', begin);
+  size_t length = (newline == std::string_view::npos ? buffer.size() : newline) - begin;
+  position = newline == std::string_view::npos ? buffer.size() : newline + 1;
+  if (length > 0 && buffer[begin + length - 1] == '\r')
+  {
+    --length;
+  }
+  return buffer.substr(begin, length);
+}
+
+bool isFieldSeparator(char value)
+{
+  return value == ' ' || value == '\t';
+}
+
+std::string_view nextField(std::string_view& line)
+{
+  size_t begin = 0;
+  while (begin < line.size() && isFieldSeparator(line[begin])) ++begin;
+  size_t end = begin;
+  while (end < line.size() && !isFieldSeparator(line[end])) ++end;
+  const std::string_view field = line.substr(begin, end - begin);
+  line.remove_prefix(end);
+  return field;
+}
+
 std::vector<std::string> split(const std::string& input, const std::set<char>&& delimiters)
 {
   std::vector<std::string> views;
@@ -3,6 +3,7 @@
 #include <istream>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 std::vector<std::string> split(const std::string& input, const std::set<char>&& delimiters);
@@ -11,3 +12,11 @@ std::vector<std::string> split(const std::string& input, const std::set<char>&&
 /// files with Windows (CRLF) line endings parse the same way on platforms whose text streams
 /// don't strip it themselves (e.g. Linux).
 std::istream& getLine(std::istream& input, std::string& line);
+
+/// @brief Same as `getLine` above, but returns the line starting at `position` of an in-memory buffer (e.g. a mapped
+/// file) as a view, without copying it. Advances `position` past the line break.
+std::string_view getLine(std::string_view buffer, size_t& position);
+
+/// @brief Returns the next space or tab separated field of `line`, skipping the separators in front of it, and removes
+/// it from `line`. Returns an empty view once `line` has no more fields.
+std::string_view nextField(std::string_view& line);
@@ -31,3 +31,15 @@ TEST(Strings, getLine_leaves_unix_line_endings_unchanged)
   getLine(stream, line);
   EXPECT_EQ(line, "height 2");
 }
+
+TEST(Strings, getLine_returns_views_into_buffer)
+{
+  const std::string_view buffer = "type octile\r\nheight 2\n\nmap";
+  size_t position = 0;
+  EXPECT_EQ(getLine(buffer, position), "type octile");
+  EXPECT_EQ(getLine(buffer, position), "height 2");
+  EXPECT_EQ(getLine(buffer, position), "");
+  EXPECT_EQ(getLine(buffer, position), "map");
+  EXPECT_EQ(position, buffer.size());
+  EXPECT_EQ(getLine(buffer, position), "");
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+#include "runner.h"
+
+/// @brief Path of the `.map` file of the map `name` in the data directory of the project.
+inline std::string getMapFilename(const std::string& name)
+{
+  return std::filesystem::path(std::string(PROJECT_ROOT_DIR) + "/data/" + name + "/" + name + ".map")
+      .make_preferred()
+      .string();
+}
+
+/// Id of the last runner created, defined in runner.cpp.
+extern RunnerId lastRunnerId;
+
+/// @brief Fixture for tests that create runners outside of the Runner tests, restoring the ids the Runner tests expect
+/// to be handed out next.
+class RunnerIdsRestoringTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    savedRunnerId = lastRunnerId;
+  }
+
+  void TearDown() override
+  {
+    lastRunnerId = savedRunnerId;
+  }
+
+ private:
+  RunnerId savedRunnerId = 0;
+};
@@ -0,0 +1,385 @@
+#include "tiled-grid-graph.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+#include "graph-cache.h"
+#include "map-reader.h"
+
+namespace
+{
+struct TiledMapHeader
+{
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t tileSize;
+  uint32_t width;
+  uint32_t height;
+  uint64_t numberOfVertices;
+};
+
+constexpr std::array<char, 8> TiledMapMagic{'P', 'F', 'T', 'I', 'L', 'E', 'S', '\0'};
+constexpr size_t TileBytes = TiledGridGraph::TileSize * sizeof(TiledGridGraph::Word);
+
+size_t count_tiles(size_t cells)
+{
+  return (cells + TiledGridGraph::TileSize - 1) / TiledGridGraph::TileSize;
+}
+}  // namespace
+
+TiledGridGraph::TiledGridGraph(const std::string& filename, size_t cacheCapacity)
+    : filename(filename)
+    , width(0)
+    , height(0)
+    , tilesPerRow(0)
+    , numberOfVertices(0)
+    , file(filename, std::ios::binary)
+    , cacheCapacity(cacheCapacity)
+    , mostRecentlyUsedSlot(NoSlot)
+    , leastRecentlyUsedSlot(NoSlot)
+    , usedSlots(0)
+    , statistics{0, 0}
+{
+  auto invalid = [&filename](const std::string& reason)
+  {
+    std::ostringstream message;
+    message << "Failed to load tiled map '" << filename << "': " << reason;
+    return std::runtime_error(message.str());
+  };
+
+  if (!file.is_open())
+  {
+    throw invalid("file can't be opened");
+  }
+  if (cacheCapacity == 0 || cacheCapacity >= NoSlot)
+  {
+    throw invalid("invalid cache capacity");
+  }
+  TiledMapHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(TiledMapHeader)))
+  {
+    throw invalid("file is too short");
+  }
+  if (header.magic != TiledMapMagic)
+  {
+    throw invalid("not a tiled map");
+  }
+  if (header.version != Version || header.tileSize != TileSize)
+  {
+    std::ostringstream reason;
+    reason << "version " << header.version << " with tile size " << header.tileSize << " is not supported, expected "
+           << Version << " with tile size " << TileSize;
+    throw invalid(reason.str());
+  }
+
+  width = header.width;
+  height = header.height;
+  tilesPerRow = count_tiles(width);
+  numberOfVertices = static_cast<size_t>(header.numberOfVertices);
+  const size_t numberOfTiles = tilesPerRow * count_tiles(height);
+  const auto expectedSize =
+      sizeof(TiledMapHeader) + numberOfTiles * TileBytes + (numberOfTiles + 1) * sizeof(uint32_t);
+  if (std::filesystem::file_size(filename) != expectedSize)
+  {
+    throw invalid("file size does not match the map size");
+  }
+
+  // The first vertices of the tiles follow the tiles
+  tileFirstVertices.resize(numberOfTiles + 1);
+  file.seekg(static_cast<std::streamoff>(sizeof(TiledMapHeader) + numberOfTiles * TileBytes));
+  file.read(reinterpret_cast<char*>(tileFirstVertices.data()),
+            static_cast<std::streamsize>(tileFirstVertices.size() * sizeof(uint32_t)));
+  if (!file || tileFirstVertices.front() != 0 || tileFirstVertices.back() != numberOfVertices
+      || !std::is_sorted(tileFirstVertices.begin(), tileFirstVertices.end()))
+  {
+    throw invalid("invalid tile index");
+  }
+
+  // Tiles are streamed through once, so that a corrupted file is rejected instead of numbering vertices out of range
+  std::vector<Word> words(TileSize);
+  file.seekg(static_cast<std::streamoff>(sizeof(TiledMapHeader)));
+  for (size_t tile = 0; tile < numberOfTiles; ++tile)
+  {
+    if (!file.read(reinterpret_cast<char*>(words.data()), TileBytes))
+    {
+      throw invalid("file can't be read");
+    }
+    const size_t rows = std::min<size_t>(TileSize, height - (tile / tilesPerRow) * TileSize);
+    const size_t columns = std::min<size_t>(TileSize, width - (tile % tilesPerRow) * TileSize);
+    const Word columnsMask = columns == TileSize ? ~Word(0) : (Word(1) << columns) - 1;
+    uint32_t numberOfPassableCells = 0;
+    for (size_t row = 0; row < TileSize; ++row)
+    {
+      if (words[row] & ~(row < rows ? columnsMask : Word(0)))
+      {
+        throw invalid("tile has passable cells outside the map");
+      }
+      numberOfPassableCells += static_cast<uint32_t>(std::popcount(words[row]));
+    }
+    if (tileFirstVertices[tile + 1] - tileFirstVertices[tile] != numberOfPassableCells)
+    {
+      throw invalid("invalid tile index");
+    }
+  }
+
+  slotWords.resize(cacheCapacity * TileSize);
+  slotRowRanks.resize(cacheCapacity * (TileSize + 1));
+  slotTiles.resize(cacheCapacity);
+  previousSlots.resize(cacheCapacity);
+  nextSlots.resize(cacheCapacity);
+  tileSlots.assign(numberOfTiles, NoSlot);
+}
+
+void TiledGridGraph::write(const std::string& mapFilename, const std::string& filename)
+{
+  MapReader reader(mapFilename);
+  const unsigned width = reader.getWidth();
+  const unsigned height = reader.getHeight();
+  const size_t tilesPerRow = count_tiles(width);
+
+  const std::string temporaryFilename = temporary_filename(filename);
+  auto failed = [&filename, &temporaryFilename]()
+  {
+    std::error_code error;
+    std::filesystem::remove(temporaryFilename, error);
+    std::ostringstream message;
+    message << "Failed to write tiled map '" << filename << "' from " << std::filesystem::current_path();
+    return std::runtime_error(message.str());
+  };
+  try
+  {
+    std::ofstream file(temporaryFilename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      throw failed();
+    }
+
+    TiledMapHeader header{TiledMapMagic, Version, TileSize, width, height, 0};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(TiledMapHeader));
+
+    // One band of tiles, `TileSize` map rows high, is converted at a time
+    std::vector<Word> band(tilesPerRow * TileSize);
+    std::vector<uint32_t> tileFirstVertices{0};
+    for (unsigned bandRow = 0; bandRow < height; bandRow += TileSize)
+    {
+      std::fill(band.begin(), band.end(), Word(0));
+      for (unsigned row = bandRow; row < std::min(height, bandRow + TileSize); ++row)
+      {
+        const std::string_view line = reader.readRow();
+        for (unsigned column = 0; column < width; ++column)
+        {
+          if (isVertexPassable(line[column]))
+          {
+            band[(column / TileSize) * TileSize + row - bandRow] |= Word(1) << (column % TileSize);
+          }
+        }
+      }
+      for (size_t tile = 0; tile < tilesPerRow; ++tile)
+      {
+        uint32_t numberOfPassableCells = 0;
+        for (size_t index = 0; index < TileSize; ++index)
+        {
+          numberOfPassableCells += static_cast<uint32_t>(std::popcount(band[tile * TileSize + index]));
+        }
+        tileFirstVertices.push_back(tileFirstVertices.back() + numberOfPassableCells);
+      }
+      file.write(reinterpret_cast<const char*>(band.data()), static_cast<std::streamsize>(band.size() * sizeof(Word)));
+    }
+    file.write(
+        reinterpret_cast<const char*>(tileFirstVertices.data()),
+        static_cast<std::streamsize>(tileFirstVertices.size() * sizeof(uint32_t)));
+
+    header.numberOfVertices = tileFirstVertices.back();
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(TiledMapHeader));
+    file.close();
+    if (!file)
+    {
+      throw failed();
+    }
+  } catch (const std::invalid_argument&)
+  {
+    // A malformed row of the map leaves no half-written file behind either
+    std::error_code error;
+    std::filesystem::remove(temporaryFilename, error);
+    throw;
+  }
+  std::error_code error;
+  std::filesystem::rename(temporaryFilename, filename, error);
+  if (error)
+  {
+    throw failed();
+  }
+}
+
+unsigned TiledGridGraph::getWidth() const
+{
+  return width;
+}
+
+unsigned TiledGridGraph::getHeight() const
+{
+  return height;
+}
+
+size_t TiledGridGraph::getNumberOfVertices() const
+{
+  return numberOfVertices;
+}
+
+size_t TiledGridGraph::getNumberOfTiles() const
+{
+  return tileSlots.size();
+}
+
+size_t TiledGridGraph::getCacheCapacity() const
+{
+  return cacheCapacity;
+}
+
+TiledGridGraph::CacheStatistics TiledGridGraph::getCacheStatistics() const
+{
+  return statistics;
+}
+
+void TiledGridGraph::resetCacheStatistics()
+{
+  statistics = {0, 0};
+}
+
+uint32_t TiledGridGraph::getSlot(size_t tile) const
+{
+  uint32_t slot = tileSlots[tile];
+  if (slot != NoSlot)
+  {
+    ++statistics.hits;
+    moveToFront(slot);
+    return slot;
+  }
+
+  ++statistics.misses;
+  if (usedSlots < cacheCapacity)
+  {
+    slot = usedSlots++;
+    previousSlots[slot] = NoSlot;
+    nextSlots[slot] = mostRecentlyUsedSlot;
+    if (mostRecentlyUsedSlot != NoSlot) previousSlots[mostRecentlyUsedSlot] = slot;
+    mostRecentlyUsedSlot = slot;
+    if (leastRecentlyUsedSlot == NoSlot) leastRecentlyUsedSlot = slot;
+  }
+  else
+  {
+    slot = leastRecentlyUsedSlot;
+    tileSlots[slotTiles[slot]] = NoSlot;
+    moveToFront(slot);
+  }
+  tileSlots[tile] = slot;
+  slotTiles[slot] = static_cast<uint32_t>(tile);
+
+  Word* words = slotWords.data() + size_t(slot) * TileSize;
+  file.seekg(static_cast<std::streamoff>(sizeof(TiledMapHeader) + tile * TileBytes));
+  if (!file.read(reinterpret_cast<char*>(words), TileBytes))
+  {
+    tileSlots[tile] = NoSlot;
+    std::ostringstream message;
+    message << "Failed to read tile " << tile << " of tiled map '" << filename << "'";
+    throw std::runtime_error(message.str());
+  }
+  uint16_t* rowRanks = slotRowRanks.data() + size_t(slot) * (TileSize + 1);
+  rowRanks[0] = 0;
+  for (size_t row = 0; row < TileSize; ++row)
+  {
+    rowRanks[row + 1] = static_cast<uint16_t>(rowRanks[row] + std::popcount(words[row]));
+  }
+  return slot;
+}
+
+void TiledGridGraph::moveToFront(uint32_t slot) const
+{
+  if (slot == mostRecentlyUsedSlot) return;
+  // Unlink, then insert in front of the most recently used slot
+  nextSlots[previousSlots[slot]] = nextSlots[slot];
+  if (nextSlots[slot] != NoSlot)
+  {
+    previousSlots[nextSlots[slot]] = previousSlots[slot];
+  }
+  else
+  {
+    leastRecentlyUsedSlot = previousSlots[slot];
+  }
+  previousSlots[slot] = NoSlot;
+  nextSlots[slot] = mostRecentlyUsedSlot;
+  previousSlots[mostRecentlyUsedSlot] = slot;
+  mostRecentlyUsedSlot = slot;
+}
+
+size_t TiledGridGraph::getTile(size_t row, size_t column) const
+{
+  return (row / TileSize) * tilesPerRow + column / TileSize;
+}
+
+bool TiledGridGraph::isPassable(size_t row, size_t column) const
+{
+  const uint32_t slot = getSlot(getTile(row, column));
+  return (slotWords[size_t(slot) * TileSize + row % TileSize] >> (column % TileSize)) & 1u;
+}
+
+Vertex TiledGridGraph::getVertex(size_t row, size_t column) const
+{
+  const size_t tile = getTile(row, column);
+  const uint32_t slot = getSlot(tile);
+  const Word word = slotWords[size_t(slot) * TileSize + row % TileSize];
+  const Word precedingCellsMask = (Word(1) << (column % TileSize)) - 1;
+  return tileFirstVertices[tile] + slotRowRanks[size_t(slot) * (TileSize + 1) + row % TileSize]
+      + static_cast<uint32_t>(std::popcount(word & precedingCellsMask));
+}
+
+std::optional<unsigned> TiledGridGraph::convertMapPositionToVertexIndex(size_t row, size_t column) const
+{
+  if (row >= height || column >= width || !isPassable(row, column))
+  {
+    return std::nullopt;
+  }
+  return static_cast<unsigned>(getVertex(row, column));
+}
+
+std::pair<size_t, size_t> TiledGridGraph::convertVertexIndexToMapPosition(Vertex vertex) const
+{
+  // Last tile starting at or before the vertex, skipping the empty tiles starting at the same vertex
+  const auto tileIterator = std::upper_bound(tileFirstVertices.begin(), tileFirstVertices.end(), vertex) - 1;
+  const auto tile = static_cast<size_t>(tileIterator - tileFirstVertices.begin());
+  const uint32_t slot = getSlot(tile);
+  const uint16_t* rowRanks = slotRowRanks.data() + size_t(slot) * (TileSize + 1);
+  const auto localVertex = static_cast<uint16_t>(vertex - *tileIterator);
+  const auto localRow =
+      static_cast<size_t>(std::upper_bound(rowRanks, rowRanks + TileSize + 1, localVertex) - rowRanks - 1);
+
+  // Select the bit of the vertex among the passable cells of its row
+  Word word = slotWords[size_t(slot) * TileSize + localRow];
+  for (uint16_t skipped = rowRanks[localRow]; skipped < localVertex; ++skipped)
+  {
+    word &= word - 1;
+  }
+  const auto localColumn = static_cast<size_t>(std::countr_zero(word));
+  return std::make_pair((tile / tilesPerRow) * TileSize + localRow, (tile % tilesPerRow) * TileSize + localColumn);
+}
+
+Point2D TiledGridGraph::getPosition(Vertex vertex) const
+{
+  const auto [row, column] = convertVertexIndexToMapPosition(vertex);
+  return {float(row), float(column)};
+}
+
+size_t num_vertices(const TiledGridGraph& graph)
+{
+  return graph.getNumberOfVertices();
+}
+
+Point2D vertex_position(const TiledGridGraph& graph, Vertex vertex)
+{
+  return graph.getPosition(vertex);
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geometry.h"
+#include "graph.h"
+
+/// @brief Implicit 4-connected grid graph like `GridGraph`, but paged in from disk: the map is split into square
+/// tiles of `TileSize x TileSize` cells, and only the tiles in a fixed-capacity LRU cache are kept in memory.
+///
+/// Apart from the cache, only the first vertex and the cache slot of every tile stay in memory (8 bytes per tile), so
+/// maps far larger than the memory can be searched. Vertices are numbered tile by tile (tiles in row-major order,
+/// passable cells of a tile in row-major order), so indices differ from `MapGraphLoader` and `GridGraph`; convert them
+/// through map positions.
+///
+/// The cache is mutated by every lookup, also through const methods, so a graph must not be searched from several
+/// threads at once.
+class TiledGridGraph
+{
+ public:
+  typedef uint64_t Word;
+  /// One word per tile row.
+  static constexpr unsigned TileSize = 64;
+  static constexpr uint32_t Version = 1;
+  static constexpr Distance EdgeWeight = 1.0f;
+
+  struct CacheStatistics {
+    uint64_t hits;
+    uint64_t misses;
+  };
+
+  /// @param cacheCapacity Number of tiles kept in memory, at least 1.
+  /// @throws std::runtime_error if the file can't be opened, isn't a tiled map of this `Version`, is truncated or its
+  /// tile index doesn't match its tiles. The tiles are read once to validate the index.
+  TiledGridGraph(const std::string& filename, size_t cacheCapacity);
+
+  TiledGridGraph(const TiledGridGraph&) = delete;
+  TiledGridGraph& operator=(const TiledGridGraph&) = delete;
+
+  /// @brief Converts a `.map` file into a tiled map, reading one band of `TileSize` rows at a time. The map is written
+  /// under a `temporary_filename` and renamed to `filename` only once complete.
+  /// @throws std::runtime_error if the tiled map can't be written, std::invalid_argument if the `.map` file is invalid.
+  static void write(const std::string& mapFilename, const std::string& filename);
+
+  unsigned getWidth() const;
+  unsigned getHeight() const;
+  size_t getNumberOfVertices() const;
+  size_t getNumberOfTiles() const;
+  size_t getCacheCapacity() const;
+  CacheStatistics getCacheStatistics() const;
+  void resetCacheStatistics();
+
+  bool isPassable(size_t row, size_t column) const;
+  std::optional<unsigned> convertMapPositionToVertexIndex(size_t row, size_t column) const;
+  std::pair<size_t, size_t> convertVertexIndexToMapPosition(Vertex vertex) const;
+  Point2D getPosition(Vertex vertex) const;
+
+  template <typename Visitor>
+  void forEachOutEdge(Vertex vertex, Visitor&& visitor) const
+  {
+    const auto [row, column] = convertVertexIndexToMapPosition(vertex);
+    // Same neighbor order as `GridGraph` (left, top, right, bottom)
+    if (column > 0 && isPassable(row, column - 1))
+    {
+      visitor(getVertex(row, column - 1), EdgeWeight);
+    }
+    if (row > 0 && isPassable(row - 1, column))
+    {
+      visitor(getVertex(row - 1, column), EdgeWeight);
+    }
+    if (column + 1 < width && isPassable(row, column + 1))
+    {
+      visitor(getVertex(row, column + 1), EdgeWeight);
+    }
+    if (row + 1 < height && isPassable(row + 1, column))
+    {
+      visitor(getVertex(row + 1, column), EdgeWeight);
+    }
+  }
+
+ private:
+  static constexpr uint32_t NoSlot = UINT32_MAX;
+
+  /// @brief Cache slot holding the tile, reading the tile into the least recently used slot on a miss.
+  uint32_t getSlot(size_t tile) const;
+  void moveToFront(uint32_t slot) const;
+  size_t getTile(size_t row, size_t column) const;
+  /// @brief Vertex of a passable cell.
+  Vertex getVertex(size_t row, size_t column) const;
+
+  std::string filename;
+  unsigned width;
+  unsigned height;
+  size_t tilesPerRow;
+  size_t numberOfVertices;
+  /// @brief First vertex of every tile, followed by the number of vertices.
+  std::vector<uint32_t> tileFirstVertices;
+
+  mutable std::ifstream file;
+  size_t cacheCapacity;
+  /// @brief `TileSize` words of every slot, and `TileSize + 1` row ranks (passable cells of the tile preceding each
+  /// row) of every slot.
+  mutable std::vector<Word> slotWords;
+  mutable std::vector<uint16_t> slotRowRanks;
+  mutable std::vector<uint32_t> slotTiles;
+  /// @brief Doubly linked list of the used slots, most recently used first.
+  mutable std::vector<uint32_t> previousSlots;
+  mutable std::vector<uint32_t> nextSlots;
+  mutable uint32_t mostRecentlyUsedSlot;
+  mutable uint32_t leastRecentlyUsedSlot;
+  mutable uint32_t usedSlots;
+  mutable std::vector<uint32_t> tileSlots;
+  mutable CacheStatistics statistics;
+};
+
+size_t num_vertices(const TiledGridGraph& graph);
+Point2D vertex_position(const TiledGridGraph& graph, Vertex vertex);
+
+template <typename Visitor>
+void for_each_out_edge(const TiledGridGraph& graph, Vertex vertex, Visitor&& visitor)
+{
+  graph.forEachOutEdge(vertex, std::forward<Visitor>(visitor));
+}
@@ -0,0 +1,143 @@
+#include "tiled-grid-graph.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include "grid-graph.h"
+#include "path-finding.h"
+#include "test-data.h"
+
+namespace
+{
+std::string getTiledMapFilename(const std::string& name)
+{
+  const auto filename = std::filesystem::temp_directory_path() / ("path-finding-" + name + ".tiles");
+  TiledGridGraph::write(getMapFilename(name), filename.string());
+  return filename.string();
+}
+
+std::vector<std::pair<size_t, size_t>> getNeighborCells(const GridGraph& graph, size_t row, size_t column)
+{
+  std::vector<std::pair<size_t, size_t>> cells;
+  for_each_out_edge(
+      graph,
+      *graph.convertMapPositionToVertexIndex(row, column),
+      [&](Vertex target, Distance) { cells.push_back(graph.convertVertexIndexToMapPosition(target)); });
+  return cells;
+}
+
+std::vector<std::pair<size_t, size_t>> getNeighborCells(const TiledGridGraph& graph, size_t row, size_t column)
+{
+  std::vector<std::pair<size_t, size_t>> cells;
+  for_each_out_edge(
+      graph,
+      *graph.convertMapPositionToVertexIndex(row, column),
+      [&](Vertex target, Distance) { cells.push_back(graph.convertVertexIndexToMapPosition(target)); });
+  return cells;
+}
+}  // namespace
+
+TEST(TiledGridGraph, has_the_cells_and_edges_of_the_grid_graph)
+{
+  // 340 x 164 cells span partial tiles at the right and bottom border
+  const std::string name = "warehouse-20-40-10-2-2";
+  GridGraphLoader loader(getMapFilename(name));
+  const GridGraph& gridGraph = loader.getGraph();
+  const TiledGridGraph graph(getTiledMapFilename(name), 4);
+
+  ASSERT_EQ(graph.getWidth(), gridGraph.getWidth());
+  ASSERT_EQ(graph.getHeight(), gridGraph.getHeight());
+  ASSERT_EQ(graph.getNumberOfVertices(), gridGraph.getNumberOfVertices());
+  EXPECT_EQ(graph.getNumberOfTiles(), 6u * 3u);
+  for (size_t row = 0; row < graph.getHeight(); ++row)
+  {
+    for (size_t column = 0; column < graph.getWidth(); ++column)
+    {
+      ASSERT_EQ(graph.isPassable(row, column), gridGraph.isPassable(row, column)) << row << ", " << column;
+      if (!graph.isPassable(row, column)) continue;
+      const Vertex vertex = *graph.convertMapPositionToVertexIndex(row, column);
+      EXPECT_EQ(graph.convertVertexIndexToMapPosition(vertex), std::make_pair(row, column));
+      EXPECT_EQ(getNeighborCells(graph, row, column), getNeighborCells(gridGraph, row, column));
+    }
+  }
+}
+
+TEST(TiledGridGraph, a_star_finds_paths_as_long_as_on_grid_graph)
+{
+  const std::string name = "maze-128-128-2";
+  GridGraphLoader loader(getMapFilename(name));
+  const GridGraph& gridGraph = loader.getGraph();
+  TiledGridGraph graph(getTiledMapFilename(name), 2);
+
+  const Vertex gridStart = 0;
+  const auto gridTarget = static_cast<Vertex>(gridGraph.getNumberOfVertices() - 1);
+  const auto [startRow, startColumn] = gridGraph.convertVertexIndexToMapPosition(gridStart);
+  const auto [targetRow, targetColumn] = gridGraph.convertVertexIndexToMapPosition(gridTarget);
+  const Vertex start = *graph.convertMapPositionToVertexIndex(startRow, startColumn);
+  const Vertex target = *graph.convertMapPositionToVertexIndex(targetRow, targetColumn);
+  graph.resetCacheStatistics();
+
+  const Path path = a_star_shortest_path(graph, start, target);
+  EXPECT_EQ(path.size(), a_star_shortest_path(gridGraph, gridStart, gridTarget).size());
+  EXPECT_EQ(path.front(), start);
+  EXPECT_EQ(path.back(), target);
+  // 2 x 2 tiles, of which only 2 fit into the cache
+  const auto statistics = graph.getCacheStatistics();
+  EXPECT_GT(statistics.hits, 0u);
+  EXPECT_GT(statistics.misses, 2u);
+  EXPECT_EQ(dijkstra_shortest_path(graph, start, target).size(), path.size());
+}
+
+TEST(TiledGridGraph, evicts_least_recently_used_tile)
+{
+  TiledGridGraph graph(getTiledMapFilename("warehouse-20-40-10-2-2"), 2);
+  graph.isPassable(0, 0);
+  graph.isPassable(0, 64);
+  graph.isPassable(0, 1);  // Tile 0 becomes the most recently used
+  graph.isPassable(0, 128);  // Evicts tile 1
+  graph.isPassable(1, 0);
+  EXPECT_EQ(graph.getCacheStatistics().hits, 2u);
+  EXPECT_EQ(graph.getCacheStatistics().misses, 3u);
+  graph.isPassable(1, 64);
+  EXPECT_EQ(graph.getCacheStatistics().misses, 4u);
+
+  graph.resetCacheStatistics();
+  EXPECT_EQ(graph.getCacheStatistics().hits, 0u);
+  EXPECT_EQ(graph.getCacheStatistics().misses, 0u);
+}
+
+TEST(TiledGridGraph, throws_exception_on_invalid_file)
+{
+  const std::string filename = getTiledMapFilename("maze-32-32-2");
+  EXPECT_THROW(TiledGridGraph(filename, 0), std::runtime_error);
+  EXPECT_THROW(TiledGridGraph("does-not-exist.tiles", 1), std::runtime_error);
+  std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 4);
+  EXPECT_THROW(TiledGridGraph(filename, 1), std::runtime_error);
+}
+
+TEST(TiledGridGraph, throws_exception_on_invalid_tile_index)
+{
+  auto corrupt = [](const std::string& name, std::streamoff offsetFromEnd, auto change)
+  {
+    const std::string filename = getTiledMapFilename(name);
+    EXPECT_NO_THROW(TiledGridGraph(filename, 1));
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    auto value = decltype(change(0))(0);
+    file.seekg(-offsetFromEnd, std::ios::end);
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    value = change(value);
+    file.seekp(-offsetFromEnd, std::ios::end);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    file.close();
+    EXPECT_THROW(TiledGridGraph(filename, 1), std::runtime_error);
+  };
+  // 6 x 3 tiles, the second of 19 tile first vertices is past the last one
+  corrupt("warehouse-20-40-10-2-2", 18 * 4, [](uint32_t) { return uint32_t(1) << 30; });
+  // A single tile whose first row word is followed by 63 words and the 2 tile first vertices
+  const std::streamoff firstRow = TiledGridGraph::TileSize * sizeof(TiledGridGraph::Word) + 2 * 4;
+  corrupt("maze-32-32-2", firstRow, [](TiledGridGraph::Word word) { return word ^ TiledGridGraph::Word(1); });
+  corrupt("maze-32-32-2", firstRow, [](TiledGridGraph::Word word) { return word | TiledGridGraph::Word(1) << 40; });
+}
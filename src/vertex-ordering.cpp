@@ -0,0 +1,132 @@
+#include "vertex-ordering.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace
+{
+uint64_t spread_bits(uint32_t value)
+{
+  uint64_t bits = value;
+  bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFull;
+  bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFull;
+  bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+  bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+  bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+  return bits;
+}
+}  // namespace
+
+uint64_t morton_index(uint32_t row, uint32_t column)
+{
+  return (spread_bits(row) << 1) | spread_bits(column);
+}
+
+uint64_t hilbert_index(unsigned order, uint32_t row, uint32_t column)
+{
+  uint64_t x = column;
+  uint64_t y = row;
+  uint64_t index = 0;
+  for (uint64_t side = (uint64_t(1) << order) / 2; side > 0; side /= 2)
+  {
+    const uint64_t rx = (x & side) > 0 ? 1 : 0;
+    const uint64_t ry = (y & side) > 0 ? 1 : 0;
+    index += side * side * ((3 * rx) ^ ry);
+    // Rotate the quadrant, so that the curve inside it starts and ends next to its neighboring quadrants
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = side - 1 - (x & (side - 1));
+        y = side - 1 - (y & (side - 1));
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+namespace
+{
+std::vector<size_t> breadth_first_order(
+    const std::vector<std::pair<size_t, size_t>>& cells, unsigned width, unsigned height)
+{
+  const size_t unknown = std::numeric_limits<size_t>::max();
+  std::vector<size_t> cellToIndex(size_t(width) * height, unknown);
+  for (size_t index = 0; index < cells.size(); ++index)
+  {
+    cellToIndex[cells[index].first * width + cells[index].second] = index;
+  }
+
+  std::vector<size_t> order;
+  order.reserve(cells.size());
+  std::vector<bool> visited(cells.size(), false);
+  std::queue<size_t> queue;
+  auto visit = [&](size_t row, size_t column)
+  {
+    const size_t index = cellToIndex[row * width + column];
+    if (index != unknown && !visited[index])
+    {
+      visited[index] = true;
+      queue.push(index);
+    }
+  };
+  // Every connected component is numbered breadth-first from its first cell in row-major order
+  for (size_t root = 0; root < cells.size(); ++root)
+  {
+    visit(cells[root].first, cells[root].second);
+    while (!queue.empty())
+    {
+      const size_t index = queue.front();
+      queue.pop();
+      order.push_back(index);
+      const auto [row, column] = cells[index];
+      if (column > 0) visit(row, column - 1);
+      if (row > 0) visit(row - 1, column);
+      if (column + 1 < width) visit(row, column + 1);
+      if (row + 1 < height) visit(row + 1, column);
+    }
+  }
+  return order;
+}
+}  // namespace
+
+std::vector<size_t> vertex_order(
+    const std::vector<std::pair<size_t, size_t>>& cells, unsigned width, unsigned height, VertexOrdering ordering)
+{
+  if (ordering == VertexOrdering::BreadthFirst)
+  {
+    return breadth_first_order(cells, width, height);
+  }
+
+  std::vector<uint64_t> keys(cells.size());
+  unsigned hilbertOrder = 0;
+  while ((uint64_t(1) << hilbertOrder) < std::max(width, height))
+  {
+    ++hilbertOrder;
+  }
+  for (size_t index = 0; index < cells.size(); ++index)
+  {
+    const auto row = static_cast<uint32_t>(cells[index].first);
+    const auto column = static_cast<uint32_t>(cells[index].second);
+    switch (ordering)
+    {
+      case VertexOrdering::Morton:
+        keys[index] = morton_index(row, column);
+        break;
+      case VertexOrdering::Hilbert:
+        keys[index] = hilbert_index(hilbertOrder, row, column);
+        break;
+      default:
+        keys[index] = index;
+        break;
+    }
+  }
+
+  std::vector<size_t> order(cells.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&keys](size_t left, size_t right) { return keys[left] < keys[right]; });
+  return order;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// @brief How `MapGraphLoader` numbers the passable cells of a map.
+///
+/// With `RowMajor`, vertical neighbors are about a full row apart in every per-vertex array (distances, predecessors,
+/// vertex locks). The other orderings keep cells that are close on the map close in memory.
+enum class VertexOrdering
+{
+  RowMajor,
+  Morton,
+  Hilbert,
+  BreadthFirst
+};
+
+/// @brief Z-order curve index: bits of `row` and `column` interleaved.
+uint64_t morton_index(uint32_t row, uint32_t column);
+
+/// @brief Index of the cell along the Hilbert curve filling a `2^order x 2^order` square. Consecutive indices are
+/// always 4-neighbors.
+uint64_t hilbert_index(unsigned order, uint32_t row, uint32_t column);
+
+/// @brief Returns the permutation `order`, such that `order[newVertex]` is the position in `cells` of the cell that
+/// becomes vertex `newVertex` under the given ordering.
+/// @param cells Passable (row, column) cells in row-major order, as `MapGraphLoader` first numbers them.
+std::vector<size_t> vertex_order(
+    const std::vector<std::pair<size_t, size_t>>& cells, unsigned width, unsigned height, VertexOrdering ordering);
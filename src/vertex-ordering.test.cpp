@@ -0,0 +1,78 @@
+#include "vertex-ordering.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+TEST(morton_index, interleaves_row_and_column_bits)
+{
+  EXPECT_EQ(morton_index(0, 0), 0u);
+  EXPECT_EQ(morton_index(0, 1), 1u);
+  EXPECT_EQ(morton_index(1, 0), 2u);
+  EXPECT_EQ(morton_index(1, 1), 3u);
+  EXPECT_EQ(morton_index(0, 2), 4u);
+  EXPECT_EQ(morton_index(3, 5), 0b011011u);
+}
+
+TEST(hilbert_index, visits_every_cell_once_moving_to_a_neighbor_each_step)
+{
+  const unsigned order = 4;
+  const uint32_t side = 1u << order;
+  std::vector<std::pair<int, int>> cells(size_t(side) * side, {-1, -1});
+  for (uint32_t row = 0; row < side; ++row)
+  {
+    for (uint32_t column = 0; column < side; ++column)
+    {
+      const uint64_t index = hilbert_index(order, row, column);
+      ASSERT_LT(index, cells.size());
+      EXPECT_EQ(cells[index], std::make_pair(-1, -1)) << "index " << index << " assigned twice";
+      cells[index] = {int(row), int(column)};
+    }
+  }
+  for (size_t index = 1; index < cells.size(); ++index)
+  {
+    const int distance =
+        std::abs(cells[index].first - cells[index - 1].first) + std::abs(cells[index].second - cells[index - 1].second);
+    EXPECT_EQ(distance, 1) << "between indices " << index - 1 << " and " << index;
+  }
+}
+
+TEST(vertex_order, returns_permutation_of_cells)
+{
+  // Two separate components: a 3x3 block and a single cell
+  std::vector<std::pair<size_t, size_t>> cells;
+  for (size_t row = 0; row < 3; ++row)
+  {
+    for (size_t column = 0; column < 3; ++column)
+    {
+      cells.emplace_back(row, column);
+    }
+    if (row == 1) cells.emplace_back(row, 5);
+  }
+
+  for (auto ordering :
+       {VertexOrdering::RowMajor, VertexOrdering::Morton, VertexOrdering::Hilbert, VertexOrdering::BreadthFirst})
+  {
+    std::vector<size_t> order = vertex_order(cells, 6, 3, ordering);
+    std::sort(order.begin(), order.end());
+    std::vector<size_t> expected(cells.size());
+    for (size_t index = 0; index < expected.size(); ++index)
+    {
+      expected[index] = index;
+    }
+    EXPECT_EQ(order, expected);
+  }
+
+  // Breadth-first from (0, 0): (0, 0); (0, 1), (1, 0); (0, 2), (1, 1), (2, 0); (1, 2), (2, 1); (2, 2); then (1, 5)
+  const std::vector<size_t> order = vertex_order(cells, 6, 3, VertexOrdering::BreadthFirst);
+  std::vector<std::pair<size_t, size_t>> orderedCells;
+  for (size_t index : order)
+  {
+    orderedCells.push_back(cells[index]);
+  }
+  EXPECT_EQ(
+      orderedCells,
+      (std::vector<std::pair<size_t, size_t>>{
+          {0, 0}, {0, 1}, {1, 0}, {0, 2}, {1, 1}, {2, 0}, {1, 2}, {2, 1}, {2, 2}, {1, 5}}));
+}